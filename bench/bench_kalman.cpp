@@ -0,0 +1,94 @@
+// 卡尔曼滤波单次更新耗时对比：旧版动态矩阵实现 vs 定长模板实现
+#include "camera/KalmanFilter1D.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+static std::atomic<size_t> g_allocations{0};
+
+// Eigen 动态矩阵直接走 malloc，因此在 malloc 层计数（glibc）
+extern "C" void* __libc_malloc(std::size_t size);
+extern "C" void* malloc(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+namespace {
+
+// 旧版实现（MatrixXf/VectorXf），仅用于对比
+class LegacyKalmanFilter1D {
+public:
+    LegacyKalmanFilter1D(float initial_x, const ConfigManager::Params::KalmanParams& params) {
+        F_ = Eigen::MatrixXf::Identity(1, 1);
+        H_ = Eigen::MatrixXf::Identity(1, 1);
+        P_ = Eigen::MatrixXf::Identity(1, 1) * params.variance_position;
+        Q_ = Eigen::MatrixXf::Identity(1, 1) * params.process_noise;
+        R_ = Eigen::MatrixXf::Identity(1, 1) * params.variance_measurement;
+        x_ = Eigen::VectorXf(1);
+        x_ << initial_x;
+    }
+
+    float filterMeasurement(float measurement) {
+        x_ = F_ * x_;
+        P_ = F_ * P_ * F_.transpose() + Q_;
+        Eigen::VectorXf z(1);
+        z << measurement;
+        Eigen::MatrixXf K = P_ * H_.transpose() * (H_ * P_ * H_.transpose() + R_).inverse();
+        x_ += K * (z - H_ * x_);
+        P_ = (Eigen::MatrixXf::Identity(1, 1) - K * H_) * P_;
+        return x_(0);
+    }
+
+private:
+    Eigen::MatrixXf F_, H_, P_, Q_, R_;
+    Eigen::VectorXf x_;
+};
+
+template <typename Fn>
+void Run(const char* name, size_t iterations, Fn&& step) {
+    volatile float sink = 0.0f;
+    const size_t alloc_before = g_allocations.load();
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        sink = sink + step(static_cast<float>(i % 97) * 0.01f);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const size_t allocs = g_allocations.load() - alloc_before;
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("%-24s %8.2f ns/update  %6.2f allocs/update\n",
+                name, ns / iterations, static_cast<double>(allocs) / iterations);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5000000;
+    const ConfigManager::Params::KalmanParams params{0.05f, 0.5f, 0.01f};
+
+    LegacyKalmanFilter1D legacy(0.5f, params);
+    Run("legacy MatrixXf 1x1", iterations,
+        [&](float z) { return legacy.filterMeasurement(z); });
+
+    KalmanFilter1D scalar(0.5f, params);
+    Run("KalmanFilter<1,1>", iterations,
+        [&](float z) { return scalar.filterMeasurement(z); });
+
+    // 常速度模型，验证一般定长路径同样无分配
+    using CV = KalmanFilter<2, 1>;
+    CV::StateMatrix F;
+    F << 1.0f, 1.0f / 30.0f,
+         0.0f, 1.0f;
+    CV::ObservationMatrix H;
+    H << 1.0f, 0.0f;
+    CV cv(CV::State::Zero(), F, H,
+          CV::StateMatrix::Identity() * 10.0f,
+          CV::StateMatrix::Identity() * 0.01f,
+          CV::MeasurementMatrix::Constant(40.0f));
+    Run("KalmanFilter<2,1>", iterations, [&](float z) {
+        cv.predict();
+        cv.update(CV::Measurement::Constant(z));
+        return cv.state()(0);
+    });
+    return 0;
+}
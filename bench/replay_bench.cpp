@@ -0,0 +1,90 @@
+// 回放基准：逐帧调用 predict + transfer，统计吞吐、延迟分位数与每帧分配次数
+//   replay_bench <camera_config.json> [trace.(bin|jsonl)|-] [repeat] [stages]
+// 第四个参数为 stages 时打开分阶段计时，结束后输出各阶段耗时与计数器。
+// 不给 trace 时使用固定种子的合成序列，任意 Linux 机器上结果可比。
+#include "AllocCounter.hpp"
+#include "camera/CameramanModel.hpp"
+#include "camera/DetectionTrace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+double Percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0.0;
+    const size_t idx = std::min(sorted.size() - 1,
+                                static_cast<size_t>(q * (sorted.size() - 1) + 0.5));
+    return sorted[idx];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <camera_config.json> [trace] [repeat]\n";
+        return 1;
+    }
+    try {
+        ConfigManager::Initialize(argv[1]);
+        const DetectionTrace trace = argc > 2 && std::string(argv[2]) != "-"
+            ? DetectionTrace::Load(argv[2])
+            : GenerateSyntheticTrace(SyntheticTraceOptions{});
+        const size_t repeat = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 5;
+        if (trace.size() < 2) throw std::runtime_error("Trace needs at least 2 frames");
+        const bool stages = argc > 4 && std::string(argv[4]) == "stages";
+        Instrumentation::SetTimingEnabled(stages);
+
+        std::vector<double> latencies_ns;
+        latencies_ns.reserve(trace.size() * repeat);
+        size_t allocations = 0;
+        double checksum = 0.0;
+
+        const auto wall_start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < repeat; ++r) {
+            CameramanModel model(ConfigManager::Default().Snapshot()->court_points);
+            // 首帧初始化历史窗口，不计入统计
+            model.predict(trace.framePlayers(0), trace.frameBalls(0));
+
+            ScopedAllocCount counter;
+            for (size_t i = 1; i < trace.size(); ++i) {
+                const auto t0 = std::chrono::steady_clock::now();
+                const float target = model.predict(trace.framePlayers(i), trace.frameBalls(i));
+                const auto [y, fov] = model.transfer(target);
+                const auto t1 = std::chrono::steady_clock::now();
+                latencies_ns.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+                checksum += target + y + fov;
+            }
+            allocations += counter.count();
+        }
+        const double wall_s = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - wall_start).count();
+
+        const size_t frames = latencies_ns.size();
+        std::sort(latencies_ns.begin(), latencies_ns.end());
+        double total_ns = 0.0;
+        for (double ns : latencies_ns) total_ns += ns;
+
+        std::printf("frames         : %zu (%zu x %zu)\n", frames, repeat, trace.size() - 1);
+        std::printf("throughput     : %.0f frames/s (frame path only), %.0f frames/s (wall)\n",
+                    frames / (total_ns * 1e-9), frames / wall_s);
+        std::printf("latency mean   : %.1f ns\n", total_ns / frames);
+        std::printf("latency p50    : %.1f ns\n", Percentile(latencies_ns, 0.50));
+        std::printf("latency p99    : %.1f ns\n", Percentile(latencies_ns, 0.99));
+        std::printf("latency p99.9  : %.1f ns\n", Percentile(latencies_ns, 0.999));
+        std::printf("latency max    : %.1f ns\n", latencies_ns.back());
+        std::printf("allocs/frame   : %.4f\n", static_cast<double>(allocations) / frames);
+        std::printf("checksum       : %.3f\n", checksum);
+        if (stages) {
+            std::fflush(stdout);
+            Instrumentation::Flush();
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,87 @@
+// 编译期特化模型基准：同一序列上对比运行时配置的 CameramanModel 与 DeploymentModel
+// （构建时由 CAMERA_STATIC_CONFIG 生成）的每帧耗时，并核对两者输出逐位一致、每帧不分配。
+//   static_model_bench [trace.(bin|jsonl)|-] [repeat]
+// 不给 trace 时使用固定种子的合成序列。
+#include "AllocCounter.hpp"
+#include "camera/CameramanModel.hpp"
+#include "camera/DeploymentProfile.hpp"
+#include "camera/DetectionTrace.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+struct Result {
+    double ns_per_frame = 0.0;
+    size_t allocations = 0;
+    std::vector<float> targets;   // 最后一轮的输出
+};
+
+// 首帧初始化记忆窗口，不计入统计
+template <typename Model, typename Factory>
+Result Run(const DetectionTrace& trace, size_t repeat, Factory make) {
+    Result result;
+    result.targets.resize(trace.size());
+    double total_ns = 0.0;
+    for (size_t r = 0; r < repeat; ++r) {
+        std::unique_ptr<Model> model = make();
+        result.targets[0] = model->predict(trace.framePlayers(0), trace.frameBalls(0));
+
+        ScopedAllocCount counter;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (size_t i = 1; i < trace.size(); ++i) {
+            result.targets[i] = model->predict(trace.framePlayers(i), trace.frameBalls(i));
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        result.allocations += counter.count();
+        total_ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+    }
+    result.ns_per_frame = total_ns / (repeat * (trace.size() - 1));
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        const DetectionTrace trace = argc > 1 && std::string(argv[1]) != "-"
+            ? DetectionTrace::Load(argv[1])
+            : GenerateSyntheticTrace(SyntheticTraceOptions{});
+        const size_t repeat = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20;
+        if (trace.size() < 2 || repeat == 0) throw std::runtime_error("Trace needs at least 2 frames");
+
+        // 运行时模型使用与生成配置等价的固定快照
+        ConfigManager config(std::make_shared<ConfigManager::Params>(DeploymentModel::MakeParams()));
+
+        const Result runtime = Run<CameramanModel>(trace, repeat, [&] {
+            return std::make_unique<CameramanModel>(config);
+        });
+        const Result fixed = Run<DeploymentModel>(trace, repeat, [] {
+            return std::make_unique<DeploymentModel>();
+        });
+
+        size_t mismatches = 0;
+        for (size_t i = 0; i < trace.size(); ++i) {
+            if (std::memcmp(&runtime.targets[i], &fixed.targets[i], sizeof(float)) != 0) ++mismatches;
+        }
+
+        const size_t frames = repeat * (trace.size() - 1);
+        std::printf("config         : %s\n", DeploymentProfile::kSourcePath);
+        std::printf("frames         : %zu (%zu x %zu)\n", frames, repeat, trace.size() - 1);
+        std::printf("runtime model  : %.1f ns/frame, %.4f allocs/frame\n",
+                    runtime.ns_per_frame, static_cast<double>(runtime.allocations) / frames);
+        std::printf("static model   : %.1f ns/frame, %.4f allocs/frame\n",
+                    fixed.ns_per_frame, static_cast<double>(fixed.allocations) / frames);
+        std::printf("speedup        : %.2fx\n", runtime.ns_per_frame / fixed.ns_per_frame);
+        std::printf("mismatches     : %zu / %zu\n", mismatches, trace.size());
+        return mismatches == 0 ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
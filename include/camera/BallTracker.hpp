@@ -0,0 +1,86 @@
+#pragma once
+#include "camera/ConfigManager.hpp"
+#include "camera/KalmanFilter.hpp"
+#include "camera/Span.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+class StateReader;
+class StateWriter;
+
+// 多假设球跟踪：固定容量的常速度卡尔曼轨迹池（状态 [x, vx]），每帧对候选球做门限内最近邻关联，
+// 未关联的候选生成新轨迹，连续丢失的轨迹结束。输出置信度最高的轨迹（置信度按与球员均值的
+// 距离折减，场边静止的备用球同样每帧被检测到，仅凭命中率无法与比赛球区分），
+// 取代直接使用 balls[0]（备用球、误检会按到达顺序被选中）。
+// 全部状态为定长数组与定长 Eigen 矩阵，update() 不产生堆分配。
+class BallTracker {
+public:
+    static constexpr size_t kMaxTracks = 8;
+    // 每帧参与关联的候选上限，超出部分忽略
+    static constexpr size_t kMaxCandidates = 16;
+
+    struct Track {
+        uint32_t id = 0;
+        bool active = false;
+        // 命中与丢失按名义帧计数，变帧率时每帧按实际间隔累计；与整数参数比较时留半帧余量，
+        // 时间戳抖动不会改变判定
+        float hits = 0.0f;       // 累计命中的名义帧数
+        float misses = 0.0f;     // 连续丢失的名义帧数
+        float confidence = 0.0f; // [0, 1]，命中上升、丢失衰减
+        float y = 0.0f;          // 最近一次关联的 y，只用于关联距离
+        float x() const { return filter.state()(0); }
+        float velocity() const { return filter.state()(1); }
+        bool confirmed(int confirm_hits) const { return hits > confirm_hits - 0.5f; }
+
+        KalmanFilter<2, 1> filter{
+            KalmanFilter<2, 1>::State::Zero(),
+            KalmanFilter<2, 1>::StateMatrix::Identity(),
+            KalmanFilter<2, 1>::ObservationMatrix(1.0f, 0.0f),
+            KalmanFilter<2, 1>::StateMatrix::Identity(),
+            KalmanFilter<2, 1>::StateMatrix::Zero(),
+            KalmanFilter<2, 1>::MeasurementMatrix::Identity()
+        };
+    };
+
+    BallTracker(const ConfigManager::Params::BallTrackerParams& params, int fps);
+
+    // 推进一帧并关联候选；player_x 为本帧球员均值位置。存在可用轨迹时写入 ball_x 并返回 true
+    bool update(Span<const Point> balls, float player_x, float& ball_x);
+    // 变帧率：dt 为距上一帧的实际秒数，轨迹按 dt 预测
+    bool update(Span<const Point> balls, float player_x, float& ball_x, float dt);
+
+    // 配置变化时更新噪声与门限，已有轨迹保留
+    void configure(const ConfigManager::Params::BallTrackerParams& params, int fps);
+    void reset();
+
+    size_t activeTracks() const;
+    // 当前输出的轨迹，没有时返回 nullptr
+    const Track* selected() const;
+    const std::array<Track, kMaxTracks>& tracks() const { return tracks_; }
+
+    // 保存轨迹池与选择状态；转移矩阵与噪声由 configure() 按配置重建，不写入快照
+    void saveState(StateWriter& out) const;
+    void loadState(StateReader& in);
+
+private:
+    void setTimeStep(float dt);
+    void startTrack(Track& track, const Point& candidate);
+    Track* selectBest(float player_x);
+    float score(const Track& track, float player_x) const;
+
+    ConfigManager::Params::BallTrackerParams params_;
+    KalmanFilter<2, 1>::StateMatrix F_;
+    KalmanFilter<2, 1>::StateMatrix Q_;
+    KalmanFilter<2, 1>::StateMatrix P0_;
+    float nominal_dt_ = 0.0f;   // 1/fps
+    float dt_ = 0.0f;           // F_、Q_ 对应的步长
+    float frame_ratio_ = 1.0f;  // dt_ 相当的名义帧数
+    float confidence_gain_ = 0.0f;
+    float miss_decay_ = 1.0f;
+    float gate_scale_ = 1.0f;
+
+    std::array<Track, kMaxTracks> tracks_;
+    int selected_ = -1;
+    uint32_t next_id_ = 1;
+};
@@ -0,0 +1,118 @@
+#pragma once
+#include "camera/BallTracker.hpp"
+#include "camera/ConfigManager.hpp"
+#include "camera/CourtIndex.hpp"
+#include "camera/DensityFocus.hpp"
+#include "camera/PlayerFilter.hpp"
+#include "camera/Span.hpp"
+#include "camera/TargetFilter.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+// 多路相机批量推进：一次 predictBatch() 推进 K 路相机，每一路对同一输入序列的输出
+// 与绑定同一配置实例的独立 CameramanModel 逐位一致（固定帧率与带时间戳两种调用、配置热更新）。
+// 检测数量逐路不同的阶段（场内过滤、离群剔除、密度焦点、球跟踪、目标滤波）逐路调用与
+// CameramanModel 相同的组件；记忆窗口、slider 滤波状态、球场边界与各路配置标量按路排成
+// 结构数组（SoA），速度、slider 滤波、融合与裁剪在相机维度上逐元素计算，可向量化。
+// 不记录调试信息与埋点；首帧之后、配置不变时每帧不分配。
+class CameramanBank {
+public:
+    // 单路相机本帧的检测结果，只在 predictBatch() 调用期间读取
+    struct CameraInput {
+        Span<const Point> players;
+        Span<const Point> balls;
+    };
+
+    // 每路绑定一个配置实例（可多路共用同一实例），生存期须长于 bank；
+    // 球场取各自配置快照中的 court_points，热更新后各路独立切换
+    explicit CameramanBank(const std::vector<const ConfigManager*>& configs);
+
+    // 固定帧率：inputs 与 targets 长度均为 size()
+    void predictBatch(Span<const CameraInput> inputs, float* targets);
+    // 变帧率：timestamps_us[k] 为第 k 路本帧采集时刻（微秒），语义同 CameramanModel::predict
+    void predictBatch(Span<const CameraInput> inputs, const uint64_t* timestamps_us, float* targets);
+
+    size_t size() const { return lanes_.size(); }
+    float speed(size_t camera) const { return speed_[camera]; }
+    float filteredSlider(size_t camera) const { return slider_x_[camera]; }
+    std::tuple<float, float> transfer(size_t camera, float x) const {
+        return lanes_[camera].params->transfer.curve.evaluate(x);
+    }
+
+private:
+    using Params = ConfigManager::Params;
+
+    // 逐路有状态、输入长度可变的组件
+    struct Lane {
+        Lane(const ConfigManager& config, uint64_t version, std::shared_ptr<const Params> snapshot);
+
+        const ConfigManager* config;
+        uint64_t config_version;
+        std::shared_ptr<const Params> params;
+        PlayerFilter player_filter;
+        BallTracker ball_tracker;
+        TargetFilter target_filter;
+        DensityFocus focus;
+        CourtIndex court;
+        CourtIndex ball_court;
+        // 场内检测暂存区，容量固定
+        std::vector<Point> court_players;
+        std::vector<Point> court_balls;
+        bool initialized = false;
+        bool timed = false;
+        uint64_t last_timestamp_us = 0;
+    };
+
+    void predict(Span<const CameraInput> inputs, const uint64_t* timestamps_us, float* targets);
+    void stepLane(size_t k, const CameraInput& input, bool timed, uint64_t timestamp_us);
+    void applySnapshot(size_t k, std::shared_ptr<const Params> params);
+    void updateBounds(size_t k);
+
+    // 记忆窗口：按 [slot][camera] 排布的环，各路容量、读指针与淘汰时长独立
+    size_t historySize(size_t k) const;
+    size_t historyCapacity(size_t k) const;
+    uint64_t historyHorizonUs(size_t k) const;
+    bool historyMatchesConfig(size_t k) const;
+    void initializeHistory(size_t k, float initial);
+    void pushHistory(size_t k, float value);
+    void pushHistory(size_t k, float value, uint64_t timestamp_us);
+    void popHistory(size_t k);
+    size_t wrapHistory(size_t k, size_t slot) const {
+        return slot < history_capacity_[k] ? slot : slot - history_capacity_[k];
+    }
+    float historyBack(size_t k) const;
+
+    std::vector<Lane> lanes_;
+
+    size_t history_slots_ = 0;
+    std::vector<float> history_;
+    std::vector<uint64_t> history_times_;
+    std::vector<size_t> history_head_;
+    std::vector<size_t> history_size_;
+    std::vector<size_t> history_capacity_;
+    std::vector<uint64_t> history_horizon_us_;
+
+    // slider 随机游走滤波（F = H = 1）的状态与噪声
+    std::vector<float> slider_x_;
+    std::vector<float> slider_p_;
+    std::vector<float> slider_q_;
+    std::vector<float> slider_r_;
+
+    // 球场 x 范围加 buffer_pixels 后的目标边界，与各路当前快照的标量参数
+    std::vector<float> min_target_;
+    std::vector<float> max_target_;
+    std::vector<float> fps_;
+    std::vector<float> intervals_;     // 名义窗口的帧间隔数 historySize() - 1
+    std::vector<float> speed_max_;
+    std::vector<float> merge_ratio_;
+
+    // 每帧中间量
+    std::vector<float> focus_x_;
+    std::vector<float> ball_x_;
+    std::vector<float> dt_;
+    std::vector<float> speed_;
+    std::vector<float> raw_target_;
+};
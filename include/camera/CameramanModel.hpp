@@ -1,48 +1,125 @@
 #pragma once
 #include "camera/KalmanFilter1D.hpp"  // 添加这行
 #include "camera/ConfigManager.hpp"    // 添加这行
-#include <deque>
+#include "camera/BallTracker.hpp"
+#include "camera/CourtIndex.hpp"
+#include "camera/DensityFocus.hpp"
+#include "camera/PlayerFilter.hpp"
+#include "camera/TargetFilter.hpp"
+#include "camera/Instrumentation.hpp"
+#include "camera/PlayerStats.hpp"
+#include "camera/SlidingWindow.hpp"
+#include "camera/Span.hpp"
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <optional>
-#include <unordered_map> 
 
 class CameramanModel {
 public:
+    // 使用默认配置实例（ConfigManager::Initialize），court_points 为初始球场
     explicit CameramanModel(const std::vector<Point>& court_points);
+    // 每路相机可绑定独立的配置实例；config 的生存期须长于模型。
+    // predict() 发现配置版本变化时切换到新快照，不同模型各自独立切换
+    explicit CameramanModel(const ConfigManager& config);
+    CameramanModel(const ConfigManager& config, const std::vector<Point>& court_points);
     
     float predict(
         const std::vector<Point>& player_positions,
         const std::vector<Point>& ball_positions
     );
 
+    // 零拷贝版本：只读取视图，空输入按上一帧位置处理，每帧不产生堆分配
+    float predict(
+        Span<const Point> player_positions,
+        Span<const Point> ball_positions
+    );
+
+    // 变帧率版本：timestamp_us 为本帧采集时刻（微秒）。速度、记忆窗口（按时间淘汰）与各滤波器的
+    // 过程噪声都按与上一帧的实际间隔计算，检测丢帧、批量到达或降到 15 fps 运行时无需重新调参。
+    // 时间戳倒退时按间隔 0 处理；同一模型切换调用方式时以上一帧位置重建记忆窗口
+    float predict(
+        Span<const Point> player_positions,
+        Span<const Point> ball_positions,
+        uint64_t timestamp_us
+    );
+
     struct DebugInfo {
-        float raw_target;
-        float filtered_target;
+        float raw_target;        // 融合并裁剪后的原始目标
+        float filtered_target;   // 运动模型滤波并做延迟外推后的输出目标
         float mean_player_pos;
+        float focus_x;           // 参与融合的球员位置：均值，或 density 模式下的密度焦点
         float calculated_speed;
         float focus_slider;
+        float window_mean;   // 记忆窗口内均值位置
+        float window_min;    // 记忆窗口内最左球员
+        float window_max;    // 记忆窗口内最右球员
+        float ball_x;        // 参与融合的球位置（跟踪输出或上一帧位置）
+        uint32_t ball_track_id;  // 输出轨迹编号，0 表示没有可用轨迹
+        float target_velocity;   // 目标滤波估计的速度（像素/秒），滤波关闭时为 0
+        float frame_dt;          // 本帧时间步长（秒），固定帧率调用时为 1/fps
+        uint32_t off_court;         // 本帧落在球场（含 boundary_margin）外被丢弃的球员与球检测数
+        uint32_t truncated;         // 本帧超出暂存区容量、未参与计算的球员与球检测数
+        uint32_t rejected_players;  // 本帧被剔除的离群检测数
+        bool player_hold;           // 本帧球员位置沿用上一帧
     };
 
     std::optional<DebugInfo> getDebugInfo() const;
     std::tuple<float, float> transfer(float x) const;
+    // 批量映射整段目标轨迹（多机位扇出、回放工具），ys / fovs 至少容纳 xs.size() 个元素
+    void transferMany(Span<const float> xs, float* ys, float* fovs) const;
+
+    // 热备切换：把历史窗口、各滤波器状态与球场多边形写成紧凑快照（out 先清空，
+    // 容量足够后不再分配）。备用进程以相同配置构造模型后 restoreState()，
+    // 之后对同一输入的输出与原进程逐位一致。快照损坏、版本不符时抛出 std::runtime_error，
+    // 此时模型状态不完整，应丢弃后冷启动
+    void saveState(std::vector<uint8_t>& out) const;
+    void restoreState(Span<const uint8_t> state);
 
 private:
-    void initializeHistory(const std::vector<Point>& positions);
-    float calculateAccumulatedSpeed(const std::deque<float>& positions) const;
-    void handleEmptyInput(std::vector<Point>& players, std::vector<Point>& balls) const;
+    float predictFrame(Span<const Point> players, Span<const Point> balls,
+                       bool timed, uint64_t timestamp_us);
+    void initializeHistory(float initial);
+    size_t historySize() const;          // memory_length * fps，名义帧率下窗口内的样本数
+    size_t historyCapacity() const;
+    uint64_t historyHorizonUs() const;   // 按样本数淘汰时为 0
+    bool historyMatchesConfig() const;
+    float calculateAccumulatedSpeed() const;
+    void updateCourt(const std::vector<Point>& court_points);
+    void buildCourt();
+    void applySnapshot(std::shared_ptr<const ConfigManager::Params> params);
+
+    // 容量 memory_length * fps，初始化后不再分配
+    SlidingWindow player_pos_memory_;
+    SlidingWindow player_max_memory_;
+    SlidingWindow player_min_memory_;
 
-    std::deque<float> player_pos_memory_ = {0.f};
-    std::deque<float> player_max_memory_;
-    std::deque<float> player_min_memory_;
-    std::deque<float> ball_pos_memory_;
+    const ConfigManager& config_;
+    uint64_t config_version_ = 0;   // 须先于 params_ 初始化
+    // 当前使用的配置快照，只在 predict() 所在线程内替换
+    std::shared_ptr<const ConfigManager::Params> params_;
 
-    std::unique_ptr<KalmanFilter1D> slider_filter_;
-    std::unordered_map<std::string, std::unique_ptr<KalmanFilter1D>> kalman_filters_;
+    KalmanFilter1D slider_filter_;
+    // 统计前剔除离群检测，幸存者不足或均值突跳时保持上一帧位置
+    PlayerFilter player_filter_;
+    // 多候选球跟踪，输出置信度最高的轨迹参与融合
+    BallTracker ball_tracker_;
+    // 输出目标的常速度/常加速度滤波与延迟补偿
+    TargetFilter target_filter_;
+    // focus.mode = density 时的球员 x 直方图，帧环与记忆窗口同步淘汰
+    DensityFocus focus_;
 
-    const ConfigManager::Params& params_;
-    float left_most_;
-    float right_most_;
+    // 球场多边形与按行栅格化的场内索引，构造与每次重载时重建；
+    // 统计前先丢弃场外检测（观众、替补席），目标按多边形整体 x 范围裁剪；
+    // 球使用向上放宽 ball_loft_margin 的索引
+    std::vector<Point> court_points_;
+    CourtIndex court_;
+    CourtIndex ball_court_;
+    // 场内检测暂存区，容量固定（超出部分截断并计数），每帧不分配
+    std::vector<Point> court_players_;
+    std::vector<Point> court_balls_;
     bool initialized_ = false;
+    bool timed_ = false;               // 记忆窗口按时间淘汰（带时间戳调用）
+    uint64_t last_timestamp_us_ = 0;
     mutable std::optional<DebugInfo> debug_info_;
 };
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+#include "camera/ConfigManager.hpp"
+#include <ctime>
+#include <string>
+
+// 预编译配置（CMCF）：经校验的主配置与所选球场点打包成带格式版本和校验和的平坦二进制。
+// 读取时 mmap 整个文件，校验后按固定布局直接拷贝，不做任何文本解析。
+// 布局：头部 {magic "CMCF", u32 版本, u64 负载长度, u64 负载 FNV-1a 校验和, i64 源 JSON mtime}，
+// 负载为定长参数块、三个球场路径字符串和球场点数组。仅在同一平台的构建之间交换。
+class ConfigBlob {
+public:
+    // 2: 增加 ball_tracker 参数；3: 增加 target_filter 参数；4: 增加 focus 参数；
+    // 5: 增加 safety.ball_loft_margin
+    static constexpr uint32_t kFormatVersion = 5;
+
+    // camera_config.json -> camera_config.bin；已是 .bin 时原样返回
+    static std::string PathFor(const std::string& config_path);
+
+    // 原子写入（临时文件 + rename），正在启动的进程不会读到写了一半的文件。
+    // config_mtime 为源 JSON 的修改时间，用于判断编译结果是否过期
+    static void Write(const std::string& blob_path,
+                      const ConfigManager::Params& params,
+                      const ConfigManager::SourceFiles& files,
+                      time_t config_mtime);
+
+    // 文件不存在，或 json_mtime 非 0 且与编译时记录的不同（JSON 已修改）时返回 false；
+    // 文件损坏、版本不符时抛出 std::runtime_error
+    static bool Read(const std::string& blob_path,
+                     time_t json_mtime,
+                     ConfigManager::Params& params,
+                     ConfigManager::SourceFiles& files);
+};
@@ -2,13 +2,19 @@
 #include <string>
 #include <stdexcept>
 #include <nlohmann/json.hpp>
+#include "camera/TransferCurve.hpp"
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <ctime>
 
 struct Point { float x, y; }; 
 
+class ConfigWatcher;
+
 class ConfigManager {
 public:
-    static bool ReloadCourtPointsIfNeeded();
     struct Params {
         struct KalmanParams {
             float variance_position;
@@ -28,26 +34,140 @@ public:
             float x_min, x_max;
             float y_min, y_max;
             float fov_min, fov_max;
+            // 可选 mode（exact/lut/polynomial，默认 exact）与 lut_size，加载时预先构建
+            TransferCurve curve;
         };
         struct SafetyParams {
             int noise_threshold;
             int min_players;
             int boundary_margin;
+            int ball_loft_margin = 400;    // 可选：球的场内判断额外向上放宽的像素数（高空球）
+        };
+
+        // 可选 ball_tracker 段，缺省时使用以下默认值
+        struct BallTrackerParams {
+            float gate_pixels = 150.0f;        // 关联门限：候选与轨迹预测位置的最大距离
+            int confirm_hits = 3;              // 连续命中次数达到后轨迹确认
+            int max_misses = 10;               // 连续丢失超过该帧数后轨迹结束
+            float accel_noise = 3000.0f;       // 常速度模型的加速度噪声标准差（像素/秒²）
+            float measurement_noise = 5.0f;    // 检测位置噪声标准差（像素）
+            float player_affinity = 1000.0f;   // 选择轨迹时按与球员均值的距离折减置信度的尺度（像素）
+        };
+
+        // 可选 target_filter 段：目标 x 的常速度/常加速度滤波与延迟补偿，缺省关闭。
+        // 测量噪声与初始位置方差取自 kalman.base
+        struct TargetFilterParams {
+            enum class Model : uint32_t { Off, ConstantVelocity, ConstantAcceleration };
+            Model model = Model::Off;
+            float process_noise = 1500.0f;     // cv: 加速度噪声标准差（像素/秒²）；ca: 加加速度（像素/秒³）
+            float lead_ms = 0.0f;              // 按估计速度（加速度）向前预测的时间，补偿检测与云台延迟
+        };
+
+        // 可选 focus 段：参与融合的球员位置。mean 为幸存球员 x 的均值（缺省）；
+        // density 为记忆窗口内球员 x 分桶直方图上、window_pixels 宽度内球员最多区间的中心
+        struct FocusParams {
+            enum class Mode : uint32_t { Mean, Density };
+            Mode mode = Mode::Mean;
+            uint32_t bins = 256;               // 球场宽度上的分桶数
+            float window_pixels = 1200.0f;     // 镜头画面覆盖的全景宽度（像素）
         };
 
         KalmanParams base;
         KalmanParams slider;
         CameraParams camera;
         SafetyParams safety;
+        BallTrackerParams ball_tracker;
+        TargetFilterParams target_filter;
+        FocusParams focus;
         TransferParams transfer;           // <--- 补充
         std::vector<Point> court_points;   // <--- 补充
     };
 
-    static void Initialize(const std::string& config_path);
+    // 每个实例对应一份配置文件，对外发布不可变的引用计数 Params 快照。
+    // 重新加载时构建完整的新快照后原子替换（RCU 式），已取得旧快照的读者不受影响；
+    // 读端只有一次原子读取 Version()，版本变化时再取 Snapshot()，全程不加锁。
+    // 构造时同步加载，失败抛出异常；watch=true 时启动后台线程监视配置与球场文件。
+    explicit ConfigManager(std::string config_path, bool watch = true);
+    // 固定快照实例：不关联配置文件、不监视，Reload() 恒返回 false（离线回放、参数扫描用）。
+    // 参数非法时抛出 std::invalid_argument
+    explicit ConfigManager(std::shared_ptr<const Params> params);
+    ~ConfigManager();
+
+    ConfigManager(const ConfigManager&) = delete;
+    ConfigManager& operator=(const ConfigManager&) = delete;
+
+    std::shared_ptr<const Params> Snapshot() const;
+    // 每次发布新快照递增，初始为 0
+    uint64_t Version() const { return version_.load(std::memory_order_acquire); }
+
+    // 检查配置与球场文件，有变化则发布新快照并返回 true；解析失败时保留旧快照。
+    // 可与监视线程并发调用。
+    bool Reload();
+
+    void StartWatching();
+    void StopWatching();
+
+    // 兼容接口：进程默认实例。再次 Initialize 时原地切换配置文件并发布新快照，
+    // 已绑定 Default() 的模型继续有效；新配置加载失败时抛出异常并保留原配置。
+    // Get() 已废弃，仅为旧调用方保留：返回默认实例的当前快照，热更新后下次调用即可见；
+    // 返回的引用只在热更新后再次调用 Get() 之前有效。新代码改用 Default().Snapshot()
+    static void Initialize(const std::string& config_path, bool watch = true);
     static const Params& Get();
+    static ConfigManager& Default();
+
+    // 配置引用的球场文件，以及按当前时间选中的文件与其修改时间
+    struct SourceFiles {
+        std::string default_court;
+        std::string user_court;
+        std::string court_file;
+        time_t court_mtime = 0;
+    };
+
+    // 加载完整配置（含所选球场）。同名 .bin 预编译配置存在且不旧于 JSON 时直接映射读取，
+    // 否则解析 JSON；files 返回配置引用的球场文件
+    static std::shared_ptr<Params> LoadParams(const std::string& config_path,
+                                              SourceFiles* files = nullptr);
+    // 只解析 JSON，忽略预编译配置（供配置编译工具使用）
+    static std::shared_ptr<Params> LoadJson(const std::string& config_path,
+                                            SourceFiles* files = nullptr);
+
+    // 用户球场文件存在且一天内修改过则优先使用，mtime 返回所选文件的修改时间
+    static std::string SelectCourtFile(const std::string& default_court,
+                                       const std::string& user_court,
+                                       time_t* mtime);
+    static std::vector<Point> LoadCourtPoints(const std::string& court_file);
+    static void ReadCourtPaths(const nlohmann::json& data,
+                               std::string& default_court,
+                               std::string& user_court);
 
 private:
-    static Params params_;
-    static void ValidateParams();
+    std::vector<std::string> WatchedFiles() const;
+    void Publish(std::shared_ptr<const Params> next);
+    // 改为跟踪另一份配置文件并发布其快照；加载失败时抛出异常，状态不变
+    void Retarget(const std::string& config_path);
+
+    std::string config_path_;
+    // 写端状态，由 reload_mutex_ 保护；读端只访问 params_ / version_
+    mutable std::mutex reload_mutex_;
+    time_t config_mtime_ = 0;
+    time_t blob_mtime_ = 0;
+    SourceFiles files_;
+
+    std::shared_ptr<const Params> params_;
+    std::atomic<uint64_t> version_{0};
+    std::unique_ptr<ConfigWatcher> watcher_;
+
+    static std::unique_ptr<ConfigManager> default_;
+    // Get() 最近一次交出引用的快照
+    static std::mutex pinned_mutex_;
+    static std::shared_ptr<const Params> pinned_;
+
+    static std::shared_ptr<Params> LoadSources(const std::string& config_path,
+                                               SourceFiles& files);
+    // 解析主配置中除球场点以外的全部参数，并读出球场文件路径
+    static std::shared_ptr<Params> ParseConfigFile(const std::string& config_path,
+                                                   std::string& default_court,
+                                                   std::string& user_court);
+    static void ValidateParams(const Params& params);
     static void ParseKalmanParams(const nlohmann::json& j, Params::KalmanParams& params);
 };
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 后台配置监视线程：inotify 监听配置目录，不可用时退化为 stat 轮询。
+// 文件解析全部在监视线程内由 refresh 回调完成，帧路径只需一次原子读取版本号。
+class ConfigWatcher {
+public:
+    // 检查文件并按需发布新快照，返回需要监听的文件（监听其所在目录）
+    using RefreshFn = std::function<std::vector<std::string>()>;
+
+    explicit ConfigWatcher(
+        RefreshFn refresh,
+        std::chrono::milliseconds poll_interval = std::chrono::milliseconds(1000)
+    );
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    void Start();
+    void Stop();
+
+private:
+    void Run();
+    void Refresh();
+    void AddWatches(const std::vector<std::string>& files);
+
+    RefreshFn refresh_;
+    std::chrono::milliseconds poll_interval_;
+
+    // 只在监视线程内访问
+    std::vector<std::string> watched_dirs_;
+
+    std::atomic<bool> running_{false};
+    int inotify_fd_ = -1;
+    int wake_fd_ = -1;
+    std::thread thread_;
+};
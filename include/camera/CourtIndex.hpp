@@ -0,0 +1,58 @@
+#pragma once
+#include "camera/ConfigManager.hpp"
+#include "camera/PlayerStats.hpp"
+#include "camera/Span.hpp"
+#include <cstddef>
+#include <vector>
+
+// 球场几何索引：把 court_points 多边形（全景下为透视四边形）按行栅格化为每行的 x 范围表，
+// 每次加载球场时构建一次，之后点是否在场内、某一 y 处的左右边界都是 O(1) 查表。
+// 边界余量 margin 向四周外扩：每行取上下 margin 以内多边形的最宽范围，再左右各扩 margin。
+// 同一行内按最左、最右交点取范围，凹多边形的凹口按场内处理。
+// 可选的 loft 只向上外扩：每行再并入其下方 loft 以内的范围，用于高空球（画面中高于其地面投影）。
+class CourtIndex {
+public:
+    // 行数上限，球场更高时按比例加大行高
+    static constexpr size_t kMaxRows = 4096;
+
+    struct Extents {
+        float left;
+        float right;
+    };
+
+    // 未构建时不过滤任何检测，整体边界沿用默认值 (0, 1920)
+    CourtIndex() = default;
+
+    // 少于 3 个点时退化为未构建状态，只更新整体边界（无点时不变）
+    void build(const std::vector<Point>& polygon, float margin, float loft = 0.0f);
+
+    bool empty() const { return rows_ == 0; }
+    size_t rows() const { return rows_; }
+    float margin() const { return margin_; }
+
+    // 多边形整体的 x 范围（不含余量），用于目标裁剪
+    float left() const { return left_; }
+    float right() const { return right_; }
+
+    // y 所在行的 x 范围（含余量）；超出索引的行返回 false。未构建时返回整体边界
+    bool extents(float y, Extents& out) const;
+
+    bool contains(Point p) const;
+
+    // 把场内的点按原顺序写入 out，返回写入个数；最多处理 capacity 个输入，超出部分忽略。
+    // 未构建时原样复制。按 SIMD 能力分派，各路径结果一致
+    size_t filter(Span<const Point> points, Point* out, size_t capacity) const;
+    // 指定路径，供测试与基准对比；请求的指令集不可用时退回标量
+    size_t filter(Span<const Point> points, Point* out, size_t capacity, SimdLevel level) const;
+
+private:
+    float y0_ = 0.0f;          // 第 0 行上沿
+    float inv_row_height_ = 1.0f;
+    size_t rows_ = 0;
+    float margin_ = 0.0f;
+    float left_ = 0.0f;
+    float right_ = 1920.0f;
+    // 每行的 x 范围，分开存放便于按行号 gather；不与多边形相交的行为空区间 (+inf, -inf)
+    std::vector<float> row_left_;
+    std::vector<float> row_right_;
+};
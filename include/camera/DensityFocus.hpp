@@ -0,0 +1,66 @@
+#pragma once
+#include "camera/ConfigManager.hpp"
+#include "camera/Span.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class StateReader;
+class StateWriter;
+
+// 球员 x 的密度焦点（focus.mode = density）。
+// 记忆窗口内各帧幸存球员的 x 落入球场宽度上的定长分桶，帧进入、离开窗口时增量加减计数；
+// 定位时滑动窗口扫描一遍分桶，找出 window_pixels 宽度内球员最多的区间，输出区间内球员的分桶加权中心。
+// 一端扎堆、少数球员落后时均值被拉向中间，密度焦点对准扎堆的一侧。
+// 帧环与 SlidingWindow 的淘汰规则相同（按帧数，或按时间且至少保留两帧）。
+// reset() / configure() 分配内存，之后每帧 O(球员数 + bins)，不排序、不分配。
+class DensityFocus {
+public:
+    using Params = ConfigManager::Params::FocusParams;
+
+    // 每帧最多记录的球员数，超出部分忽略
+    static constexpr size_t kMaxFramePlayers = 64;
+
+    // 分桶数、窗口宽度或球场范围 [left, right] 变化时重新分桶（窗口内已有的帧保留）
+    void configure(const Params& params, float left, float right);
+
+    // 清空窗口。按帧数：最多保留 capacity 帧；按时间：淘汰与最新帧相距达到 horizon_us 的帧
+    void reset(size_t capacity);
+    void reset(size_t capacity, uint64_t horizon_us);
+
+    void push(Span<const float> xs);
+    // 按时间模式入队，时间戳须单调不减
+    void push(Span<const float> xs, uint64_t timestamp_us);
+
+    // 球员最多的窗口的加权中心；计数相同的窗口取中心离 hint 最近的。窗口内没有球员时返回 false
+    bool locate(float hint, float& x) const;
+
+    size_t frames() const { return size_; }
+    size_t bins() const { return hist_.size(); }
+    uint32_t total() const { return total_; }
+
+    // 保存帧环（x 原值与时间戳），恢复时按当前配置重新分桶
+    void saveState(StateWriter& out) const;
+    void loadState(StateReader& in);
+
+private:
+    size_t wrap(size_t i) const { return i < counts_.size() ? i : i - counts_.size(); }
+    size_t binOf(float x) const;
+    void append(Span<const float> xs);
+    void popOldest();
+    void rebin();
+
+    Params params_;
+    float left_ = 0.0f;
+    float bin_width_ = 1.0f;
+    size_t window_bins_ = 1;
+    std::vector<uint32_t> hist_;
+
+    std::vector<float> xs_;          // 每帧 kMaxFramePlayers 个槽位
+    std::vector<uint32_t> counts_;   // 各帧的球员数
+    std::vector<uint64_t> times_;    // 按时间模式下各帧的时间戳
+    uint64_t horizon_us_ = 0;        // 0 表示按帧数淘汰
+    size_t head_ = 0;                // 最旧帧所在槽位
+    size_t size_ = 0;
+    uint32_t total_ = 0;             // 窗口内的球员总数
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include "camera/ConfigManager.hpp"
+#include "camera/Span.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 录制的逐帧检测序列。所有帧的点连续存放，按帧偏移索引，回放时直接取视图。
+//
+// 二进制格式（小端）：
+//   header  : "CMTR" | u32 version | u64 frame_count | u64 player_count | u64 ball_count
+//   frames  : frame_count x { u64 timestamp_us | u32 num_players | u32 num_balls }
+//   players : player_count x { f32 x | f32 y }
+//   balls   : ball_count x { f32 x | f32 y }
+// JSONL 格式：每行 {"t": timestamp_us, "players": [[x, y], ...], "balls": [[x, y], ...]}
+struct DetectionTrace {
+    struct Frame {
+        uint64_t timestamp_us;
+        uint32_t player_offset;
+        uint32_t num_players;
+        uint32_t ball_offset;
+        uint32_t num_balls;
+    };
+
+    std::vector<Frame> frames;
+    std::vector<Point> players;
+    std::vector<Point> balls;
+
+    size_t size() const { return frames.size(); }
+    Span<const Point> framePlayers(size_t i) const {
+        return {players.data() + frames[i].player_offset, frames[i].num_players};
+    }
+    Span<const Point> frameBalls(size_t i) const {
+        return {balls.data() + frames[i].ball_offset, frames[i].num_balls};
+    }
+
+    void addFrame(uint64_t timestamp_us, Span<const Point> frame_players,
+                  Span<const Point> frame_balls);
+
+    // 按扩展名选择格式：.jsonl 为文本，其余为二进制
+    static DetectionTrace Load(const std::string& path);
+    void save(const std::string& path) const;
+
+    static DetectionTrace LoadBinary(const std::string& path);
+    static DetectionTrace LoadJsonl(const std::string& path);
+    void saveBinary(const std::string& path) const;
+    void saveJsonl(const std::string& path) const;
+};
+
+// 可复现的合成检测序列：快攻、空帧、检测噪声与场外误检。
+// 只使用 mt19937 的原始输出自行变换分布，不同标准库实现下结果一致。
+struct SyntheticTraceOptions {
+    size_t frames = 30 * 60 * 10;     // 默认 10 分钟 @30fps
+    int fps = 30;
+    uint32_t seed = 1;
+    float court_width = 5376.0f;
+    float court_height = 1520.0f;
+    int players = 10;                 // 场上球员数
+    float empty_frame_rate = 0.02f;   // 整帧无检测的概率
+    float miss_rate = 0.1f;           // 单个球员漏检概率
+    float noise_px = 15.0f;           // 检测位置噪声（标准差）
+    float false_positive_rate = 0.3f; // 每帧出现一个场外误检的概率
+    float fast_break_rate = 0.004f;   // 每帧触发快攻的概率
+};
+
+DetectionTrace GenerateSyntheticTrace(const SyntheticTraceOptions& options);
@@ -0,0 +1,123 @@
+#pragma once
+#include "camera/BoundedQueue.hpp"
+#include "camera/CameramanModel.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+constexpr size_t kMaxPlayersPerFrame = 64;
+constexpr size_t kMaxBallsPerFrame = 8;
+
+// 带时间戳的一帧检测结果，定长存储，入队出队不分配内存
+struct DetectionFrame {
+    uint64_t sequence = 0;
+    uint64_t timestamp_ns = 0;      // 采集时刻，Instrumentation::NowNs() 时基；0 表示按固定帧率处理
+    uint32_t num_players = 0;
+    uint32_t num_balls = 0;
+    std::array<Point, kMaxPlayersPerFrame> players;
+    std::array<Point, kMaxBallsPerFrame> balls;
+
+    // 超出容量的检测被截断，返回 false
+    bool assign(Span<const Point> frame_players, Span<const Point> frame_balls);
+    // 计数超出容量时按容量截断（帧可能来自其他进程写入的共享内存）
+    Span<const Point> playerSpan() const {
+        return {players.data(), std::min<size_t>(num_players, players.size())};
+    }
+    Span<const Point> ballSpan() const {
+        return {balls.data(), std::min<size_t>(num_balls, balls.size())};
+    }
+};
+
+// 按帧送入模型：带采集时刻的帧按实际间隔推进（变帧率 predict），timestamp_ns 为 0 时按固定帧率
+float PredictDetectionFrame(CameramanModel& model, const DetectionFrame& frame);
+
+// 输出给云台的控制指令
+struct PtzCommand {
+    uint64_t sequence;
+    uint64_t timestamp_ns;          // 对应检测帧的采集时刻
+    uint64_t emit_ns;               // 指令产生时刻
+    float target_x;
+    float y;
+    float fov;
+    uint32_t frames_merged;         // Coalesce 策略下本指令覆盖的帧数
+};
+
+// 异步流水线：检测帧经有界无锁队列进入专用（可绑核）线程执行 predict + transfer，
+// 结果写入输出队列。生产端 submit() 永不阻塞，过载时按策略丢帧或合并输出。
+class FramePipeline {
+public:
+    enum class OverloadPolicy {
+        DropOldest,   // 每帧输出一条指令；输入队列满时丢弃最旧帧，保证延迟有界
+        Coalesce      // 积压的帧全部送入模型保持历史连续，但只为最新一帧输出指令
+                      // （每次最多合并取帧时已积压的帧；队列满时同样淘汰最旧帧）
+    };
+
+    struct Options {
+        size_t input_capacity = 8;
+        size_t output_capacity = 64;
+        OverloadPolicy policy = OverloadPolicy::DropOldest;
+        int cpu = -1;                 // >= 0 时把工作线程绑定到该 CPU
+        uint32_t idle_spin = 256;     // 空闲时先自旋的次数，之后让出 CPU
+    };
+
+    struct Metrics {
+        uint64_t submitted;
+        uint64_t processed;           // 送入 predict 的帧数
+        uint64_t emitted;             // 输出的指令数
+        uint64_t dropped_input;       // DropOldest 丢弃的输入帧
+        uint64_t coalesced;           // Coalesce 合并掉的输出
+        uint64_t dropped_output;      // 输出队列满时丢弃的旧指令
+        size_t input_depth;
+        size_t output_depth;
+        size_t max_input_depth;
+        uint64_t latency_mean_ns;     // 采集到输出的端到端延迟，只统计带采集时刻的帧
+        uint64_t latency_max_ns;
+        uint64_t latency_p50_ns;      // 分位数按 2 的幂分桶估计（取桶上界）
+        uint64_t latency_p99_ns;
+    };
+
+    // model 在流水线运行期间只能由工作线程访问
+    FramePipeline(CameramanModel& model, const Options& options);
+    ~FramePipeline();
+
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    void start();
+    // 处理完已入队的帧后退出
+    void stop();
+
+    // 生产者线程调用，永不阻塞；为腾出空间淘汰了旧帧时返回 false
+    bool submit(const DetectionFrame& frame);
+    // 消费者线程调用；无指令时返回 false
+    bool poll(PtzCommand& command);
+
+    Metrics metrics() const;
+
+private:
+    static constexpr size_t kLatencyBuckets = 64;
+
+    void run();
+    void emit(const DetectionFrame& frame, float target, uint32_t frames_merged);
+    void recordLatency(uint64_t ns);
+
+    CameramanModel& model_;
+    Options options_;
+    BoundedQueue<DetectionFrame> input_;
+    BoundedQueue<PtzCommand> output_;
+    std::thread worker_;
+    std::atomic<bool> running_{false};
+
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> processed_{0};
+    std::atomic<uint64_t> emitted_{0};
+    std::atomic<uint64_t> dropped_input_{0};
+    std::atomic<uint64_t> coalesced_{0};
+    std::atomic<uint64_t> dropped_output_{0};
+    std::atomic<size_t> max_input_depth_{0};
+    std::atomic<uint64_t> latency_sum_ns_{0};
+    std::atomic<uint64_t> latency_max_ns_{0};
+    std::atomic<uint64_t> latency_hist_[kLatencyBuckets] = {};
+};
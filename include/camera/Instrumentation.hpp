@@ -0,0 +1,110 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// 帧路径埋点：阶段计时、计数器和诊断消息。
+// 消息写入本线程的无锁 SPSC 环，由导出线程统一取出并格式化输出；阶段耗时与计数器
+// 在本线程槽位内累加，导出时汇总。帧循环里不做控制台 I/O。编译时未定义 CAMERA_ENABLE_TRACE 则所有埋点宏展开为空。
+
+enum class Stage : uint8_t {
+    ReloadCheck,
+    Court,
+    Outlier,
+    Stats,
+    Focus,
+    BallTrack,
+    Speed,
+    Filter,
+    Clamp,
+    TargetFilter,
+    Count
+};
+
+enum class Counter : uint8_t {
+    EmptyFrameFallback,   // 无球员或无球时使用上一帧位置
+    BoundaryClamp,        // 目标被球场边界裁剪
+    ConfigReload,         // 球场配置重新发布
+    TraceDropped,         // 环满丢弃的埋点事件
+    OutlierRejected,      // 被中位数/MAD 剔除的球员检测
+    PlayerHold,           // 幸存球员不足或均值跳变未确认，保持上一帧位置
+    OffCourtRejected,     // 落在球场多边形（含边界余量）外的球员与球检测
+    InputTruncated,       // 超出模型暂存区容量被截断的球员与球检测
+    Count
+};
+
+struct StageStats {
+    uint64_t count = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+};
+
+class Instrumentation {
+public:
+    // 启动导出线程：每个周期取出全部事件，消息逐条输出，另附阶段耗时与计数器汇总
+    static void StartExporter(
+        FILE* sink = stderr,
+        std::chrono::milliseconds interval = std::chrono::milliseconds(1000)
+    );
+    // 停止前会做最后一次导出
+    static void StopExporter();
+
+    // 阶段计时需要读时钟，默认关闭；计数器和消息始终记录
+    static void SetTimingEnabled(bool enabled);
+    static bool TimingEnabled() { return timing_enabled_.load(std::memory_order_relaxed); }
+
+    static void Count(Counter counter, uint64_t n = 1);
+    static void RecordStage(Stage stage, uint64_t ns);
+    // message 必须具有静态生存期（字符串字面量），数值参数由导出线程格式化
+    static void Log(const char* message);
+    static void Log(const char* message, float a);
+    static void Log(const char* message, float a, float b);
+
+    static uint64_t CounterValue(Counter counter);
+    // 已分配的线程缓冲数：线程退出后缓冲交由新线程复用，不随线程创建次数增长
+    static size_t ThreadBufferCount();
+    static StageStats GetStageStats(Stage stage);
+    // 在调用线程上立即取出并导出全部事件
+    static void Flush();
+
+    static uint64_t NowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+private:
+    static std::atomic<bool> timing_enabled_;
+};
+
+class ScopedStageTimer {
+public:
+    explicit ScopedStageTimer(Stage stage)
+        : stage_(stage), start_(Instrumentation::TimingEnabled() ? Instrumentation::NowNs() : 0) {}
+    ~ScopedStageTimer() {
+        if (start_) Instrumentation::RecordStage(stage_, Instrumentation::NowNs() - start_);
+    }
+
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+private:
+    Stage stage_;
+    uint64_t start_;
+};
+
+#define CAMERA_TRACE_CONCAT_INNER(a, b) a##b
+#define CAMERA_TRACE_CONCAT(a, b) CAMERA_TRACE_CONCAT_INNER(a, b)
+
+#ifdef CAMERA_ENABLE_TRACE
+#define CAMERA_TRACE_STAGE(stage) \
+    ScopedStageTimer CAMERA_TRACE_CONCAT(camera_stage_timer_, __LINE__)(Stage::stage)
+#define CAMERA_COUNT(counter) Instrumentation::Count(Counter::counter)
+#define CAMERA_COUNT_N(counter, n) Instrumentation::Count(Counter::counter, (n))
+#define CAMERA_LOG(...) Instrumentation::Log(__VA_ARGS__)
+#else
+#define CAMERA_TRACE_STAGE(stage) ((void)0)
+#define CAMERA_COUNT(counter) ((void)0)
+#define CAMERA_COUNT_N(counter, n) ((void)0)
+#define CAMERA_LOG(...) ((void)0)
+#endif
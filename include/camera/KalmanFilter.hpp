@@ -0,0 +1,93 @@
+// KalmanFilter.hpp
+#pragma once
+#include <Eigen/Dense>
+#include "ConfigManager.hpp"
+
+// 编译期定维卡尔曼滤波器：N 为状态维数，M 为观测维数。
+// 全部使用定长 Eigen 矩阵，predict/update 不产生堆分配。
+template <int N, int M>
+class KalmanFilter {
+public:
+    using State = Eigen::Matrix<float, N, 1>;
+    using Measurement = Eigen::Matrix<float, M, 1>;
+    using StateMatrix = Eigen::Matrix<float, N, N>;
+    using ObservationMatrix = Eigen::Matrix<float, M, N>;
+    using MeasurementMatrix = Eigen::Matrix<float, M, M>;
+    using GainMatrix = Eigen::Matrix<float, N, M>;
+
+    KalmanFilter(
+        const State& initial_x,
+        const StateMatrix& F,
+        const ObservationMatrix& H,
+        const StateMatrix& P,
+        const StateMatrix& Q,
+        const MeasurementMatrix& R
+    ) : F_(F), H_(H), P_(P), Q_(Q), R_(R), x_(initial_x) {}
+
+    void predict() {
+        x_ = F_ * x_;
+        P_ = F_ * P_ * F_.transpose() + Q_;
+    }
+
+    void update(const Measurement& z) {
+        const MeasurementMatrix S = H_ * P_ * H_.transpose() + R_;
+        const GainMatrix K = P_ * H_.transpose() * S.inverse();
+        x_ += K * (z - H_ * x_);
+        P_ = (StateMatrix::Identity() - K * H_) * P_;
+    }
+
+    const State& state() const { return x_; }
+    const StateMatrix& covariance() const { return P_; }
+
+    // 变步长时由调用方更新转移矩阵和过程噪声
+    void setTransition(const StateMatrix& F) { F_ = F; }
+    void setProcessNoise(const StateMatrix& Q) { Q_ = Q; }
+    void setMeasurementNoise(const MeasurementMatrix& R) { R_ = R; }
+    void reset(const State& x, const StateMatrix& P) { x_ = x; P_ = P; }
+
+private:
+    StateMatrix F_;
+    ObservationMatrix H_;
+    StateMatrix P_;
+    StateMatrix Q_;
+    MeasurementMatrix R_;
+    State x_;
+};
+
+// 1x1 特化：随机游走模型（F = H = 1），退化为闭式标量运算
+template <>
+class KalmanFilter<1, 1> {
+public:
+    explicit KalmanFilter(
+        float initial_x,
+        const ConfigManager::Params::KalmanParams& params
+    );
+
+    float filterMeasurement(float measurement) {
+        predict();
+        update(measurement);
+        return x_;
+    }
+
+    void predict() {
+        P_ += Q_;
+    }
+
+    void update(float measurement) {
+        const float K = P_ / (P_ + R_);
+        x_ += K * (measurement - x_);
+        P_ = (1.0f - K) * P_;
+    }
+
+    float state() const { return x_; }
+    float covariance() const { return P_; }
+    void setProcessNoise(float Q) { Q_ = Q; }
+    void setMeasurementNoise(float R) { R_ = R; }
+    void reset(float x, float P) { x_ = x; P_ = P; }
+
+private:
+    float P_;
+    float Q_;
+    float R_;
+    float x_;
+};
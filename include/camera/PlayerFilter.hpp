@@ -0,0 +1,49 @@
+#pragma once
+#include "camera/ConfigManager.hpp"
+#include "camera/PlayerStats.hpp"
+#include "camera/Span.hpp"
+#include <cstddef>
+#include <vector>
+
+class StateReader;
+class StateWriter;
+
+// 统计前的球员检测预过滤（safety 参数）：
+//   1. 单帧中位数 / MAD 剔除离群检测（观众、替补席）；离中位数不超过 noise_threshold 的始终保留
+//   2. 幸存者均值相对上一次接受的均值跳变超过 noise_threshold 时先保持，连续若干帧仍如此才接受
+//   3. 幸存者少于 min_players 时保持上一帧位置
+// 中位数与 MAD 用 nth_element 在固定容量的暂存区上求得，O(n) 且每帧不分配。
+class PlayerFilter {
+public:
+    // 每帧最多处理的检测数，超出部分忽略
+    static constexpr size_t kDefaultCapacity = 256;
+
+    struct Result {
+        PlayerStats stats;   // 幸存者统计量，held 时无意义
+        Span<const float> survivors;   // 幸存者 x，指向内部暂存区，下一次 filter() 前有效
+        size_t rejected;     // 本帧被 MAD 剔除的检测数
+        bool held;           // 本帧应保持上一帧位置
+    };
+
+    explicit PlayerFilter(const ConfigManager::Params::SafetyParams& params,
+                          size_t capacity = kDefaultCapacity);
+
+    void configure(const ConfigManager::Params::SafetyParams& params) { params_ = params; }
+    void reset();
+
+    Result filter(Span<const Point> players);
+
+    // 只保存跳变参考，暂存区每帧重写无需保存
+    void saveState(StateWriter& out) const;
+    void loadState(StateReader& in);
+
+private:
+    ConfigManager::Params::SafetyParams params_;
+    std::vector<float> xs_;          // 本帧 x 坐标（nth_element 会重排）
+    std::vector<float> deviations_;  // |x - median|
+    std::vector<float> survivors_;
+
+    bool has_reference_ = false;
+    float reference_mean_ = 0.0f;    // 上一次接受的幸存者均值
+    int jump_frames_ = 0;            // 连续跳变帧数
+};
@@ -0,0 +1,27 @@
+#pragma once
+#include "camera/ConfigManager.hpp"
+#include <cstddef>
+
+// 单次遍历得到的球员 x 坐标统计量
+struct PlayerStats {
+    float sum;
+    float min;
+    float max;
+    size_t count;
+
+    float mean() const { return count ? sum / count : 0.0f; }
+};
+
+enum class SimdLevel { Scalar, SSE, AVX2 };
+
+// 运行时检测到的最高指令集（进程内只检测一次）
+SimdLevel DetectSimdLevel();
+
+// 求和固定按 8 路交错累加，再按固定顺序两两合并，最后顺序累加尾部元素；
+// 标量、SSE、AVX2 三条路径逐位一致。空输入返回 min=+inf, max=-inf。
+PlayerStats ReducePlayerX(const Point* points, size_t count);
+PlayerStats ReducePlayerX(const float* xs, size_t count);
+
+// 指定路径，供测试与基准对比；请求的指令集不可用时退回标量
+PlayerStats ReducePlayerX(const Point* points, size_t count, SimdLevel level);
+PlayerStats ReducePlayerX(const float* xs, size_t count, SimdLevel level);
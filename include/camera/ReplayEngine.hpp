@@ -0,0 +1,63 @@
+#pragma once
+#include "camera/ConfigManager.hpp"
+#include "camera/DetectionTrace.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 离线回放 / 参数扫描：同一段录制序列在多组参数下并行回放，输出逐帧轨迹。
+// 任务为 (配置, 分段) 对，每个工作线程有自己的任务队列，空闲时从其他线程队列尾部窃取；
+// 每个任务构造独立的 CameramanModel，绑定该配置的固定快照 ConfigManager。
+// 分段时每段先从段首向前 warmup_frames 帧开始回放以预热历史窗口与滤波器状态，预热帧不输出。
+
+// 参与回放的一组参数
+struct ReplayConfig {
+    std::string name;
+    std::shared_ptr<const ConfigManager::Params> params;
+};
+
+struct ReplayOptions {
+    size_t threads = 0;          // 0 表示 std::thread::hardware_concurrency()
+    size_t segment_frames = 0;   // 0 表示每个配置整场为一个任务，输出与逐帧顺序回放逐位一致
+    size_t warmup_frames = 300;  // 分段时每段向前重叠的预热帧数，预热后与整场结果只差浮点舍入量级
+    bool timestamps = false;     // 按录制的时间戳调用变帧率 predict()（丢帧、降帧率的录制）
+};
+
+// 列式结果：每列按 [配置][帧] 连续存放，便于按列载入分析工具。
+//
+// 二进制格式 CMRC（小端）：
+//   header  : "CMRC" | u32 version | u64 frame_count | u32 config_count | u32 column_count
+//   names   : config_count 个配置名，随后 column_count 个列名，每个为 { u32 长度 | 字节 }
+//   columns : column_count x config_count x frame_count 个 f32
+struct ReplayColumns {
+    enum Column : uint32_t {
+        Target,          // predict() 输出
+        RawTarget,       // 融合并裁剪后的原始目标
+        MeanPlayerPos,
+        BallX,
+        CameraY,         // transfer() 结果
+        Fov,
+        kColumnCount
+    };
+    static const char* ColumnName(Column column);
+
+    size_t frames = 0;
+    std::vector<std::string> configs;
+    std::vector<float> columns[kColumnCount];
+
+    float* column(Column c, size_t config) { return columns[c].data() + config * frames; }
+    const float* column(Column c, size_t config) const { return columns[c].data() + config * frames; }
+
+    void save(const std::string& path) const;
+    static ReplayColumns Load(const std::string& path);
+};
+
+// 配置列表为空或参数非法时抛出 std::invalid_argument，任一任务失败时重新抛出其异常
+ReplayColumns RunReplay(const DetectionTrace& trace,
+                        const std::vector<ReplayConfig>& configs,
+                        const ReplayOptions& options = ReplayOptions{});
+
+// 按配置文件中的路径修改单个数值参数（如 "camera.memory_length"、"kalman.slider.process_noise"），
+// 用于生成参数网格；未知路径抛出 std::invalid_argument
+void SetSweepParam(ConfigManager::Params& params, const std::string& key, double value);
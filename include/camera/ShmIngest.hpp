@@ -0,0 +1,60 @@
+#pragma once
+#include "camera/FramePipeline.hpp"
+#include "camera/ShmRing.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// 检测进程到相机进程的零拷贝接入：检测进程把 DetectionFrame 原地写进共享内存环的槽位，
+// 本进程直接以槽位内的数组作为 predict() 的输入视图，处理完才释放槽位；
+// 结果（target / y / fov）以 PtzCommand 写入第二个环，由云台控制进程读取。
+// 两个段都由本端创建（ShmMode::Create），对端在创建之后以 ShmMode::Open 打开。
+// 帧布局即 DetectionFrame / PtzCommand 的内存布局（小端，见下方 static_assert）。
+// 检测进程应在环满时丢弃新帧而不是等待；序号不连续的帧计入 sequence_gaps。
+class ShmIngest {
+public:
+    struct Options {
+        std::string detections = "/cameraman.detections";
+        std::string commands = "/cameraman.commands";
+        size_t detection_capacity = 64;   // 须为 2 的幂
+        size_t command_capacity = 64;     // 须为 2 的幂
+        uint32_t idle_spin = 256;         // run() 空闲时先自旋的次数，之后让出 CPU
+    };
+
+    // 只由调用 poll() / run() 的线程更新
+    struct Metrics {
+        uint64_t processed;          // 送入 predict 的帧数
+        uint64_t emitted;            // 写入输出环的指令数
+        uint64_t dropped_commands;   // 输出环满时丢弃的指令
+        uint64_t sequence_gaps;      // 检测进程丢掉（序号跳过）的帧数
+    };
+
+    // 创建两个共享内存段；model 只由处理线程访问
+    ShmIngest(CameramanModel& model, const Options& options);
+
+    ShmIngest(const ShmIngest&) = delete;
+    ShmIngest& operator=(const ShmIngest&) = delete;
+
+    // 处理输入环中当前所有帧，每帧输出一条指令；返回处理的帧数，不阻塞、不分配
+    size_t poll();
+    // 循环处理直到 stop 为 true，退出前排空输入环
+    void run(const std::atomic<bool>& stop);
+
+    const Metrics& metrics() const { return metrics_; }
+
+private:
+    CameramanModel& model_;
+    Options options_;
+    ShmRing<DetectionFrame> detections_;
+    ShmRing<PtzCommand> commands_;
+    Metrics metrics_{};
+    bool has_sequence_ = false;
+    uint64_t next_sequence_ = 0;
+};
+
+// 共享内存中的二进制布局由两端共同依赖，改动时须同步修改 ShmRingBase::kFormatVersion
+static_assert(std::is_trivially_copyable_v<DetectionFrame> && sizeof(DetectionFrame) ==
+              24 + (kMaxPlayersPerFrame + kMaxBallsPerFrame) * sizeof(Point),
+              "DetectionFrame layout is shared with the detector process");
+static_assert(std::is_trivially_copyable_v<PtzCommand> && sizeof(PtzCommand) == 40,
+              "PtzCommand layout is shared with the PTZ control process");
@@ -0,0 +1,119 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// 跨进程的单生产者单消费者环（POSIX 共享内存，/dev/shm 下的 name 段）。
+// 段布局（CMSR，小端，与进程无关）：
+//   header : "CMSR" | u32 version | u32 slot_size | u32 capacity | u32 ready
+//   head   : 独占一个缓存行的 u64，消费者已释放的槽位数
+//   tail   : 独占一个缓存行的 u64，生产者已提交的槽位数
+//   slots  : capacity 个 slot_size 字节的槽位，下标为计数按容量取低位
+// 槽位原地读写：生产者 acquire() 取得空槽位直接填写后 commit()，消费者 peek() 取得只读指针、
+// 用完后 release()。两端只通过原子量同步，热路径上没有系统调用，也不做序列化。
+// 与 SpscRing 一样，各端在本进程内缓存对端下标，只有看似满/空时才读取共享的对端原子量。
+enum class ShmMode {
+    Create,   // 删除同名旧段后新建并初始化，析构时删除段
+    Open      // 打开对端已创建并初始化的段
+};
+
+class ShmRingBase {
+public:
+    static constexpr uint32_t kFormatVersion = 1;
+
+    ShmRingBase(const ShmRingBase&) = delete;
+    ShmRingBase& operator=(const ShmRingBase&) = delete;
+
+    size_t capacity() const { return mask_ + 1; }
+    const std::string& name() const { return name_; }
+
+    // 近似深度，任意一端可读
+    size_t size() const {
+        return static_cast<size_t>(tail_->load(std::memory_order_acquire) -
+                                   head_->load(std::memory_order_acquire));
+    }
+
+protected:
+    // Create 时 capacity 须为 2 的幂；Open 时 capacity 取自段头，slot_size 须与段头一致。
+    // 名称不合法、段不存在或尚未初始化、格式不符时抛出 std::runtime_error
+    ShmRingBase(const std::string& name, ShmMode mode, size_t slot_size, size_t capacity);
+    ~ShmRingBase();
+
+    uint8_t* slot(uint64_t index) const { return slots_ + (index & mask_) * slot_size_; }
+
+    // 生产者：下一个空槽位，满时返回 nullptr
+    uint8_t* acquireSlot() {
+        const uint64_t tail = tail_->load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_->load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) return nullptr;
+        }
+        return slot(tail);
+    }
+    void commitSlot() {
+        tail_->store(tail_->load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // 消费者：最旧的已提交槽位，空时返回 nullptr
+    const uint8_t* peekSlot() {
+        const uint64_t head = head_->load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_->load(std::memory_order_acquire);
+            if (head == cached_tail_) return nullptr;
+        }
+        return slot(head);
+    }
+    void releaseSlot() {
+        head_->store(head_->load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+private:
+    std::string name_;
+    bool owner_ = false;
+    size_t mapped_size_ = 0;
+    void* mapping_ = nullptr;
+    std::atomic<uint64_t>* head_ = nullptr;
+    std::atomic<uint64_t>* tail_ = nullptr;
+    uint8_t* slots_ = nullptr;
+    size_t slot_size_ = 0;
+    uint64_t mask_ = 0;
+    uint64_t cached_head_ = 0;   // 生产者私有
+    uint64_t cached_tail_ = 0;   // 消费者私有
+};
+
+// 槽位类型须可平凡复制（两端按字节共享同一布局）。
+// 每个段只允许一个生产者进程/线程和一个消费者进程/线程
+template <typename T>
+class ShmRing : public ShmRingBase {
+    static_assert(std::is_trivially_copyable_v<T>, "ShmRing slots must be trivially copyable");
+
+public:
+    ShmRing(const std::string& name, ShmMode mode, size_t capacity = 0)
+        : ShmRingBase(name, mode, sizeof(T), capacity) {}
+
+    // 生产者：原地填写 acquire() 返回的槽位后 commit()；环满时返回 nullptr
+    T* acquire() { return reinterpret_cast<T*>(acquireSlot()); }
+    void commit() { commitSlot(); }
+
+    bool tryPush(const T& value) {
+        T* slot = acquire();
+        if (!slot) return false;
+        *slot = value;
+        commit();
+        return true;
+    }
+
+    // 消费者：peek() 返回的指针在 release() 之前有效，生产者不会改写该槽位；环空时返回 nullptr
+    const T* peek() { return reinterpret_cast<const T*>(peekSlot()); }
+    void release() { releaseSlot(); }
+
+    bool tryPop(T& value) {
+        const T* slot = peek();
+        if (!slot) return false;
+        value = *slot;
+        release();
+        return true;
+    }
+};
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class StateReader;
+class StateWriter;
+
+// 固定容量的环形历史窗口。
+// 入队 O(1)，增量维护窗口均值、首尾差，以及单调队列实现的滑动最小/最大值；
+// reset() 之后不再分配内存，长时间直播内存保持恒定。
+// 两种淘汰方式：按样本数（容量满时淘汰最旧样本），或按时间（带时间戳入队，
+// 淘汰与最新样本相距达到 horizon 的样本，至少保留两个样本；容量满时同样淘汰最旧样本）。
+// 环形下标以比较回绕代替取模。
+class SlidingWindow {
+public:
+    SlidingWindow() = default;
+
+    // 按样本数：分配容量并用 initial 填满窗口
+    void reset(size_t capacity, float initial);
+    // 按时间：分配容量，窗口只含 timestamp_us 时刻的一个 initial 样本
+    void reset(size_t capacity, float initial, uint64_t horizon_us, uint64_t timestamp_us);
+
+    void push(float value);
+    // 按时间模式入队，时间戳须单调不减
+    void push(float value, uint64_t timestamp_us);
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return values_.size(); }
+    bool empty() const { return size_ == 0; }
+    bool timed() const { return horizon_us_ != 0; }
+    uint64_t horizonUs() const { return horizon_us_; }
+
+    float front() const;   // 窗口内最旧的值
+    float back() const;    // 最新的值，空窗口返回 0
+    float span() const { return back() - front(); }  // 逐帧差分之和的闭式结果
+    // 最旧与最新样本的时间差（微秒），按样本数模式下为 0
+    uint64_t duration() const;
+    float mean() const;
+    float min() const;
+    float max() const;
+
+    // 完整保存环、时间戳、累计和与单调队列，恢复后后续输出逐位一致。
+    // 容量与快照相同时 loadState() 不分配
+    void saveState(StateWriter& out) const;
+    void loadState(StateReader& in);
+
+private:
+    // 单调队列：保存样本所在槽位，按值单调排列
+    struct MonotonicQueue {
+        std::vector<uint32_t> slots;
+        size_t head = 0;
+        size_t size = 0;
+
+        void reset(size_t capacity);
+        uint32_t front() const { return slots[head]; }
+        uint32_t back() const { return slots[wrap(head + size - 1)]; }
+        void popFront() { head = wrap(head + 1); --size; }
+        void popBack() { --size; }
+        void pushBack(uint32_t slot) { slots[wrap(head + size)] = slot; ++size; }
+        // 下标最多越过末尾一圈
+        size_t wrap(size_t i) const { return i < slots.size() ? i : i - slots.size(); }
+    };
+
+    size_t wrap(size_t i) const { return i < values_.size() ? i : i - values_.size(); }
+    size_t newest() const { return wrap(head_ + size_ - 1); }
+    void append(float value);
+    void popOldest();
+    void recomputeSum();
+
+    std::vector<float> values_;
+    std::vector<uint64_t> times_;   // 按时间模式下各槽位的时间戳
+    uint64_t horizon_us_ = 0;       // 0 表示按样本数淘汰
+    size_t head_ = 0;               // 最旧样本所在槽位
+    size_t size_ = 0;
+    size_t pushes_since_sum_ = 0;   // 距上次整体重新求和的入队次数
+    double sum_ = 0.0;
+    MonotonicQueue min_queue_;
+    MonotonicQueue max_queue_;
+};
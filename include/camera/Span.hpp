@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+// 非拥有的连续内存视图（C++17 下 std::span 的最小替代），调用期间数据须保持有效
+template <typename T>
+class Span {
+public:
+    constexpr Span() = default;
+    constexpr Span(T* data, size_t size) : data_(data), size_(size) {}
+
+    template <typename U,
+              typename = std::enable_if_t<std::is_same_v<std::remove_const_t<T>, U>>>
+    Span(const std::vector<U>& v) : data_(v.data()), size_(v.size()) {}
+
+    constexpr T* data() const { return data_; }
+    constexpr size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+    constexpr T& operator[](size_t i) const { return data_[i]; }
+    constexpr T* begin() const { return data_; }
+    constexpr T* end() const { return data_ + size_; }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
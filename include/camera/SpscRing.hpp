@@ -0,0 +1,51 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// 单生产者单消费者无锁环形队列，容量须为 2 的幂。
+// 生产端与消费端各自缓存对端索引，只有在看似满/空时才读取对端原子量。
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+
+public:
+    // 仅生产者线程调用；队列满时返回 false
+    bool tryPush(const T& value) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == Capacity) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == Capacity) return false;
+        }
+        slots_[tail & (Capacity - 1)] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 仅消费者线程调用；队列空时返回 false
+    bool tryPop(T& value) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) return false;
+        }
+        value = slots_[head & (Capacity - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 近似深度，任意线程可读
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    alignas(64) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0;     // 消费者私有
+    alignas(64) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;     // 生产者私有
+    alignas(64) std::array<T, Capacity> slots_{};
+};
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// 模型状态快照的字节序列化：按调用顺序平铺写入，读取顺序须与写入一致。
+// 仅在同一平台的构建之间交换（与 ConfigBlob 相同的约束）。
+// StateWriter 复用调用方的缓冲区，容量足够后写入不再分配。
+class StateWriter {
+public:
+    explicit StateWriter(std::vector<uint8_t>& out) : out_(out) { out_.clear(); }
+
+    template <typename T>
+    void put(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "put() requires a trivially copyable type");
+        putBytes(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void putArray(const T* values, size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "putArray() requires a trivially copyable type");
+        putBytes(values, sizeof(T) * count);
+    }
+
+    // 定长 Eigen 矩阵按列主序写出全部系数
+    template <typename Matrix>
+    void putMatrix(const Matrix& m) {
+        putArray(m.data(), static_cast<size_t>(m.size()));
+    }
+
+    void putBytes(const void* src, size_t bytes) {
+        const size_t pos = out_.size();
+        out_.resize(pos + bytes);
+        if (bytes) std::memcpy(out_.data() + pos, src, bytes);
+    }
+
+private:
+    std::vector<uint8_t>& out_;
+};
+
+// 越界读取抛出 std::runtime_error
+class StateReader {
+public:
+    StateReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    template <typename T>
+    T get() {
+        static_assert(std::is_trivially_copyable_v<T>, "get() requires a trivially copyable type");
+        T value;
+        getBytes(&value, sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void getArray(T* values, size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "getArray() requires a trivially copyable type");
+        getBytes(values, sizeof(T) * count);
+    }
+
+    template <typename Matrix>
+    void getMatrix(Matrix& m) {
+        getArray(m.data(), static_cast<size_t>(m.size()));
+    }
+
+    void getBytes(void* dst, size_t bytes) {
+        if (bytes > size_ - pos_) {
+            throw std::runtime_error("State snapshot truncated");
+        }
+        if (bytes) std::memcpy(dst, data_ + pos_, bytes);
+        pos_ += bytes;
+    }
+
+    size_t remaining() const { return size_ - pos_; }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_ = 0;
+};
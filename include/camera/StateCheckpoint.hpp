@@ -0,0 +1,45 @@
+#pragma once
+#include "camera/Span.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 模型状态快照的内存映射检查点（CMSK）。path 可以是普通文件，也可以是 /dev/shm 下的共享内存段。
+// 文件内有两个槽位，write() 轮流覆盖较旧的一个，每个槽位带序号（seqlock）与 FNV-1a 校验和：
+// 写入进程在写一半时崩溃，另一个槽位仍保存着上一次完整的快照。
+// 只允许一个写入进程；读取进程可以同时存在，读到正在改写的槽位时重试。
+// write() 只做一次 memcpy 与校验和计算，不 msync：进程崩溃时页缓存中的数据仍在，
+// 整机掉电不在此机制的保护范围内。
+class StateCheckpoint {
+public:
+    static constexpr uint32_t kFormatVersion = 1;
+
+    // 打开或创建检查点文件，capacity 为单个快照的最大字节数。
+    // 已有文件的格式版本或容量不符时抛出 std::runtime_error
+    StateCheckpoint(const std::string& path, size_t capacity);
+    ~StateCheckpoint();
+
+    StateCheckpoint(const StateCheckpoint&) = delete;
+    StateCheckpoint& operator=(const StateCheckpoint&) = delete;
+
+    // 快照超过容量时抛出 std::invalid_argument；不产生堆分配
+    void write(Span<const uint8_t> state);
+    // 取出序号最大且校验通过的快照；没有可用快照时返回 false。out 容量足够后不再分配
+    bool read(std::vector<uint8_t>& out) const;
+
+    // 最近一次完整写入的序号，尚未写入时为 0
+    uint64_t sequence() const;
+    size_t capacity() const { return capacity_; }
+
+private:
+    struct Slot;
+    Slot* slot(size_t index) const;
+
+    size_t capacity_;
+    size_t slot_stride_;
+    size_t mapped_size_ = 0;
+    int fd_ = -1;
+    char* data_ = nullptr;
+    uint64_t next_sequence_ = 1;
+};
@@ -0,0 +1,167 @@
+#pragma once
+#include "camera/BallTracker.hpp"
+#include "camera/ConfigManager.hpp"
+#include "camera/CourtIndex.hpp"
+#include "camera/DensityFocus.hpp"
+#include "camera/PlayerFilter.hpp"
+#include "camera/Span.hpp"
+#include "camera/TargetFilter.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+// 固定部署配置的编译期特化模型。Profile 以静态 constexpr 成员给出完整配置
+// （由 tools/config_codegen 从 camera_config.json 生成，见 CMake 目标 camera_model_static）：
+//   kBase, kSlider (KalmanParams)    kCamera (CameraParams)     kSafety (SafetyParams)
+//   kBallTracker, kTargetFilter, kFocus                          kTransfer, kTransferMode, kLutSize
+//   kCourt (Point 数组)
+// 记忆窗口为编译期容量的 std::array，memory_length * fps、speed_max、buffer_pixels、
+// position_merge_ratio 与 slider 滤波的噪声参数都是常量，slider 滤波内联展开；
+// 剔除、球跟踪、目标滤波与密度焦点沿用与运行时模型相同的组件。
+// 只支持固定帧率 predict，不监视配置、不记录调试信息与埋点；
+// 对同一输入与 CameramanModel（以 MakeParams() 构造的配置）的输出逐位一致。
+template <typename Profile>
+class StaticCameramanModel {
+public:
+    static constexpr ConfigManager::Params::CameraParams kCamera = Profile::kCamera;
+    static constexpr size_t kHistorySize = static_cast<size_t>(kCamera.memory_length * kCamera.fps);
+    static_assert(kHistorySize > 0, "memory_length * fps must be at least one frame");
+    static_assert(kCamera.speed_max > 0.0f, "speed_max must be positive");
+    static constexpr bool kDensityFocus =
+        Profile::kFocus.mode == ConfigManager::Params::FocusParams::Mode::Density;
+
+    // 与 Profile 等价的运行时配置，用于构造共享组件，以及对照运行时模型
+    static ConfigManager::Params MakeParams() {
+        ConfigManager::Params params{};
+        params.base = Profile::kBase;
+        params.slider = Profile::kSlider;
+        params.camera = Profile::kCamera;
+        params.safety = Profile::kSafety;
+        params.ball_tracker = Profile::kBallTracker;
+        params.target_filter = Profile::kTargetFilter;
+        params.focus = Profile::kFocus;
+        params.transfer.x_min = Profile::kTransfer.x_min;
+        params.transfer.x_max = Profile::kTransfer.x_max;
+        params.transfer.y_min = Profile::kTransfer.y_min;
+        params.transfer.y_max = Profile::kTransfer.y_max;
+        params.transfer.fov_min = Profile::kTransfer.fov_min;
+        params.transfer.fov_max = Profile::kTransfer.fov_max;
+        params.transfer.curve.build(Profile::kTransferMode, Profile::kTransfer, Profile::kLutSize);
+        params.court_points.assign(std::begin(Profile::kCourt), std::end(Profile::kCourt));
+        return params;
+    }
+
+    StaticCameramanModel()
+        : StaticCameramanModel(MakeParams()) {}
+
+    float predict(Span<const Point> players, Span<const Point> balls);
+
+    std::tuple<float, float> transfer(float x) const { return curve_.evaluate(x); }
+    void transferMany(Span<const float> xs, float* ys, float* fovs) const {
+        curve_.evaluateMany(xs, ys, fovs);
+    }
+
+private:
+    static constexpr float kDt = 1.0f / static_cast<float>(kCamera.fps);
+    static constexpr float kSliderQ = Profile::kSlider.process_noise;
+    static constexpr float kSliderR = Profile::kSlider.variance_measurement;
+    static constexpr float kMergeRatio = kCamera.position_merge_ratio;
+    static constexpr float kBallRatio = 1 - kMergeRatio;
+
+    explicit StaticCameramanModel(const ConfigManager::Params& params)
+        : player_filter_(params.safety),
+          ball_tracker_(params.ball_tracker, params.camera.fps),
+          target_filter_(params),
+          curve_(params.transfer.curve),
+          court_players_(PlayerFilter::kDefaultCapacity),
+          court_balls_(PlayerFilter::kDefaultCapacity) {
+        if (!params.court_points.empty()) {
+            court_.build(params.court_points, static_cast<float>(params.safety.boundary_margin));
+            ball_court_.build(params.court_points, static_cast<float>(params.safety.boundary_margin),
+                              static_cast<float>(params.safety.ball_loft_margin));
+        }
+        if constexpr (kDensityFocus) {
+            focus_.configure(params.focus, court_.left(), court_.right());
+            focus_.reset(kHistorySize);
+        }
+    }
+
+    // 记忆窗口：按样本数淘汰的定长环，只需要首尾两个样本
+    float back() const { return initialized_ ? history_[newest_] : 0.0f; }
+    float front() const { return history_[newest_ + 1 == kHistorySize ? 0 : newest_ + 1]; }
+    void push(float value) {
+        newest_ = newest_ + 1 == kHistorySize ? 0 : newest_ + 1;
+        history_[newest_] = value;
+    }
+
+    std::array<float, kHistorySize> history_{};
+    size_t newest_ = kHistorySize - 1;
+
+    // slider 随机游走滤波，噪声参数为常量
+    float slider_x_ = 0.5f;
+    float slider_p_ = Profile::kSlider.variance_position;
+
+    PlayerFilter player_filter_;
+    BallTracker ball_tracker_;
+    TargetFilter target_filter_;
+    DensityFocus focus_;
+    TransferCurve curve_;
+    CourtIndex court_;
+    CourtIndex ball_court_;
+    std::vector<Point> court_players_;
+    std::vector<Point> court_balls_;
+    bool initialized_ = false;
+};
+
+template <typename Profile>
+float StaticCameramanModel<Profile>::predict(Span<const Point> players, Span<const Point> balls) {
+    // 首帧为初始化窗口所用的位置
+    float last_pos = back();
+
+    if (!court_.empty()) {
+        const size_t num_players = std::min(players.size(), court_players_.size());
+        const size_t num_balls = std::min(balls.size(), court_balls_.size());
+        players = Span<const Point>(court_players_.data(),
+                                    court_.filter(players, court_players_.data(), num_players));
+        balls = Span<const Point>(court_balls_.data(),
+                                  ball_court_.filter(balls, court_balls_.data(), num_balls));
+    }
+
+    const PlayerFilter::Result filtered = player_filter_.filter(players);
+
+    if (!initialized_) {
+        history_.fill(!filtered.held ? filtered.stats.mean()
+                      : players.empty() ? last_pos : players[0].x);
+        initialized_ = true;
+        last_pos = back();
+    }
+
+    const float mean_pos = filtered.held ? last_pos : filtered.stats.mean();
+    push(mean_pos);
+
+    float focus_x = mean_pos;
+    if constexpr (kDensityFocus) {
+        focus_.push(filtered.held ? Span<const float>() : filtered.survivors);
+        if (!focus_.locate(mean_pos, focus_x)) focus_x = mean_pos;
+    }
+
+    float ball_x;
+    if (!ball_tracker_.update(balls, mean_pos, ball_x, kDt)) ball_x = last_pos;
+
+    // 窗口内逐帧差分之和等于首尾差
+    const float speed = std::clamp((back() - front()) * kCamera.fps, -kCamera.speed_max, kCamera.speed_max);
+    const float slider = 0.5f * (speed / kCamera.speed_max + 1.0f);
+    slider_p_ += kSliderQ;
+    const float gain = slider_p_ / (slider_p_ + kSliderR);
+    slider_x_ += gain * (slider - slider_x_);
+    slider_p_ = (1.0f - gain) * slider_p_;
+
+    const float min_target = court_.left() - kCamera.buffer_pixels;
+    const float max_target = court_.right() + kCamera.buffer_pixels;
+    const float merged = kMergeRatio * focus_x + kBallRatio * ball_x;
+    const float raw_target = std::clamp(merged, min_target, max_target);
+    return std::clamp(target_filter_.update(raw_target, kDt), min_target, max_target);
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "camera/ConfigManager.hpp"
+#include "camera/KalmanFilter.hpp"
+
+class StateReader;
+class StateWriter;
+
+// 目标 x 的运动模型滤波：常速度 [x, v] 或常加速度 [x, v, a]，均为定长 Eigen 矩阵，
+// 每帧不分配。输出按估计运动向前外推 lead_ms，抵消检测与云台的固定延迟，快攻时镜头不再落后。
+// 模型为 Off 时原样返回测量值。
+class TargetFilter {
+public:
+    using Model = ConfigManager::Params::TargetFilterParams::Model;
+
+    explicit TargetFilter(const ConfigManager::Params& params);
+
+    // 配置变化时更新模型与噪声；模型改变时重置状态
+    void configure(const ConfigManager::Params& params);
+    void reset();
+
+    // 输入本帧原始目标，返回滤波并外推后的目标；时间步长为 1/fps
+    float update(float measurement);
+    // 变帧率：dt 为距上一帧的实际秒数，转移矩阵与过程噪声按 dt 重新离散化
+    float update(float measurement, float dt);
+
+    Model model() const { return model_; }
+    float position() const;
+    float velocity() const;
+    float acceleration() const;
+
+    // 保存两个模型的状态与协方差；快照中的模型与当前配置不同时恢复后重新初始化
+    void saveState(StateWriter& out) const;
+    void loadState(StateReader& in);
+
+private:
+    void setTimeStep(float dt);
+
+    using CV = KalmanFilter<2, 1>;
+    using CA = KalmanFilter<3, 1>;
+
+    Model model_ = Model::Off;
+    bool initialized_ = false;
+    float lead_s_ = 0.0f;
+    float last_measurement_ = 0.0f;
+    float q_ = 0.0f;              // 过程噪声谱密度
+    float nominal_dt_ = 0.0f;     // 1/fps
+    float dt_ = 0.0f;             // 当前转移矩阵对应的步长
+
+    CV::StateMatrix cv_P0_;
+    CA::StateMatrix ca_P0_;
+    CV cv_;
+    CA ca_;
+};
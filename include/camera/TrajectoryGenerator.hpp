@@ -0,0 +1,152 @@
+#pragma once
+#include "camera/BoundedQueue.hpp"
+#include "camera/ConfigManager.hpp"
+#include "camera/FramePipeline.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// 检测帧给出的一组目标（x、云台 y、fov）
+struct Setpoint {
+    uint64_t time_ns;     // Instrumentation::NowNs() 时基
+    float x;
+    float y;
+    float fov;
+};
+
+// 控制频率上的一个采样点
+struct TrajectorySample {
+    uint64_t time_ns;
+    float x, y, fov;
+    float x_velocity, y_velocity, fov_velocity;   // 每秒变化量，速度模式的云台可直接使用
+};
+
+// 把每帧一次的目标变成速度、加速度与加加速度都受限的连续轨迹，可按任意控制频率采样。
+// 每个轴是三阶积分器上的级联比例控制（位置 -> 速度 -> 加速度 -> 加加速度），
+// 三个时间常数取 9:3:1，闭环为三重实极点，不振荡；各级输出按限值截断，限值是硬约束。
+// 两帧之间按前后两个目标的差分速度前馈外推（最多 max_lead），匀速运动时跟踪无滞后。
+// sample() 的积分步数有上界，单次为 O(1)，不分配内存；只在一个线程内使用。
+class TrajectoryGenerator {
+public:
+    struct AxisLimits {
+        float velocity;       // 每秒
+        float acceleration;   // 每秒²
+        float jerk;           // 每秒³
+    };
+
+    struct Limits {
+        AxisLimits x, y, fov;
+    };
+
+    struct Options {
+        float accel_time = 0.3f;      // 由静止加速到最大速度的时间（秒）
+        float jerk_time = 0.1f;       // 加速度由 0 增加到最大值的时间（秒）
+        float response_time = 0.3f;   // 位置环时间常数（秒），越小跟得越紧
+        float max_lead = 0.1f;        // 两帧之间前馈外推的最长时间（秒）
+    };
+
+    // 由配置推导限值：x 的最大速度为 speed_max × speed_slider_gain（像素/秒），
+    // 加速度与加加速度按 accel_time / jerk_time 折算；y、fov 的限值为 x 的限值乘以
+    // transfer 曲线的最大斜率，跟随 x 运动时不会先于 x 触限。
+    // 参数非法时抛出 std::invalid_argument
+    static Limits DeriveLimits(const ConfigManager::Params& params, const Options& options);
+
+    TrajectoryGenerator(const Limits& limits, const Options& options);
+    TrajectoryGenerator(const ConfigManager::Params& params, const Options& options);
+
+    // 更新目标；首个目标直接作为起点（速度、加速度为 0）。先按旧目标推进到 setpoint.time_ns，
+    // 目标时刻不早于上一次采样时，轨迹与采样频率无关。时间早于上一目标时不更新前馈速度
+    void setTarget(const Setpoint& setpoint);
+    // 推进到 time_ns 并输出；尚无目标时返回 false。时间倒退时不推进，
+    // 单次推进最多 kMaxElapsedS，更长的间隔（如线程被挂起）按该上限处理
+    bool sample(uint64_t time_ns, TrajectorySample& out);
+    void reset();
+
+    bool initialized() const { return initialized_; }
+    const Limits& limits() const { return limits_; }
+
+    static constexpr float kMaxElapsedS = 0.1f;
+
+private:
+    struct Axis {
+        float target = 0.0f;
+        float target_velocity = 0.0f;   // 前馈
+        float position = 0.0f;
+        float velocity = 0.0f;
+        float acceleration = 0.0f;
+    };
+
+    void advance(uint64_t time_ns);
+    void step(Axis& axis, const AxisLimits& limits, float lead, float h) const;
+
+    Limits limits_;
+    Options options_;
+    float tau_a_, tau_v_, tau_p_;   // 加速度、速度、位置环的时间常数
+    float max_step_;                // 显式积分的最大步长
+
+    Axis x_, y_, fov_;
+    bool initialized_ = false;
+    uint64_t target_ns_ = 0;        // 当前目标的时刻
+    uint64_t time_ns_ = 0;          // 已积分到的时刻
+};
+
+// 独立的控制线程：按固定频率采样 TrajectoryGenerator，检测帧率与控制频率解耦。
+// 目标经有界无锁队列送入（submit() 永不阻塞，积压时只取最新），采样点写入输出队列，
+// 消费端过慢时淘汰最旧采样。线程按绝对时刻睡眠，错过的节拍不补发；运行期间不分配内存。
+class ControlLoop {
+public:
+    struct Options {
+        double rate_hz = 200.0;
+        int cpu = -1;                    // >= 0 时把控制线程绑定到该 CPU
+        int rt_priority = 0;             // > 0 时以 SCHED_FIFO 的该优先级运行（需要相应权限）
+        size_t setpoint_capacity = 8;
+        size_t output_capacity = 256;
+        TrajectoryGenerator::Options trajectory;
+    };
+
+    struct Metrics {
+        uint64_t setpoints;              // 收到的目标数
+        uint64_t samples;                // 输出的采样点
+        uint64_t dropped_samples;        // 输出队列满时丢弃的旧采样
+        uint64_t missed_ticks;           // 超过一个周期未能按时运行而跳过的节拍
+        uint64_t max_lateness_ns;        // 节拍实际运行时刻晚于计划时刻的最大值
+    };
+
+    // 参数非法时抛出 std::invalid_argument
+    ControlLoop(const TrajectoryGenerator::Limits& limits, const Options& options);
+    ControlLoop(const ConfigManager::Params& params, const Options& options);
+    ~ControlLoop();
+
+    ControlLoop(const ControlLoop&) = delete;
+    ControlLoop& operator=(const ControlLoop&) = delete;
+
+    void start();
+    void stop();
+
+    // 任意一个生产者线程调用，永不阻塞；队列满时淘汰最旧目标
+    void submit(const Setpoint& setpoint);
+    // FramePipeline 的输出指令；以指令产生时刻作为目标时刻
+    void submit(const PtzCommand& command);
+    // 消费者线程调用；无采样时返回 false
+    bool poll(TrajectorySample& sample);
+
+    Metrics metrics() const;
+
+private:
+    void run();
+    void emit(const TrajectorySample& sample);
+
+    TrajectoryGenerator generator_;   // 只由控制线程访问
+    Options options_;
+    uint64_t period_ns_;
+    BoundedQueue<Setpoint> setpoints_;
+    BoundedQueue<TrajectorySample> output_;
+    std::thread worker_;
+    std::atomic<bool> running_{false};
+
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> samples_{0};
+    std::atomic<uint64_t> dropped_samples_{0};
+    std::atomic<uint64_t> missed_ticks_{0};
+    std::atomic<uint64_t> max_lateness_ns_{0};
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include "camera/Span.hpp"
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// x 坐标到云台 y / fov 的映射曲线。曲线只由 transfer 配置决定，加载配置时预先构建，
+// 帧路径按所选模式求值：
+//   Exact      原始公式（两次 pow + 除法），结果与历史版本逐位一致
+//   Lut        归一化坐标上的等距查找表 + 线性插值
+//   Polynomial 归一化坐标上的二次多项式（Horner 求值），系数由原始曲线在 0/0.5/1 三点插值得到
+class TransferCurve {
+public:
+    enum class Mode { Exact, Lut, Polynomial };
+
+    struct Range {
+        float x_min, x_max;
+        float y_min, y_max;
+        float fov_min, fov_max;
+    };
+
+    static constexpr size_t kDefaultLutSize = 256;
+
+    // "exact" / "lut" / "polynomial"，未知名称抛出 std::invalid_argument
+    static Mode ParseMode(const std::string& name);
+
+    // 配置加载时调用，Lut 模式在此分配查找表；lut_size 至少为 2
+    void build(Mode mode, const Range& range, size_t lut_size = kDefaultLutSize);
+
+    Mode mode() const { return mode_; }
+    const Range& range() const { return range_; }
+    size_t lutSize() const { return y_lut_.empty() ? kDefaultLutSize : y_lut_.size(); }
+
+    std::tuple<float, float> evaluate(float x) const {
+        float y, fov;
+        evaluateOne(x, y, fov);
+        return {y, fov};
+    }
+
+    // 批量求值，ys / fovs 至少容纳 xs.size() 个元素；结果与逐个调用 evaluate() 逐位一致
+    void evaluateMany(Span<const float> xs, float* ys, float* fovs) const;
+
+private:
+    void evaluateOne(float x, float& y, float& fov) const;
+
+    float normalize(float x) const {
+        float norm = (x - range_.x_min) / (range_.x_max - range_.x_min);
+        return norm < 0.0f ? 0.0f : (norm > 1.0f ? 1.0f : norm);
+    }
+
+    Mode mode_ = Mode::Exact;
+    Range range_{0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+
+    // Polynomial：y = c0 + c1*n + c2*n^2
+    float y_coef_[3] = {0.0f, 0.0f, 0.0f};
+    float fov_coef_[3] = {0.0f, 0.0f, 0.0f};
+
+    // Lut：lut_size 个等距采样点，步长 1/(lut_size-1)
+    std::vector<float> y_lut_;
+    std::vector<float> fov_lut_;
+    float lut_scale_ = 0.0f;
+};
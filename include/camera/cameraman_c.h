@@ -0,0 +1,87 @@
+/*
+ * CameramanModel 的稳定 C ABI（libcameraman_c），供 Python 等外部工具批量调用。
+ *
+ * - 句柄不透明，每个句柄拥有独立的配置快照与模型，不同句柄可在不同线程并发使用，
+ *   同一句柄同一时刻只能由一个线程调用。
+ * - 所有函数不抛出异常，返回 cameraman_status；失败时 cameraman_last_error() 给出本线程最近一次的错误信息。
+ * - 点坐标为连续的 float 对 (x0, y0, x1, y1, ...)；各帧的点按偏移数组划分（CSR）：
+ *   第 f 帧为 points[offsets[f] .. offsets[f + 1])，offsets 长度为 frames + 1。
+ *   调用期间只读取调用方的缓冲区，不复制、不保留指针。
+ * - 只追加、不修改已有函数；不兼容的改动递增 CAMERAMAN_ABI_VERSION。
+ */
+#ifndef CAMERAMAN_C_H
+#define CAMERAMAN_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CAMERAMAN_ABI_VERSION 1
+
+#if defined(__GNUC__)
+#define CAMERAMAN_API __attribute__((visibility("default")))
+#else
+#define CAMERAMAN_API
+#endif
+
+typedef struct cameraman_model cameraman_model;
+
+typedef enum cameraman_status {
+    CAMERAMAN_OK = 0,
+    CAMERAMAN_INVALID_ARGUMENT = 1,   /* 空指针、偏移数组不单调等 */
+    CAMERAMAN_BUFFER_TOO_SMALL = 2,   /* 输出缓冲区不足，所需大小已写回 */
+    CAMERAMAN_RUNTIME_ERROR = 3       /* 配置加载失败、快照损坏等 */
+} cameraman_status;
+
+/* 运行时库的 ABI 版本，与头文件的 CAMERAMAN_ABI_VERSION 不同时不应继续使用 */
+CAMERAMAN_API uint32_t cameraman_abi_version(void);
+
+/* 本线程最近一次失败的错误信息，没有时为空串；指针在本线程下一次调用前有效 */
+CAMERAMAN_API const char* cameraman_last_error(void);
+
+/* 加载配置文件（不监视文件变化）并以其中的球场构造模型 */
+CAMERAMAN_API cameraman_status cameraman_create(const char* config_path, cameraman_model** out);
+CAMERAMAN_API void cameraman_destroy(cameraman_model* model);
+
+/* 单帧：players / balls 各为 num_* 个点 */
+CAMERAMAN_API cameraman_status cameraman_predict(cameraman_model* model,
+                                                 const float* players, size_t num_players,
+                                                 const float* balls, size_t num_balls,
+                                                 float* target);
+
+/*
+ * 整段序列一次调用：逐帧 predict，第 f 帧的输出目标写入 targets[f]。
+ * timestamps_us 为 NULL 时按固定帧率处理，否则为每帧采集时刻（微秒），走变帧率路径。
+ * 中途失败时已处理的帧保持已推进的模型状态。
+ */
+CAMERAMAN_API cameraman_status cameraman_predict_batch(cameraman_model* model, size_t frames,
+                                                       const float* players,
+                                                       const uint64_t* player_offsets,
+                                                       const float* balls,
+                                                       const uint64_t* ball_offsets,
+                                                       const uint64_t* timestamps_us,
+                                                       float* targets);
+
+/* 批量映射：ys[i], fovs[i] = transfer(xs[i]) */
+CAMERAMAN_API cameraman_status cameraman_transfer_many(const cameraman_model* model,
+                                                       const float* xs, size_t count,
+                                                       float* ys, float* fovs);
+
+/*
+ * 状态快照（与 CameramanModel::saveState 相同的格式）。
+ * 写入 buffer 并把实际字节数写回 *size；capacity 不足时返回 CAMERAMAN_BUFFER_TOO_SMALL，
+ * *size 为所需字节数。buffer 可为 NULL 以只查询大小。
+ */
+CAMERAMAN_API cameraman_status cameraman_save_state(cameraman_model* model, uint8_t* buffer,
+                                                    size_t capacity, size_t* size);
+CAMERAMAN_API cameraman_status cameraman_restore_state(cameraman_model* model,
+                                                       const uint8_t* state, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CAMERAMAN_C_H */
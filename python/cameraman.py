@@ -0,0 +1,182 @@
+"""libcameraman_c 的 Python 绑定（ctypes + numpy）。
+
+整场检测一次本地调用完成：numpy 数组按 CSR 布局直接传指针，dtype 与内存布局已符合要求时不复制；
+ctypes 调用期间释放 GIL，多个 Model 可在不同 Python 线程并行回放。
+
+    import numpy as np, cameraman
+    with cameraman.Model("config/camera_config.json") as model:
+        targets = model.predict_batch(players, player_offsets, balls, ball_offsets, timestamps_us)
+        ys, fovs = model.transfer_many(targets)
+
+players / balls 为 (N, 2) float32，offsets 为 (frames + 1,) uint64，第 f 帧为 [offsets[f], offsets[f + 1])。
+共享库按 CAMERAMAN_LIB 环境变量、本文件所在目录、仓库 build 目录的顺序查找。
+"""
+import ctypes
+import os
+
+import numpy as np
+
+ABI_VERSION = 1
+
+_OK = 0
+_BUFFER_TOO_SMALL = 2
+
+_float_p = ctypes.POINTER(ctypes.c_float)
+_u64_p = ctypes.POINTER(ctypes.c_uint64)
+_u8_p = ctypes.POINTER(ctypes.c_uint8)
+
+
+class CameramanError(RuntimeError):
+    pass
+
+
+def _find_library():
+    env = os.environ.get("CAMERAMAN_LIB")
+    if env:
+        return env
+    here = os.path.dirname(os.path.abspath(__file__))
+    candidates = [here] + [os.path.join(here, "..", d) for d in ("build", "_gate_build")]
+    for directory in candidates:
+        for name in ("libcameraman_c.so", "libcameraman_c.dylib"):
+            path = os.path.join(directory, name)
+            if os.path.exists(path):
+                return path
+    raise CameramanError("libcameraman_c not found; set CAMERAMAN_LIB")
+
+
+def _load(path):
+    # CDLL（而非 PyDLL）在调用期间释放 GIL
+    lib = ctypes.CDLL(path)
+    lib.cameraman_abi_version.restype = ctypes.c_uint32
+    lib.cameraman_last_error.restype = ctypes.c_char_p
+    lib.cameraman_create.argtypes = [ctypes.c_char_p, ctypes.POINTER(ctypes.c_void_p)]
+    lib.cameraman_destroy.argtypes = [ctypes.c_void_p]
+    lib.cameraman_destroy.restype = None
+    lib.cameraman_predict.argtypes = [ctypes.c_void_p, _float_p, ctypes.c_size_t,
+                                      _float_p, ctypes.c_size_t, _float_p]
+    lib.cameraman_predict_batch.argtypes = [ctypes.c_void_p, ctypes.c_size_t,
+                                            _float_p, _u64_p, _float_p, _u64_p, _u64_p, _float_p]
+    lib.cameraman_transfer_many.argtypes = [ctypes.c_void_p, _float_p, ctypes.c_size_t,
+                                            _float_p, _float_p]
+    lib.cameraman_save_state.argtypes = [ctypes.c_void_p, _u8_p, ctypes.c_size_t,
+                                         ctypes.POINTER(ctypes.c_size_t)]
+    lib.cameraman_restore_state.argtypes = [ctypes.c_void_p, _u8_p, ctypes.c_size_t]
+    for name in ("cameraman_create", "cameraman_predict", "cameraman_predict_batch",
+                 "cameraman_transfer_many", "cameraman_save_state", "cameraman_restore_state"):
+        getattr(lib, name).restype = ctypes.c_int
+    if lib.cameraman_abi_version() != ABI_VERSION:
+        raise CameramanError("libcameraman_c ABI version %d, expected %d"
+                             % (lib.cameraman_abi_version(), ABI_VERSION))
+    return lib
+
+
+_lib = None
+
+
+def _library():
+    global _lib
+    if _lib is None:
+        _lib = _load(_find_library())
+    return _lib
+
+
+def _check(status):
+    if status != _OK:
+        raise CameramanError(_library().cameraman_last_error().decode("utf-8", "replace"))
+
+
+def _array(a, dtype, shape_tail=()):
+    """dtype 与 C 连续布局已符合时返回原数组（不复制）。"""
+    a = np.require(a, dtype=dtype, requirements=["C_CONTIGUOUS", "ALIGNED"])
+    if a.shape[1:] != shape_tail:
+        raise ValueError("expected shape (N,%s), got %s" % (",".join(map(str, shape_tail)), a.shape))
+    return a
+
+
+def _ptr(a, ctype):
+    return a.ctypes.data_as(ctypes.POINTER(ctype))
+
+
+class Model:
+    """一个独立的 CameramanModel；同一实例同一时刻只能由一个线程使用。"""
+
+    def __init__(self, config_path):
+        self._handle = None
+        lib = _library()
+        handle = ctypes.c_void_p()
+        _check(lib.cameraman_create(os.fsencode(config_path), ctypes.byref(handle)))
+        self._handle = handle
+
+    def close(self):
+        if self._handle:
+            _library().cameraman_destroy(self._handle)
+            self._handle = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def __del__(self):
+        self.close()
+
+    def predict(self, players, balls):
+        players = _array(players, np.float32, (2,))
+        balls = _array(balls, np.float32, (2,))
+        target = ctypes.c_float()
+        _check(_library().cameraman_predict(self._handle, _ptr(players, ctypes.c_float), len(players),
+                                            _ptr(balls, ctypes.c_float), len(balls),
+                                            ctypes.byref(target)))
+        return target.value
+
+    def predict_batch(self, players, player_offsets, balls, ball_offsets, timestamps_us=None, out=None):
+        """整段序列逐帧推进，返回 (frames,) float32 目标；timestamps_us 为 None 时按固定帧率。"""
+        players = _array(players, np.float32, (2,))
+        balls = _array(balls, np.float32, (2,))
+        player_offsets = _array(player_offsets, np.uint64)
+        ball_offsets = _array(ball_offsets, np.uint64)
+        frames = len(player_offsets) - 1
+        if frames < 0 or len(ball_offsets) != frames + 1:
+            raise ValueError("player_offsets and ball_offsets must both have frames + 1 entries")
+        if player_offsets[-1] > len(players) or ball_offsets[-1] > len(balls):
+            raise ValueError("offsets exceed the point arrays")
+        ts_ptr = None
+        if timestamps_us is not None:
+            timestamps_us = _array(timestamps_us, np.uint64)
+            if len(timestamps_us) != frames:
+                raise ValueError("timestamps_us must have one entry per frame")
+            ts_ptr = _ptr(timestamps_us, ctypes.c_uint64)
+        if out is None:
+            out = np.empty(frames, dtype=np.float32)
+        elif out.dtype != np.float32 or not out.flags.c_contiguous or len(out) != frames:
+            raise ValueError("out must be a contiguous float32 array with one entry per frame")
+        _check(_library().cameraman_predict_batch(
+            self._handle, frames,
+            _ptr(players, ctypes.c_float), _ptr(player_offsets, ctypes.c_uint64),
+            _ptr(balls, ctypes.c_float), _ptr(ball_offsets, ctypes.c_uint64),
+            ts_ptr, _ptr(out, ctypes.c_float)))
+        return out
+
+    def transfer_many(self, xs):
+        xs = _array(xs, np.float32)
+        ys = np.empty_like(xs)
+        fovs = np.empty_like(xs)
+        _check(_library().cameraman_transfer_many(self._handle, _ptr(xs, ctypes.c_float), len(xs),
+                                                  _ptr(ys, ctypes.c_float), _ptr(fovs, ctypes.c_float)))
+        return ys, fovs
+
+    def save_state(self):
+        lib = _library()
+        size = ctypes.c_size_t()
+        status = lib.cameraman_save_state(self._handle, None, 0, ctypes.byref(size))
+        if status != _BUFFER_TOO_SMALL:
+            _check(status)
+        buffer = np.empty(size.value, dtype=np.uint8)
+        _check(lib.cameraman_save_state(self._handle, _ptr(buffer, ctypes.c_uint8), len(buffer),
+                                        ctypes.byref(size)))
+        return buffer[:size.value].tobytes()
+
+    def restore_state(self, state):
+        buffer = np.frombuffer(state, dtype=np.uint8)
+        _check(_library().cameraman_restore_state(self._handle, _ptr(buffer, ctypes.c_uint8), len(buffer)))
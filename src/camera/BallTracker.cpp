@@ -0,0 +1,239 @@
+#include "camera/BallTracker.hpp"
+#include "camera/StateBuffer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// 命中时置信度向 1 靠拢；丢失时衰减较慢，短暂遮挡期间外推的轨迹仍优于远处的备用球
+constexpr float kConfidenceGain = 0.25f;
+constexpr float kMissDecay = 0.9f;
+// 当前输出轨迹的置信度不低于最佳值减去该裕量时继续输出，避免两条轨迹间来回切换
+constexpr float kSwitchMargin = 0.1f;
+// 新轨迹速度未知，初始速度标准差（像素/秒）
+constexpr float kInitialSpeedStd = 2000.0f;
+} // namespace
+
+BallTracker::BallTracker(const ConfigManager::Params::BallTrackerParams& params, int fps) {
+    configure(params, fps);
+}
+
+void BallTracker::configure(const ConfigManager::Params::BallTrackerParams& params, int fps) {
+    params_ = params;
+    nominal_dt_ = 1.0f / static_cast<float>(fps);
+
+    const float r = params.measurement_noise * params.measurement_noise;
+    P0_ << r,    0.0f,
+           0.0f, kInitialSpeedStd * kInitialSpeedStd;
+    const auto R = KalmanFilter<2, 1>::MeasurementMatrix::Constant(r);
+    for (auto& track : tracks_) track.filter.setMeasurementNoise(R);
+    setTimeStep(nominal_dt_);
+}
+
+void BallTracker::setTimeStep(float dt) {
+    dt_ = dt;
+    // 命中增益、丢失衰减、丢失计数与门限都按名义帧定义，变帧率时按本帧相当的名义帧数换算；
+    // 名义帧率下 frame_ratio_ 恰为 1，结果与按帧计数逐位相同
+    frame_ratio_ = dt / nominal_dt_;
+    confidence_gain_ = 1.0f - std::pow(1.0f - kConfidenceGain, frame_ratio_);
+    miss_decay_ = std::pow(kMissDecay, frame_ratio_);
+    // 速度未知的新轨迹在一帧内的可能位移与间隔成正比，间隔变短时不收紧门限
+    gate_scale_ = std::max(1.0f, frame_ratio_);
+
+    // 常速度模型，白噪声加速度离散化
+    F_ << 1.0f, dt,
+          0.0f, 1.0f;
+    const float q = params_.accel_noise * params_.accel_noise;
+    Q_ << q * dt * dt * dt * dt / 4.0f, q * dt * dt * dt / 2.0f,
+          q * dt * dt * dt / 2.0f,      q * dt * dt;
+    for (auto& track : tracks_) {
+        track.filter.setTransition(F_);
+        track.filter.setProcessNoise(Q_);
+    }
+}
+
+void BallTracker::reset() {
+    for (auto& track : tracks_) track.active = false;
+    selected_ = -1;
+}
+
+void BallTracker::startTrack(Track& track, const Point& candidate) {
+    track.id = next_id_++;
+    track.active = true;
+    track.hits = frame_ratio_;
+    track.misses = 0.0f;
+    track.confidence = confidence_gain_;
+    track.y = candidate.y;
+    track.filter.reset(KalmanFilter<2, 1>::State(candidate.x, 0.0f), P0_);
+}
+
+bool BallTracker::update(Span<const Point> balls, float player_x, float& ball_x) {
+    return update(balls, player_x, ball_x, nominal_dt_);
+}
+
+bool BallTracker::update(Span<const Point> balls, float player_x, float& ball_x, float dt) {
+    if (dt != dt_) setTimeStep(dt);
+
+    // 1. 活动轨迹预测到本帧
+    for (auto& track : tracks_) {
+        if (track.active) track.filter.predict();
+    }
+
+    // 2. 贪心全局最近邻：每轮取门限内距离最小的 (轨迹, 候选) 对，轨迹和候选各只用一次
+    const size_t count = std::min(balls.size(), kMaxCandidates);
+    std::array<bool, kMaxCandidates> used{};
+    std::array<bool, kMaxTracks> matched{};
+    const float gate = params_.gate_pixels * gate_scale_;
+    const float gate2 = gate * gate;
+    for (;;) {
+        float best = gate2;
+        size_t best_track = kMaxTracks;
+        size_t best_candidate = kMaxCandidates;
+        for (size_t t = 0; t < kMaxTracks; ++t) {
+            if (!tracks_[t].active || matched[t]) continue;
+            const float tx = tracks_[t].x();
+            for (size_t c = 0; c < count; ++c) {
+                if (used[c]) continue;
+                const float dx = balls[c].x - tx;
+                const float dy = balls[c].y - tracks_[t].y;
+                const float d2 = dx * dx + dy * dy;
+                if (d2 < best) {
+                    best = d2;
+                    best_track = t;
+                    best_candidate = c;
+                }
+            }
+        }
+        if (best_track == kMaxTracks) break;
+
+        Track& track = tracks_[best_track];
+        const Point& z = balls[best_candidate];
+        track.filter.update(KalmanFilter<2, 1>::Measurement::Constant(z.x));
+        track.y = z.y;
+        track.hits += frame_ratio_;
+        track.misses = 0.0f;
+        track.confidence += confidence_gain_ * (1.0f - track.confidence);
+        matched[best_track] = true;
+        used[best_candidate] = true;
+    }
+
+    // 3. 未关联的轨迹靠预测外推，连续丢失过多则结束
+    for (size_t t = 0; t < kMaxTracks; ++t) {
+        Track& track = tracks_[t];
+        if (!track.active || matched[t]) continue;
+        track.misses += frame_ratio_;
+        track.confidence *= miss_decay_;
+        if (track.misses > params_.max_misses + 0.5f) {
+            track.active = false;
+            if (selected_ == static_cast<int>(t)) selected_ = -1;
+        }
+    }
+
+    // 4. 未关联的候选生成新轨迹：优先空槽，其次替换本帧未命中、置信度最低的未确认轨迹
+    for (size_t c = 0; c < count; ++c) {
+        if (used[c]) continue;
+        size_t slot = kMaxTracks;
+        float lowest = 2.0f;
+        for (size_t t = 0; t < kMaxTracks; ++t) {
+            const Track& track = tracks_[t];
+            if (!track.active) {
+                slot = t;
+                break;
+            }
+            if (!matched[t] && !track.confirmed(params_.confirm_hits) && track.confidence < lowest) {
+                lowest = track.confidence;
+                slot = t;
+            }
+        }
+        if (slot == kMaxTracks) break;   // 池中全是确认轨迹，丢弃剩余候选
+        if (selected_ == static_cast<int>(slot)) selected_ = -1;
+        startTrack(tracks_[slot], balls[c]);
+        matched[slot] = true;
+    }
+
+    const Track* track = selectBest(player_x);
+    if (!track) return false;
+    ball_x = track->x();
+    return true;
+}
+
+float BallTracker::score(const Track& track, float player_x) const {
+    return track.confidence / (1.0f + std::fabs(track.x() - player_x) / params_.player_affinity);
+}
+
+BallTracker::Track* BallTracker::selectBest(float player_x) {
+    // 确认轨迹优先，同级比较得分
+    auto better = [&](const Track& a, const Track& b) {
+        const bool ca = a.confirmed(params_.confirm_hits);
+        const bool cb = b.confirmed(params_.confirm_hits);
+        if (ca != cb) return ca;
+        return score(a, player_x) > score(b, player_x);
+    };
+
+    int best = -1;
+    for (size_t t = 0; t < kMaxTracks; ++t) {
+        if (!tracks_[t].active) continue;
+        if (best < 0 || better(tracks_[t], tracks_[best])) best = static_cast<int>(t);
+    }
+    if (best < 0) {
+        selected_ = -1;
+        return nullptr;
+    }
+
+    // 迟滞：当前轨迹与最佳轨迹同级且得分相差不大时保持不变
+    if (selected_ >= 0 && selected_ != best) {
+        const Track& current = tracks_[selected_];
+        const Track& candidate = tracks_[best];
+        if (current.confirmed(params_.confirm_hits) == candidate.confirmed(params_.confirm_hits) &&
+            score(current, player_x) >= score(candidate, player_x) - kSwitchMargin) {
+            best = selected_;
+        }
+    }
+    selected_ = best;
+    return &tracks_[best];
+}
+
+size_t BallTracker::activeTracks() const {
+    size_t n = 0;
+    for (const auto& track : tracks_) n += track.active ? 1 : 0;
+    return n;
+}
+
+const BallTracker::Track* BallTracker::selected() const {
+    return selected_ >= 0 ? &tracks_[selected_] : nullptr;
+}
+
+void BallTracker::saveState(StateWriter& out) const {
+    for (const auto& track : tracks_) {
+        out.put(track.id);
+        out.put<uint8_t>(track.active);
+        out.put(track.hits);
+        out.put(track.misses);
+        out.put(track.confidence);
+        out.put(track.y);
+        out.putMatrix(track.filter.state());
+        out.putMatrix(track.filter.covariance());
+    }
+    out.put<int32_t>(selected_);
+    out.put(next_id_);
+}
+
+void BallTracker::loadState(StateReader& in) {
+    for (auto& track : tracks_) {
+        track.id = in.get<uint32_t>();
+        track.active = in.get<uint8_t>() != 0;
+        track.hits = in.get<float>();
+        track.misses = in.get<float>();
+        track.confidence = in.get<float>();
+        track.y = in.get<float>();
+        KalmanFilter<2, 1>::State x;
+        KalmanFilter<2, 1>::StateMatrix P;
+        in.getMatrix(x);
+        in.getMatrix(P);
+        track.filter.reset(x, P);
+    }
+    selected_ = in.get<int32_t>();
+    next_id_ = in.get<uint32_t>();
+    if (selected_ >= static_cast<int>(kMaxTracks) || (selected_ >= 0 && !tracks_[selected_].active)) {
+        throw std::runtime_error("Invalid BallTracker selection in state snapshot");
+    }
+}
@@ -0,0 +1,333 @@
+#include "camera/CameramanBank.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+// 与 CameramanModel 相同：按时间淘汰时窗口容量为名义样本数的倍数，相邻帧间隔上限（秒）
+constexpr size_t kTimedHistoryFactor = 4;
+constexpr float kMaxFrameGap = 1.0f;
+} // namespace
+
+CameramanBank::Lane::Lane(const ConfigManager& config, uint64_t version,
+                          std::shared_ptr<const Params> snapshot)
+    : config(&config),
+      config_version(version),
+      params(std::move(snapshot)),
+      player_filter(params->safety),
+      ball_tracker(params->ball_tracker, params->camera.fps),
+      target_filter(*params),
+      court_players(PlayerFilter::kDefaultCapacity),
+      court_balls(PlayerFilter::kDefaultCapacity) {}
+
+CameramanBank::CameramanBank(const std::vector<const ConfigManager*>& configs) {
+    if (configs.empty()) {
+        throw std::invalid_argument("CameramanBank needs at least one camera");
+    }
+    const size_t K = configs.size();
+    lanes_.reserve(K);
+    for (const ConfigManager* config : configs) {
+        if (!config) throw std::invalid_argument("CameramanBank camera without config");
+        // 先读版本再取快照，错过的更新下一帧补上
+        const uint64_t version = config->Version();
+        lanes_.emplace_back(*config, version, config->Snapshot());
+    }
+
+    history_head_.assign(K, 0);
+    history_size_.assign(K, 0);
+    history_capacity_.assign(K, 0);
+    history_horizon_us_.assign(K, 0);
+    slider_x_.assign(K, 0.0f);
+    slider_p_.assign(K, 0.0f);
+    slider_q_.assign(K, 0.0f);
+    slider_r_.assign(K, 0.0f);
+    min_target_.assign(K, 0.0f);
+    max_target_.assign(K, 0.0f);
+    fps_.assign(K, 0.0f);
+    intervals_.assign(K, 0.0f);
+    speed_max_.assign(K, 0.0f);
+    merge_ratio_.assign(K, 0.0f);
+    focus_x_.assign(K, 0.0f);
+    ball_x_.assign(K, 0.0f);
+    dt_.assign(K, 0.0f);
+    speed_.assign(K, 0.0f);
+    raw_target_.assign(K, 0.0f);
+
+    for (size_t k = 0; k < K; ++k) {
+        Lane& lane = lanes_[k];
+        const Params& params = *lane.params;
+        if (!params.court_points.empty()) {
+            lane.court.build(params.court_points, static_cast<float>(params.safety.boundary_margin));
+            lane.ball_court.build(params.court_points, static_cast<float>(params.safety.boundary_margin),
+                                  static_cast<float>(params.safety.ball_loft_margin));
+        }
+        lane.focus.configure(params.focus, lane.court.left(), lane.court.right());
+        slider_x_[k] = 0.5f;
+        slider_p_[k] = params.slider.variance_position;
+        slider_q_[k] = params.slider.process_noise;
+        slider_r_[k] = params.slider.variance_measurement;
+        updateBounds(k);
+    }
+}
+
+void CameramanBank::updateBounds(size_t k) {
+    const Lane& lane = lanes_[k];
+    const Params::CameraParams& camera = lane.params->camera;
+    min_target_[k] = lane.court.left() - camera.buffer_pixels;
+    max_target_[k] = lane.court.right() + camera.buffer_pixels;
+    fps_[k] = static_cast<float>(camera.fps);
+    intervals_[k] = static_cast<float>(historySize(k) - 1);
+    speed_max_[k] = camera.speed_max;
+    merge_ratio_[k] = camera.position_merge_ratio;
+}
+
+void CameramanBank::applySnapshot(size_t k, std::shared_ptr<const Params> params) {
+    Lane& lane = lanes_[k];
+    lane.params = std::move(params);
+    const Params& p = *lane.params;
+    if (!p.court_points.empty()) {
+        lane.court.build(p.court_points, static_cast<float>(p.safety.boundary_margin));
+        lane.ball_court.build(p.court_points, static_cast<float>(p.safety.boundary_margin),
+                              static_cast<float>(p.safety.ball_loft_margin));
+    }
+    slider_q_[k] = p.slider.process_noise;
+    slider_r_[k] = p.slider.variance_measurement;
+    lane.player_filter.configure(p.safety);
+    lane.ball_tracker.configure(p.ball_tracker, p.camera.fps);
+    lane.target_filter.configure(p);
+    lane.focus.configure(p.focus, lane.court.left(), lane.court.right());
+    updateBounds(k);
+
+    // 记忆窗口长度变化时以上一帧位置重新填充
+    if (lane.initialized && !historyMatchesConfig(k)) {
+        initializeHistory(k, historyBack(k));
+    }
+}
+
+size_t CameramanBank::historySize(size_t k) const {
+    const Params::CameraParams& camera = lanes_[k].params->camera;
+    return static_cast<size_t>(camera.memory_length * camera.fps);
+}
+
+size_t CameramanBank::historyCapacity(size_t k) const {
+    return lanes_[k].timed ? std::max<size_t>(historySize(k) * kTimedHistoryFactor, 2) : historySize(k);
+}
+
+uint64_t CameramanBank::historyHorizonUs(size_t k) const {
+    const size_t history_size = historySize(k);
+    if (!lanes_[k].timed || history_size == 0) return 0;
+    return static_cast<uint64_t>((history_size - 0.5) * 1e6 / lanes_[k].params->camera.fps);
+}
+
+bool CameramanBank::historyMatchesConfig(size_t k) const {
+    return history_capacity_[k] == historyCapacity(k) &&
+           history_horizon_us_[k] == historyHorizonUs(k);
+}
+
+void CameramanBank::initializeHistory(size_t k, float initial) {
+    Lane& lane = lanes_[k];
+    const size_t history_size = historySize(k);
+    if (history_size == 0) {
+        throw std::invalid_argument("历史队列大小不能为0");
+    }
+
+    const size_t capacity = historyCapacity(k);
+    if (capacity > history_slots_) {
+        // 新增的 slot 追加在末尾，已有各路的位置不变
+        history_slots_ = capacity;
+        history_.resize(history_slots_ * lanes_.size());
+        history_times_.resize(history_slots_ * lanes_.size());
+    }
+    const size_t K = lanes_.size();
+    history_capacity_[k] = capacity;
+    history_head_[k] = 0;
+    if (lane.timed) {
+        // 按时间淘汰：只保留初始样本
+        history_horizon_us_[k] = historyHorizonUs(k);
+        for (size_t slot = 0; slot < capacity; ++slot) history_times_[slot * K + k] = lane.last_timestamp_us;
+        history_[k] = initial;
+        history_size_[k] = 1;
+        lane.focus.reset(capacity, history_horizon_us_[k]);
+    } else {
+        history_horizon_us_[k] = 0;
+        for (size_t slot = 0; slot < capacity; ++slot) history_[slot * K + k] = initial;
+        history_size_[k] = capacity;
+        lane.focus.reset(capacity);
+    }
+}
+
+void CameramanBank::popHistory(size_t k) {
+    history_head_[k] = wrapHistory(k, history_head_[k] + 1);
+    --history_size_[k];
+}
+
+void CameramanBank::pushHistory(size_t k, float value) {
+    if (history_size_[k] == history_capacity_[k]) popHistory(k);
+    const size_t slot = wrapHistory(k, history_head_[k] + history_size_[k]);
+    history_[slot * lanes_.size() + k] = value;
+    ++history_size_[k];
+}
+
+void CameramanBank::pushHistory(size_t k, float value, uint64_t timestamp_us) {
+    const size_t K = lanes_.size();
+    if (history_size_[k] == history_capacity_[k]) popHistory(k);
+    // 新样本与最旧样本相距达到 horizon 的样本出队，保留至少两个样本供求速度
+    while (history_size_[k] >= 2 &&
+           timestamp_us - history_times_[history_head_[k] * K + k] >= history_horizon_us_[k]) {
+        popHistory(k);
+    }
+    const size_t slot = wrapHistory(k, history_head_[k] + history_size_[k]);
+    history_times_[slot * K + k] = timestamp_us;
+    history_[slot * K + k] = value;
+    ++history_size_[k];
+}
+
+float CameramanBank::historyBack(size_t k) const {
+    if (history_size_[k] == 0) return 0.0f;
+    return history_[wrapHistory(k, history_head_[k] + history_size_[k] - 1) * lanes_.size() + k];
+}
+
+void CameramanBank::predictBatch(Span<const CameraInput> inputs, float* targets) {
+    predict(inputs, nullptr, targets);
+}
+
+void CameramanBank::predictBatch(Span<const CameraInput> inputs, const uint64_t* timestamps_us,
+                                 float* targets) {
+    predict(inputs, timestamps_us, targets);
+}
+
+void CameramanBank::stepLane(size_t k, const CameraInput& input, bool timed, uint64_t timestamp_us) {
+    Lane& lane = lanes_[k];
+
+    // 无配置变化时只有一次原子读取
+    const uint64_t config_version = lane.config->Version();
+    if (config_version != lane.config_version) {
+        lane.config_version = config_version;
+        applySnapshot(k, lane.config->Snapshot());
+    }
+    const Params& params = *lane.params;
+
+    float dt = 1.0f / static_cast<float>(params.camera.fps);
+    if (timed != lane.timed) {
+        // 调用方式切换：以上一帧位置按新的淘汰方式重建窗口，本帧按名义步长处理
+        lane.timed = timed;
+        lane.last_timestamp_us = timestamp_us;
+        if (!lane.timed) slider_q_[k] = params.slider.process_noise;
+        if (lane.initialized) initializeHistory(k, historyBack(k));
+    } else if (lane.timed && lane.initialized) {
+        const uint64_t now = std::max(timestamp_us, lane.last_timestamp_us);
+        dt = std::min((now - lane.last_timestamp_us) * 1e-6f, kMaxFrameGap);
+        lane.last_timestamp_us = now;
+    } else if (lane.timed) {
+        lane.last_timestamp_us = timestamp_us;
+    }
+    if (lane.timed) {
+        slider_q_[k] = params.slider.process_noise * dt * params.camera.fps;
+    }
+    dt_[k] = dt;
+
+    // 空输入以上一帧位置代替（首帧为初始化窗口所用的位置）
+    float last_pos = historyBack(k);
+    Span<const Point> players = input.players;
+    Span<const Point> balls = input.balls;
+    if (!lane.court.empty()) {
+        const size_t num_players = std::min(players.size(), lane.court_players.size());
+        const size_t num_balls = std::min(balls.size(), lane.court_balls.size());
+        players = Span<const Point>(lane.court_players.data(),
+                                    lane.court.filter(players, lane.court_players.data(), num_players));
+        balls = Span<const Point>(lane.court_balls.data(),
+                                  lane.ball_court.filter(balls, lane.court_balls.data(), num_balls));
+    }
+
+    const PlayerFilter::Result filtered = lane.player_filter.filter(players);
+
+    if (!lane.initialized) {
+        initializeHistory(k, !filtered.held ? filtered.stats.mean()
+                             : players.empty() ? last_pos : players[0].x);
+        lane.initialized = true;
+        last_pos = historyBack(k);
+    }
+
+    const float mean_pos = filtered.held ? last_pos : filtered.stats.mean();
+    if (lane.timed) {
+        pushHistory(k, mean_pos, lane.last_timestamp_us);
+    } else {
+        pushHistory(k, mean_pos);
+    }
+
+    float focus_x = mean_pos;
+    if (params.focus.mode == Params::FocusParams::Mode::Density) {
+        const Span<const float> xs = filtered.held ? Span<const float>() : filtered.survivors;
+        if (lane.timed) {
+            lane.focus.push(xs, lane.last_timestamp_us);
+        } else {
+            lane.focus.push(xs);
+        }
+        if (!lane.focus.locate(mean_pos, focus_x)) focus_x = mean_pos;
+    }
+    focus_x_[k] = focus_x;
+
+    float ball_x;
+    if (!lane.ball_tracker.update(balls, mean_pos, ball_x, dt)) ball_x = last_pos;
+    ball_x_[k] = ball_x;
+}
+
+void CameramanBank::predict(Span<const CameraInput> inputs, const uint64_t* timestamps_us,
+                            float* targets) {
+    const size_t K = lanes_.size();
+    if (inputs.size() != K) {
+        throw std::invalid_argument("CameramanBank input count does not match camera count");
+    }
+
+    // 1. 逐路：检测数量各不相同，场内过滤、剔除、记忆窗口、焦点与球跟踪无法跨相机向量化
+    for (size_t k = 0; k < K; ++k) {
+        stepLane(k, inputs[k], timestamps_us != nullptr, timestamps_us ? timestamps_us[k] : 0);
+    }
+
+    // 2. 窗口首尾差求速度：固定帧率按样本数，按时间淘汰时按窗口时长折算到名义帧间隔数
+    for (size_t k = 0; k < K; ++k) {
+        float speed = 0.0f;
+        if (history_size_[k] >= 2) {
+            const size_t oldest = history_head_[k];
+            const size_t newest = wrapHistory(k, oldest + history_size_[k] - 1);
+            const float span = history_[newest * K + k] - history_[oldest * K + k];
+            if (history_horizon_us_[k] == 0) {
+                speed = span * fps_[k];
+            } else {
+                const uint64_t duration_us = history_times_[newest * K + k] - history_times_[oldest * K + k];
+                if (duration_us != 0) speed = span / (duration_us * 1e-6f) * intervals_[k];
+            }
+        }
+        speed_[k] = speed;
+    }
+
+    // 3. 跨相机逐元素：速度裁剪、slider 滤波、位置融合与裁剪
+    float* const speed = speed_.data();
+    float* const slider_x = slider_x_.data();
+    float* const slider_p = slider_p_.data();
+    const float* const slider_q = slider_q_.data();
+    const float* const slider_r = slider_r_.data();
+    const float* const speed_max = speed_max_.data();
+    const float* const ratio = merge_ratio_.data();
+    const float* const focus_x = focus_x_.data();
+    const float* const ball_x = ball_x_.data();
+    const float* const min_target = min_target_.data();
+    const float* const max_target = max_target_.data();
+    float* const raw_target = raw_target_.data();
+    for (size_t k = 0; k < K; ++k) {
+        speed[k] = std::clamp(speed[k], -speed_max[k], speed_max[k]);
+        const float slider = 0.5f * (speed[k] / speed_max[k] + 1.0f);
+        const float p = slider_p[k] + slider_q[k];
+        const float gain = p / (p + slider_r[k]);
+        slider_x[k] += gain * (slider - slider_x[k]);
+        slider_p[k] = (1.0f - gain) * p;
+
+        const float merged = ratio[k] * focus_x[k] + (1 - ratio[k]) * ball_x[k];
+        raw_target[k] = std::clamp(merged, min_target[k], max_target[k]);
+    }
+
+    // 4. 逐路：运动模型滤波并按延迟外推，外推结果同样限制在球场内
+    for (size_t k = 0; k < K; ++k) {
+        targets[k] = std::clamp(lanes_[k].target_filter.update(raw_target[k], dt_[k]),
+                                min_target[k], max_target[k]);
+    }
+}
@@ -1,218 +1,426 @@
 #include "camera/CameramanModel.hpp"
-#include <numeric>
+#include "camera/StateBuffer.hpp"
 #include <algorithm>
 #include <cmath>
-#include <iostream>
+#include <cstring>
 
-void CameramanModel::initializeHistory(const std::vector<Point>& positions) {
-    std::cout << "初始化历史数据，输入位置数量: " << positions.size() << std::endl;
-    
-    if (positions.empty()) {
-        throw std::runtime_error("无法用空位置初始化历史数据");
-    }
+namespace {
+// 按时间淘汰时窗口容量为名义样本数的倍数，检测帧率最高可达 fps 的这么多倍
+constexpr size_t kTimedHistoryFactor = 4;
+// 相邻帧间隔的上限（秒），更长的中断按此处理，滤波器的过程噪声不会无限放大
+constexpr float kMaxFrameGap = 1.0f;
+} // namespace
+
+size_t CameramanModel::historySize() const {
+    return static_cast<size_t>(params_->camera.memory_length * params_->camera.fps);
+}
+
+size_t CameramanModel::historyCapacity() const {
+    return timed_ ? std::max<size_t>(historySize() * kTimedHistoryFactor, 2) : historySize();
+}
+
+uint64_t CameramanModel::historyHorizonUs() const {
+    // 名义帧率下恰好保留 historySize() 个样本，留半帧余量避免抖动时样本数来回变化
+    const size_t history_size = historySize();
+    if (!timed_ || history_size == 0) return 0;
+    return static_cast<uint64_t>((history_size - 0.5) * 1e6 / params_->camera.fps);
+}
+
+bool CameramanModel::historyMatchesConfig() const {
+    return player_pos_memory_.capacity() == historyCapacity() &&
+           player_pos_memory_.horizonUs() == historyHorizonUs();
+}
 
-    const size_t history_size = 
-        static_cast<size_t>(params_.camera.memory_length * params_.camera.fps);
-    
-    std::cout << "计算历史队列大小: " << history_size 
-              << " (memory_length=" << params_.camera.memory_length
-              << ", fps=" << params_.camera.fps << ")\n";
+void CameramanModel::initializeHistory(float initial) {
+    const size_t history_size = historySize();
+
+    CAMERA_LOG("计算历史队列大小 (memory_length, fps)",
+               params_->camera.memory_length, params_->camera.fps);
 
     if (history_size == 0) {
         throw std::invalid_argument("历史队列大小不能为0");
     }
 
-    const float initial = positions[0].x;
-    std::cout << "初始基准位置X: " << initial << std::endl;
-
+    CAMERA_LOG("初始基准位置X", initial);
 
-    
-    // 清空现有数据
-    player_pos_memory_.clear();
-    player_pos_memory_.resize(history_size, initial);
-    std::cout << "位置队列初始化完成，实际大小: " 
-              << player_pos_memory_.size() << std::endl;
-    player_max_memory_.clear();
-    player_min_memory_.clear();
-    
-    // 填充历史数据
-    player_max_memory_.resize(history_size, initial);
-    player_min_memory_.resize(history_size, initial);
+    // 固定容量环形窗口，之后每帧 O(1) 且不再分配
+    if (timed_) {
+        const size_t capacity = historyCapacity();
+        const uint64_t horizon_us = historyHorizonUs();
+        player_pos_memory_.reset(capacity, initial, horizon_us, last_timestamp_us_);
+        player_max_memory_.reset(capacity, initial, horizon_us, last_timestamp_us_);
+        player_min_memory_.reset(capacity, initial, horizon_us, last_timestamp_us_);
+        focus_.reset(capacity, horizon_us);
+    } else {
+        player_pos_memory_.reset(history_size, initial);
+        player_max_memory_.reset(history_size, initial);
+        player_min_memory_.reset(history_size, initial);
+        focus_.reset(history_size);
+    }
+    CAMERA_LOG("位置队列初始化完成，实际大小", static_cast<float>(player_pos_memory_.size()));
 }
 
 std::optional<CameramanModel::DebugInfo> CameramanModel::getDebugInfo() const {
     return debug_info_;
 }
 
-void CameramanModel::handleEmptyInput(std::vector<Point>& players, 
-                                    std::vector<Point>& balls) const {
-    if (players.empty()) {
-        players.push_back({player_pos_memory_.back(), 0});
-    }
-    if (balls.empty()) {
-        balls.push_back({player_pos_memory_.back(), 0});
+float CameramanModel::calculateAccumulatedSpeed() const {
+    if (player_pos_memory_.size() < 2) return 0.0f;
+
+    if (player_pos_memory_.timed()) {
+        // 窗口内的平均速度乘以名义窗口的帧间隔数：帧率恰为 fps 时与按样本数的结果相同，
+        // 丢帧或降帧率时不随窗口内样本数变化
+        const uint64_t duration_us = player_pos_memory_.duration();
+        if (duration_us == 0) return 0.0f;
+        const float nominal_intervals = static_cast<float>(historySize() - 1);
+        return player_pos_memory_.span() / (duration_us * 1e-6f) * nominal_intervals;
     }
+
+    // 窗口内逐帧差分之和等于首尾差
+    return player_pos_memory_.span() * params_->camera.fps; // 转换为每秒速度
 }
 
-float CameramanModel::calculateAccumulatedSpeed(const std::deque<float>& positions) const {
-    if (positions.size() < 2) return 0.0f;
-    
-    float total = 0.0f;
-    for (size_t i = 1; i < positions.size(); ++i) {
-        total += positions[i] - positions[i-1];
-    }
-    return total * params_.camera.fps; // 转换为每秒速度
+void CameramanModel::updateCourt(const std::vector<Point>& court_points) {
+    if (court_points.empty()) return;
+    // 余量随 safety 段变化，即使多边形未变也重建
+    if (&court_points != &court_points_) court_points_ = court_points;
+    buildCourt();
 }
+
+void CameramanModel::buildCourt() {
+    const auto& safety = params_->safety;
+    court_.build(court_points_, static_cast<float>(safety.boundary_margin));
+    ball_court_.build(court_points_, static_cast<float>(safety.boundary_margin),
+                      static_cast<float>(safety.ball_loft_margin));
+}
+
 // CameramanModel.cpp
 CameramanModel::CameramanModel(const std::vector<Point>& court_points)
-    : params_(ConfigManager::Get()),
-      left_most_(0.0f),    // 直接在初始化列表赋值
-      right_most_(1920.0f), 
-      initialized_(false) 
+    : CameramanModel(ConfigManager::Default(), court_points) {}
+
+CameramanModel::CameramanModel(const ConfigManager& config)
+    : CameramanModel(config, config.Snapshot()->court_points) {}
+
+CameramanModel::CameramanModel(const ConfigManager& config,
+                               const std::vector<Point>& court_points)
+    : config_(config),
+      config_version_(config.Version()),    // 先读版本再取快照，错过的更新下一帧补上
+      params_(config.Snapshot()),
+      slider_filter_(0.5f, params_->slider),
+      player_filter_(params_->safety),
+      ball_tracker_(params_->ball_tracker, params_->camera.fps),
+      target_filter_(*params_),
+      court_players_(PlayerFilter::kDefaultCapacity),
+      court_balls_(PlayerFilter::kDefaultCapacity),
+      initialized_(false)
 {
     if (!court_points.empty()) {
-        auto x_comparator = [](const Point& a, const Point& b) { 
-            return a.x < b.x; 
-        };
-        
-        auto min_it = std::min_element(court_points.begin(), 
-                                      court_points.end(), 
-                                      x_comparator);
-        auto max_it = std::max_element(court_points.begin(),
-                                      court_points.end(),
-                                      x_comparator);
-        
-        left_most_ = min_it->x;    // 允许修改非 const 成员
-        right_most_ = max_it->x;   // 允许修改非 const 成员
-    
-
-        std::cout << "计算出的球场边界: left=" << left_most_ 
-                  << ", right=" << right_most_ << std::endl;
+        updateCourt(court_points);
+        CAMERA_LOG("计算出的球场边界 (left, right)", court_.left(), court_.right());
     } else {
-        std::cout << "警告: 使用默认球场边界 (0, 1920)\n";
+        CAMERA_LOG("警告: 使用默认球场边界 (0, 1920)");
     }
+    focus_.configure(params_->focus, court_.left(), court_.right());
 
     // 检查 Kalman 滤波器参数
-    std::cout << "Slider滤波参数 - variance_position: " 
-              << ConfigManager::Get().slider.variance_position
-              << ", variance_measurement: " 
-              << ConfigManager::Get().slider.variance_measurement 
-              << std::endl;
-
-    // 初始化滤波器
-    try {
-        const auto& slider_params = ConfigManager::Get().slider;
-
-        // 正确调用构造函数（2个参数）
-        slider_filter_ = std::make_unique<KalmanFilter1D>(
-            0.5f, 
-            slider_params // 直接传递结构体
-    );
-        std::cout << "[SUCCESS] Kalman滤波器初始化完成\n";
-    } catch (const std::exception& e) {
-        std::cerr << "[ERROR] Kalman滤波器初始化失败: " << e.what() << std::endl;
-        throw;
+    CAMERA_LOG("Slider滤波参数 (variance_position, variance_measurement)",
+               params_->slider.variance_position, params_->slider.variance_measurement);
+    CAMERA_LOG("[SUCCESS] Kalman滤波器初始化完成");
+}
+
+void CameramanModel::applySnapshot(std::shared_ptr<const ConfigManager::Params> params) {
+    // 旧快照随 shared_ptr 释放，其他仍持有它的模型不受影响
+    params_ = std::move(params);
+    updateCourt(params_->court_points);
+    CAMERA_LOG("球场边界已更新 (left, right)", court_.left(), court_.right());
+
+    slider_filter_.setProcessNoise(params_->slider.process_noise);
+    slider_filter_.setMeasurementNoise(params_->slider.variance_measurement);
+    player_filter_.configure(params_->safety);
+    ball_tracker_.configure(params_->ball_tracker, params_->camera.fps);
+    target_filter_.configure(*params_);
+    focus_.configure(params_->focus, court_.left(), court_.right());
+
+    // 记忆窗口长度变化时以上一帧位置重新填充
+    if (initialized_ && !historyMatchesConfig()) {
+        initializeHistory(player_pos_memory_.back());
     }
 }
+
 float CameramanModel::predict(const std::vector<Point>& players, 
                             const std::vector<Point>& balls) {
-    if (ConfigManager::ReloadCourtPointsIfNeeded()) {
-        // 更新边界
-        const auto& court_points = ConfigManager::Get().court_points;
-        if (!court_points.empty()) {
-            auto x_comparator = [](const Point& a, const Point& b) { return a.x < b.x; };
-            auto min_it = std::min_element(court_points.begin(), court_points.end(), x_comparator);
-            auto max_it = std::max_element(court_points.begin(), court_points.end(), x_comparator);
-            left_most_ = min_it->x;
-            right_most_ = max_it->x;
+    return predict(Span<const Point>(players), Span<const Point>(balls));
+}
+
+float CameramanModel::predict(Span<const Point> players, Span<const Point> balls) {
+    return predictFrame(players, balls, false, 0);
+}
+
+float CameramanModel::predict(Span<const Point> players, Span<const Point> balls,
+                              uint64_t timestamp_us) {
+    return predictFrame(players, balls, true, timestamp_us);
+}
+
+float CameramanModel::predictFrame(Span<const Point> players, Span<const Point> balls,
+                                   bool timed, uint64_t timestamp_us) {
+    {
+        // 无配置变化时只有一次原子读取，解析工作在 ConfigWatcher 线程完成
+        CAMERA_TRACE_STAGE(ReloadCheck);
+        const uint64_t config_version = config_.Version();
+        if (config_version != config_version_) {
+            config_version_ = config_version;
+            applySnapshot(config_.Snapshot());
         }
     }
-    // std::cout << "\n==== 开始预测 ====\n";
-    // std::cout << "输入球员数量: " << players.size() 
-    //           << ", 球数量: " << balls.size() << std::endl;
 
-    auto processed_players = players;
-    auto processed_balls = balls;
-    handleEmptyInput(processed_players, processed_balls);
+    float dt = 1.0f / static_cast<float>(params_->camera.fps);
+    if (timed != timed_) {
+        // 调用方式切换：以上一帧位置按新的淘汰方式重建窗口，本帧按名义步长处理
+        timed_ = timed;
+        last_timestamp_us_ = timestamp_us;
+        if (!timed_) slider_filter_.setProcessNoise(params_->slider.process_noise);
+        if (initialized_) initializeHistory(player_pos_memory_.back());
+    } else if (timed_ && initialized_) {
+        // 时间戳倒退时按间隔 0 处理，窗口时间保持单调
+        const uint64_t now = std::max(timestamp_us, last_timestamp_us_);
+        dt = std::min((now - last_timestamp_us_) * 1e-6f, kMaxFrameGap);
+        last_timestamp_us_ = now;
+    } else if (timed_) {
+        last_timestamp_us_ = timestamp_us;
+    }
+    if (timed_) {
+        // 随机游走的过程噪声按名义帧归一化，与间隔成正比
+        slider_filter_.setProcessNoise(params_->slider.process_noise * dt * params_->camera.fps);
+    }
+
+    // 空输入不再复制并补点，而是直接以上一帧位置代替（首帧为初始化窗口所用的位置）
+    float last_pos = player_pos_memory_.back();
+    if (players.empty() || balls.empty()) CAMERA_COUNT(EmptyFrameFallback);
 
-    // std::cout << "处理后球员数量: " << processed_players.size()
-    //           << ", 球数量: " << processed_balls.size() << std::endl;
+    // 暂存区（及离群剔除）按固定容量截断球员检测，超出部分计数后忽略
+    size_t truncated = players.size() - std::min(players.size(), court_players_.size());
+    size_t off_court = 0;
+    if (!court_.empty()) {
+        // 按行查表丢弃球场（含 boundary_margin）外的检测，之后各阶段只看到场内检测；
+        // 球的索引另向上放宽 ball_loft_margin，高空球不会被当作场外
+        CAMERA_TRACE_STAGE(Court);
+        const size_t num_players = players.size() - truncated;
+        const size_t num_balls = std::min(balls.size(), court_balls_.size());
+        truncated += balls.size() - num_balls;
+        players = Span<const Point>(court_players_.data(),
+                                    court_.filter(players, court_players_.data(), num_players));
+        balls = Span<const Point>(court_balls_.data(),
+                                  ball_court_.filter(balls, court_balls_.data(), num_balls));
+        off_court = num_players + num_balls - players.size() - balls.size();
+        if (off_court) CAMERA_COUNT_N(OffCourtRejected, off_court);
+    }
+    if (truncated) CAMERA_COUNT_N(InputTruncated, truncated);
+
+    PlayerFilter::Result filtered;
+    {
+        // 剔除观众、替补席等离群检测；幸存者不足或均值突跳未确认时按空帧处理
+        CAMERA_TRACE_STAGE(Outlier);
+        filtered = player_filter_.filter(players);
+        if (filtered.rejected) CAMERA_COUNT_N(OutlierRejected, filtered.rejected);
+        if (filtered.held && !players.empty()) CAMERA_COUNT(PlayerHold);
+    }
 
     if (!initialized_) {
-        std::cout << "首次运行，初始化历史数据...\n";
+        CAMERA_LOG("首次运行，初始化历史数据...");
         try {
-            initializeHistory(processed_players);
+            initializeHistory(!filtered.held ? filtered.stats.mean()
+                              : players.empty() ? last_pos : players[0].x);
             initialized_ = true;
-            std::cout << "历史数据初始化完成，队列大小: " 
-                      << player_pos_memory_.size() << std::endl;
-        } catch (const std::exception& e) {
-            std::cerr << "历史数据初始化失败: " << e.what() << std::endl;
+            last_pos = player_pos_memory_.back();
+        } catch (const std::exception&) {
+            CAMERA_LOG("历史数据初始化失败");
             throw;
         }
     }
 
-    // 核心计算逻辑
-    const float mean_pos = std::accumulate(processed_players.begin(), processed_players.end(), 0.0f,
-        [](float sum, const Point& p) { return sum + p.x; }) / processed_players.size();
-
-    // 更新记忆队列
-    player_pos_memory_.push_back(mean_pos);
-    player_max_memory_.push_back(std::max_element(processed_players.begin(), processed_players.end(),
-        [](const Point& a, const Point& b) { return a.x < b.x; })->x);
-    player_min_memory_.push_back(std::min_element(processed_players.begin(), processed_players.end(),
-        [](const Point& a, const Point& b) { return a.x < b.x; })->x);
-
-    // 计算速度
-    const float speed = std::clamp(
-        calculateAccumulatedSpeed(player_pos_memory_),
-        -params_.camera.speed_max,
-        params_.camera.speed_max
-    );
-
-    // 更新滑动参数
-    const float slider = 0.5f * (speed / params_.camera.speed_max + 1.0f);
-    const float filtered_slider = slider_filter_->filterMeasurement(slider);
-
-    // 计算最终目标位置
-    const float target_x = std::clamp(
-        params_.camera.position_merge_ratio * mean_pos + 
-        (1 - params_.camera.position_merge_ratio) * processed_balls[0].x,
-        left_most_ - params_.camera.buffer_pixels,
-        right_most_ + params_.camera.buffer_pixels
-    );
+    float mean_pos;
+    float ball_x;
+    {
+        // 幸存者的均值与最值已在剔除阶段单次遍历得到
+        CAMERA_TRACE_STAGE(Stats);
+        const PlayerStats stats = filtered.held
+            ? PlayerStats{last_pos, last_pos, last_pos, 1}
+            : filtered.stats;
+        mean_pos = stats.mean();
+
+        // 更新记忆队列
+        if (timed_) {
+            player_pos_memory_.push(mean_pos, last_timestamp_us_);
+            player_max_memory_.push(stats.max, last_timestamp_us_);
+            player_min_memory_.push(stats.min, last_timestamp_us_);
+        } else {
+            player_pos_memory_.push(mean_pos);
+            player_max_memory_.push(stats.max);
+            player_min_memory_.push(stats.min);
+        }
+    }
+
+    float focus_x = mean_pos;
+    if (params_->focus.mode == ConfigManager::Params::FocusParams::Mode::Density) {
+        // 幸存球员进入直方图（保持上一帧时记空帧），取记忆窗口内球员最密集的镜头宽度区间
+        CAMERA_TRACE_STAGE(Focus);
+        const Span<const float> xs = filtered.held ? Span<const float>() : filtered.survivors;
+        if (timed_) {
+            focus_.push(xs, last_timestamp_us_);
+        } else {
+            focus_.push(xs);
+        }
+        if (!focus_.locate(mean_pos, focus_x)) focus_x = mean_pos;
+    }
+
+    {
+        // 关联候选球并取（按与球员距离折减后）置信度最高的轨迹；没有任何轨迹时沿用上一帧位置
+        CAMERA_TRACE_STAGE(BallTrack);
+        if (!ball_tracker_.update(balls, mean_pos, ball_x, dt)) ball_x = last_pos;
+    }
+
+    float speed;
+    {
+        // 计算速度
+        CAMERA_TRACE_STAGE(Speed);
+        speed = std::clamp(
+            calculateAccumulatedSpeed(),
+            -params_->camera.speed_max,
+            params_->camera.speed_max
+        );
+    }
+
+    float filtered_slider;
+    {
+        // 更新滑动参数
+        CAMERA_TRACE_STAGE(Filter);
+        const float slider = 0.5f * (speed / params_->camera.speed_max + 1.0f);
+        filtered_slider = slider_filter_.filterMeasurement(slider);
+    }
+
+    const float min_target = court_.left() - params_->camera.buffer_pixels;
+    const float max_target = court_.right() + params_->camera.buffer_pixels;
+
+    float raw_target;
+    {
+        // 计算原始目标位置
+        CAMERA_TRACE_STAGE(Clamp);
+        const float merged = params_->camera.position_merge_ratio * focus_x + 
+            (1 - params_->camera.position_merge_ratio) * ball_x;
+        raw_target = std::clamp(merged, min_target, max_target);
+        if (raw_target != merged) CAMERA_COUNT(BoundaryClamp);
+    }
+
+    float target_x;
+    {
+        // 运动模型滤波并按延迟向前外推，外推结果同样限制在球场内
+        CAMERA_TRACE_STAGE(TargetFilter);
+        target_x = std::clamp(target_filter_.update(raw_target, dt), min_target, max_target);
+    }
 
     // 保存调试信息
     debug_info_.emplace(DebugInfo{
-        target_x, 
-        target_x,  // 实际应添加滤波处理
+        raw_target,
+        target_x,
         mean_pos,
+        focus_x,
         speed,
-        filtered_slider
+        filtered_slider,
+        player_pos_memory_.mean(),
+        player_min_memory_.min(),
+        player_max_memory_.max(),
+        ball_x,
+        ball_tracker_.selected() ? ball_tracker_.selected()->id : 0u,
+        target_filter_.velocity(),
+        dt,
+        static_cast<uint32_t>(off_court),
+        static_cast<uint32_t>(truncated),
+        static_cast<uint32_t>(filtered.rejected),
+        filtered.held
     });
 
     return target_x;
 }
 
+namespace {
+constexpr char kStateMagic[4] = {'C', 'M', 'S', 'T'};
+// 2: 记忆窗口改为槽位下标并支持按时间淘汰，增加时间戳状态
+// 3: 球场左右边界改为完整多边形，恢复时重建场内索引
+// 4: 增加密度焦点的帧环
+constexpr uint32_t kStateVersion = 4;
+} // namespace
+
+void CameramanModel::saveState(std::vector<uint8_t>& out) const {
+    StateWriter writer(out);
+    writer.putBytes(kStateMagic, sizeof(kStateMagic));
+    writer.put(kStateVersion);
+    writer.put<uint8_t>(initialized_);
+    writer.put<uint8_t>(timed_);
+    writer.put(last_timestamp_us_);
+    writer.put(static_cast<uint32_t>(court_points_.size()));
+    writer.putArray(court_points_.data(), court_points_.size());
+    if (initialized_) {
+        // 未初始化的模型窗口为空，不写入，恢复后首帧照常初始化
+        player_pos_memory_.saveState(writer);
+        player_max_memory_.saveState(writer);
+        player_min_memory_.saveState(writer);
+        focus_.saveState(writer);
+    }
+    writer.put(slider_filter_.state());
+    writer.put(slider_filter_.covariance());
+    player_filter_.saveState(writer);
+    ball_tracker_.saveState(writer);
+    target_filter_.saveState(writer);
+}
+
+void CameramanModel::restoreState(Span<const uint8_t> state) {
+    StateReader reader(state.data(), state.size());
+    char magic[sizeof(kStateMagic)];
+    reader.getBytes(magic, sizeof(magic));
+    if (std::memcmp(magic, kStateMagic, sizeof(magic)) != 0) {
+        throw std::runtime_error("Invalid model state snapshot");
+    }
+    if (reader.get<uint32_t>() != kStateVersion) {
+        throw std::runtime_error("Unsupported model state snapshot version");
+    }
+    const bool initialized = reader.get<uint8_t>() != 0;
+    timed_ = reader.get<uint8_t>() != 0;
+    last_timestamp_us_ = reader.get<uint64_t>();
+    court_points_.resize(reader.get<uint32_t>());
+    reader.getArray(court_points_.data(), court_points_.size());
+    buildCourt();
+    focus_.configure(params_->focus, court_.left(), court_.right());
+    if (initialized) {
+        player_pos_memory_.loadState(reader);
+        player_max_memory_.loadState(reader);
+        player_min_memory_.loadState(reader);
+        focus_.loadState(reader);
+    }
+    const float slider_x = reader.get<float>();
+    const float slider_P = reader.get<float>();
+    slider_filter_.reset(slider_x, slider_P);
+    player_filter_.loadState(reader);
+    ball_tracker_.loadState(reader);
+    target_filter_.loadState(reader);
+    if (reader.remaining() != 0) {
+        throw std::runtime_error("Trailing bytes in model state snapshot");
+    }
+    initialized_ = initialized;
+    debug_info_.reset();
+
+    // 快照与本进程配置的记忆窗口长度不同时，按 applySnapshot() 的规则以上一帧位置重新填充
+    if (initialized_ && !historyMatchesConfig()) {
+        initializeHistory(player_pos_memory_.back());
+    }
+}
+
 std::tuple<float, float> CameramanModel::transfer(float x) const {
-    // 读取参数
-    const auto& t = params_.transfer;
-    
-    // 归一化 x 坐标到 [0, 1] 范围
-    float norm = (x - t.x_min) / (t.x_max - t.x_min);
-    norm = std::clamp(norm, 0.0f, 1.0f);
-
-    // 基于篮球场特性的映射函数
-    // Y轴：中间位置需要更低（因为全景图畸变），两端稍高
-    // 使用反向二次函数：中心最小，两端较大
-    float y_factor = 0.8f + 0.2f * std::pow(2 * norm - 1, 2);  // 中心0.8，两端1.0
-    float y = t.y_min + (t.y_max - t.y_min) * y_factor;
-    
-    // FOV：根据实际需求，中间区域视角稍大，两端稍小
-    // 使用轻微的反向二次函数
-    float fov_factor = 1.0f - 0.15f * std::pow(2 * norm - 1, 2);  // 中心1.0，两端0.85
-    float fov = t.fov_min + (t.fov_max - t.fov_min) * fov_factor;
-    
-    return {y, fov};
+    // 曲线在加载 transfer 配置时按所选模式预先构建
+    return params_->transfer.curve.evaluate(x);
+}
+
+void CameramanModel::transferMany(Span<const float> xs, float* ys, float* fovs) const {
+    params_->transfer.curve.evaluateMany(xs, ys, fovs);
 }
 
 // 其他成员函数实现...
\ No newline at end of file
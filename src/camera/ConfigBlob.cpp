@@ -0,0 +1,228 @@
+#include "camera/ConfigBlob.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr char kMagic[4] = {'C', 'M', 'C', 'F'};
+
+struct BlobHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t payload_size;
+    uint64_t checksum;
+    int64_t config_mtime;
+};
+
+// 负载开头的定长参数块，随后依次为三个路径字符串与 num_court_points 个 Point
+struct BlobFixed {
+    ConfigManager::Params::KalmanParams base;
+    ConfigManager::Params::KalmanParams slider;
+    ConfigManager::Params::CameraParams camera;
+    ConfigManager::Params::SafetyParams safety;
+    ConfigManager::Params::BallTrackerParams ball_tracker;
+    ConfigManager::Params::TargetFilterParams target_filter;
+    ConfigManager::Params::FocusParams focus;
+    TransferCurve::Range transfer;
+    uint32_t transfer_mode;
+    uint32_t lut_size;
+    int64_t court_mtime;
+    uint32_t num_court_points;
+    uint32_t path_sizes[3];   // default_court, user_court, court_file
+};
+
+static_assert(std::is_trivially_copyable_v<BlobFixed>, "BlobFixed must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<Point>, "Point must be trivially copyable");
+
+uint64_t Fnv1a(const char* data, size_t size) {
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+void Append(std::vector<char>& out, const void* src, size_t bytes) {
+    const char* p = static_cast<const char*>(src);
+    out.insert(out.end(), p, p + bytes);
+}
+
+// 只读映射，析构时解除
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+        fd_ = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd_ < 0) {
+            if (errno == ENOENT) return;
+            throw std::runtime_error("Cannot open config blob: " + path);
+        }
+        struct stat st;
+        if (fstat(fd_, &st) != 0) {
+            throw std::runtime_error("Cannot stat config blob: " + path);
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ == 0) return;
+        void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (p == MAP_FAILED) {
+            throw std::runtime_error("Cannot map config blob: " + path);
+        }
+        data_ = static_cast<const char*>(p);
+    }
+    ~MappedFile() {
+        if (data_) munmap(const_cast<char*>(data_), size_);
+        if (fd_ >= 0) close(fd_);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool exists() const { return fd_ >= 0; }
+    const char* data() const { return data_; }
+    size_t size() const { return data_ ? size_ : 0; }
+
+private:
+    int fd_ = -1;
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace
+
+std::string ConfigBlob::PathFor(const std::string& config_path) {
+    const auto slash = config_path.find_last_of('/');
+    const auto dot = config_path.find_last_of('.');
+    const bool has_ext = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+    if (has_ext && config_path.compare(dot, std::string::npos, ".bin") == 0) {
+        return config_path;
+    }
+    return (has_ext ? config_path.substr(0, dot) : config_path) + ".bin";
+}
+
+void ConfigBlob::Write(const std::string& blob_path,
+                       const ConfigManager::Params& params,
+                       const ConfigManager::SourceFiles& files,
+                       time_t config_mtime) {
+    BlobFixed fixed{};
+    fixed.base = params.base;
+    fixed.slider = params.slider;
+    fixed.camera = params.camera;
+    fixed.safety = params.safety;
+    fixed.ball_tracker = params.ball_tracker;
+    fixed.target_filter = params.target_filter;
+    fixed.focus = params.focus;
+    fixed.transfer = params.transfer.curve.range();
+    fixed.transfer_mode = static_cast<uint32_t>(params.transfer.curve.mode());
+    fixed.lut_size = static_cast<uint32_t>(params.transfer.curve.lutSize());
+    fixed.court_mtime = static_cast<int64_t>(files.court_mtime);
+    fixed.num_court_points = static_cast<uint32_t>(params.court_points.size());
+    fixed.path_sizes[0] = static_cast<uint32_t>(files.default_court.size());
+    fixed.path_sizes[1] = static_cast<uint32_t>(files.user_court.size());
+    fixed.path_sizes[2] = static_cast<uint32_t>(files.court_file.size());
+
+    std::vector<char> payload;
+    Append(payload, &fixed, sizeof(fixed));
+    Append(payload, files.default_court.data(), files.default_court.size());
+    Append(payload, files.user_court.data(), files.user_court.size());
+    Append(payload, files.court_file.data(), files.court_file.size());
+    Append(payload, params.court_points.data(), params.court_points.size() * sizeof(Point));
+
+    BlobHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.payload_size = payload.size();
+    header.checksum = Fnv1a(payload.data(), payload.size());
+    header.config_mtime = static_cast<int64_t>(config_mtime);
+
+    const std::string tmp_path = blob_path + ".tmp";
+    FILE* f = std::fopen(tmp_path.c_str(), "wb");
+    if (!f) throw std::runtime_error("Cannot write config blob: " + tmp_path);
+    const bool ok = std::fwrite(&header, sizeof(header), 1, f) == 1 &&
+                    std::fwrite(payload.data(), 1, payload.size(), f) == payload.size();
+    if (std::fclose(f) != 0 || !ok) {
+        std::remove(tmp_path.c_str());
+        throw std::runtime_error("Failed to write config blob: " + tmp_path);
+    }
+    if (std::rename(tmp_path.c_str(), blob_path.c_str()) != 0) {
+        std::remove(tmp_path.c_str());
+        throw std::runtime_error("Cannot replace config blob: " + blob_path);
+    }
+}
+
+bool ConfigBlob::Read(const std::string& blob_path,
+                      time_t json_mtime,
+                      ConfigManager::Params& params,
+                      ConfigManager::SourceFiles& files) {
+    const MappedFile file(blob_path);
+    if (!file.exists()) return false;
+
+    BlobHeader header;
+    if (file.size() < sizeof(header)) {
+        throw std::runtime_error("Truncated config blob: " + blob_path);
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kFormatVersion) {
+        throw std::runtime_error("Unsupported CMCF config blob version: " + blob_path);
+    }
+    if (json_mtime != 0 && header.config_mtime != static_cast<int64_t>(json_mtime)) {
+        return false;   // JSON 在编译后被修改过
+    }
+
+    const char* payload = file.data() + sizeof(header);
+    if (header.payload_size != file.size() - sizeof(header) ||
+        header.checksum != Fnv1a(payload, header.payload_size)) {
+        throw std::runtime_error("Corrupt config blob: " + blob_path);
+    }
+
+    BlobFixed fixed;
+    if (header.payload_size < sizeof(fixed)) {
+        throw std::runtime_error("Corrupt config blob: " + blob_path);
+    }
+    std::memcpy(&fixed, payload, sizeof(fixed));
+    const uint64_t expected = sizeof(fixed) +
+        uint64_t{fixed.path_sizes[0]} + fixed.path_sizes[1] + fixed.path_sizes[2] +
+        uint64_t{fixed.num_court_points} * sizeof(Point);
+    if (expected != header.payload_size || fixed.transfer_mode > 2 ||
+        static_cast<uint32_t>(fixed.target_filter.model) > 2 ||
+        static_cast<uint32_t>(fixed.focus.mode) > 1) {
+        throw std::runtime_error("Corrupt config blob: " + blob_path);
+    }
+
+    params.base = fixed.base;
+    params.slider = fixed.slider;
+    params.camera = fixed.camera;
+    params.safety = fixed.safety;
+    params.ball_tracker = fixed.ball_tracker;
+    params.target_filter = fixed.target_filter;
+    params.focus = fixed.focus;
+    params.transfer.x_min = fixed.transfer.x_min;
+    params.transfer.x_max = fixed.transfer.x_max;
+    params.transfer.y_min = fixed.transfer.y_min;
+    params.transfer.y_max = fixed.transfer.y_max;
+    params.transfer.fov_min = fixed.transfer.fov_min;
+    params.transfer.fov_max = fixed.transfer.fov_max;
+    params.transfer.curve.build(static_cast<TransferCurve::Mode>(fixed.transfer_mode),
+                                fixed.transfer, fixed.lut_size);
+
+    const char* cursor = payload + sizeof(fixed);
+    files.default_court.assign(cursor, fixed.path_sizes[0]);
+    cursor += fixed.path_sizes[0];
+    files.user_court.assign(cursor, fixed.path_sizes[1]);
+    cursor += fixed.path_sizes[1];
+    files.court_file.assign(cursor, fixed.path_sizes[2]);
+    cursor += fixed.path_sizes[2];
+    files.court_mtime = static_cast<time_t>(fixed.court_mtime);
+
+    params.court_points.resize(fixed.num_court_points);
+    std::memcpy(params.court_points.data(), cursor, fixed.num_court_points * sizeof(Point));
+    return true;
+}
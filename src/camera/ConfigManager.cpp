@@ -1,76 +1,84 @@
 #include "camera/ConfigManager.hpp"
+#include "camera/ConfigBlob.hpp"
+#include "camera/ConfigWatcher.hpp"
+#include "camera/Instrumentation.hpp"
 #include <fstream>
 #include <nlohmann/json.hpp>
 #include <sys/stat.h>
-#include <unistd.h>
 #include <ctime>
 
 using json = nlohmann::json;
 
-ConfigManager::Params ConfigManager::params_;
-static std::string last_court_file_;
-static time_t last_court_mtime_ = 0;
+std::unique_ptr<ConfigManager> ConfigManager::default_;
+std::mutex ConfigManager::pinned_mutex_;
+std::shared_ptr<const ConfigManager::Params> ConfigManager::pinned_;
 
-bool ConfigManager::ReloadCourtPointsIfNeeded() {
-    // 读取主 config
-    std::ifstream f("../config/camera_config.json");
-    if (!f.is_open()) return false;
-    json data = json::parse(f);
+static time_t FileMtime(const std::string& path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 ? st.st_mtime : 0;
+}
 
-    if (!data.contains("court_config") ||
-        !data["court_config"].contains("default") ||
-        !data["court_config"].contains("user")) {
-        return false;
-    }
-    std::string default_court = data["court_config"]["default"];
-    std::string user_court = data["court_config"]["user"];
-    std::string court_to_use = default_court;
+static bool IsFileRecent(time_t mtime) {
+    std::time_t now = std::time(nullptr);
+    // 86400 秒 = 1 天
+    return (now - mtime) < 86400;
+}
 
+std::string ConfigManager::SelectCourtFile(const std::string& default_court,
+                                           const std::string& user_court,
+                                           time_t* mtime) {
     struct stat st;
-    time_t mtime = 0;
-    if (access(user_court.c_str(), F_OK) == 0 && stat(user_court.c_str(), &st) == 0) {
-        mtime = st.st_mtime;
-        if ((std::time(nullptr) - mtime) < 86400) {
-            court_to_use = user_court;
-        }
+    if (stat(user_court.c_str(), &st) == 0 && IsFileRecent(st.st_mtime)) {
+        if (mtime) *mtime = st.st_mtime;
+        return user_court;
     }
-
-    // 如果court文件和mtime都没变，不需要reload
-    if (court_to_use == last_court_file_ && mtime == last_court_mtime_) {
-        return false;
+    if (mtime) {
+        *mtime = stat(default_court.c_str(), &st) == 0 ? st.st_mtime : 0;
     }
+    return default_court;
+}
 
-    // 重新加载court_points
-    std::ifstream fc(court_to_use);
-    if (!fc.is_open()) return false;
+std::vector<Point> ConfigManager::LoadCourtPoints(const std::string& court_file) {
+    std::ifstream fc(court_file);
+    if (!fc.is_open()) {
+        throw std::runtime_error("Court config file not found: " + court_file);
+    }
     json court_data = json::parse(fc);
-    if (!court_data.contains("court_points")) return false;
-
-    params_.court_points.clear();
+    if (!court_data.contains("court_points")) {
+        throw std::runtime_error("Missing 'court_points' in court config");
+    }
+    std::vector<Point> points;
     for (const auto& pt : court_data["court_points"]) {
-        if (!pt.contains("x") || !pt.contains("y")) continue;
-        params_.court_points.push_back({pt["x"], pt["y"]});
+        if (!pt.contains("x") || !pt.contains("y")) {
+            throw std::runtime_error("Invalid court point format");
+        }
+        points.push_back({pt["x"], pt["y"]});
     }
-    last_court_file_ = court_to_use;
-    last_court_mtime_ = mtime;
-    return true;
+    return points;
 }
 
-static bool IsFileRecent(const std::string& path) {
-    struct stat st;
-    if (stat(path.c_str(), &st) != 0) return false;
-    std::time_t now = std::time(nullptr);
-    // 86400 秒 = 1 天
-    return (now - st.st_mtime) < 86400;
+void ConfigManager::ReadCourtPaths(const json& data,
+                                   std::string& default_court,
+                                   std::string& user_court) {
+    if (!data.contains("court_config") || 
+        !data["court_config"].contains("default") ||
+        !data["court_config"].contains("user")) {
+        throw std::runtime_error("Missing 'court_config' or its paths in config");
+    }
+    default_court = data["court_config"]["default"];
+    user_court = data["court_config"]["user"];
 }
 
-void ConfigManager::Initialize(const std::string& config_path) {
-    // 1. 读取主 config（camera_config.json 或 user_camera_config.json）
+std::shared_ptr<ConfigManager::Params> ConfigManager::ParseConfigFile(
+    const std::string& config_path, std::string& default_court, std::string& user_court) {
+    // 读取主 config（camera_config.json 或 user_camera_config.json）
     std::ifstream f(config_path);
     if (!f.is_open()) {
         throw std::runtime_error("Config file not found: " + config_path);
     }
 
+    auto result = std::make_shared<Params>();
+    Params& params = *result;
     try {
         json data = json::parse(f);
 
@@ -83,24 +91,32 @@ void ConfigManager::Initialize(const std::string& config_path) {
         if (!kalman.contains("base")) {
             throw std::runtime_error("Missing 'base' in kalman config");
         }
-        ParseKalmanParams(kalman["base"], params_.base);
+        ParseKalmanParams(kalman["base"], params.base);
 
         if (!kalman.contains("slider")) {
             throw std::runtime_error("Missing 'slider' in kalman config");
         }
-        ParseKalmanParams(kalman["slider"], params_.slider);
+        ParseKalmanParams(kalman["slider"], params.slider);
 
         // 读取 transfer 配置
         if (!data.contains("transfer")) {
             throw std::runtime_error("Missing 'transfer' section in config");
         }
         const auto& t = data["transfer"];
-        params_.transfer.x_min = t["x_min"];
-        params_.transfer.x_max = t["x_max"];
-        params_.transfer.y_min = t["y_min"];
-        params_.transfer.y_max = t["y_max"];
-        params_.transfer.fov_min = t["fov_min"];
-        params_.transfer.fov_max = t["fov_max"];
+        params.transfer.x_min = t["x_min"];
+        params.transfer.x_max = t["x_max"];
+        params.transfer.y_min = t["y_min"];
+        params.transfer.y_max = t["y_max"];
+        params.transfer.fov_min = t["fov_min"];
+        params.transfer.fov_max = t["fov_max"];
+        const std::string transfer_mode = t.value("mode", std::string("exact"));
+        const size_t lut_size = t.value("lut_size", TransferCurve::kDefaultLutSize);
+        params.transfer.curve.build(
+            TransferCurve::ParseMode(transfer_mode),
+            {params.transfer.x_min, params.transfer.x_max,
+             params.transfer.y_min, params.transfer.y_max,
+             params.transfer.fov_min, params.transfer.fov_max},
+            lut_size);
 
         // 检查 camera 配置
         if (!data.contains("camera")) {
@@ -116,7 +132,7 @@ void ConfigManager::Initialize(const std::string& config_path) {
                 throw std::runtime_error("Missing key in camera config: " + key);
             }
         }
-        params_.camera = {
+        params.camera = {
             cam["memory_length"],
             cam["fps"],
             cam["speed_max"],
@@ -138,44 +154,228 @@ void ConfigManager::Initialize(const std::string& config_path) {
                 throw std::runtime_error("Missing key in safety config: " + key);
             }
         }
-        params_.safety = {
+        params.safety = {
             safety["noise_threshold"],
             safety["min_players"],
             safety["boundary_margin"]
         };
+        params.safety.ball_loft_margin = safety.value("ball_loft_margin", params.safety.ball_loft_margin);
+
+        // 可选的目标滤波参数
+        if (data.contains("target_filter")) {
+            const json& tf = data["target_filter"];
+            auto& filter = params.target_filter;
+            const std::string model = tf.value("model", std::string("off"));
+            if (model == "off") {
+                filter.model = Params::TargetFilterParams::Model::Off;
+            } else if (model == "cv") {
+                filter.model = Params::TargetFilterParams::Model::ConstantVelocity;
+            } else if (model == "ca") {
+                filter.model = Params::TargetFilterParams::Model::ConstantAcceleration;
+            } else {
+                throw std::runtime_error("Unknown target_filter model: " + model);
+            }
+            filter.process_noise = tf.value("process_noise", filter.process_noise);
+            filter.lead_ms = tf.value("lead_ms", filter.lead_ms);
+        }
 
-        // 2. 读取 court_points（default/user court config 路径从主 config 读取）
-        if (!data.contains("court_config") || 
-            !data["court_config"].contains("default") ||
-            !data["court_config"].contains("user")) {
-            throw std::runtime_error("Missing 'court_config' or its paths in config");
-        }
-        std::string default_court = data["court_config"]["default"];
-        std::string user_court = data["court_config"]["user"];
-        std::string court_to_use = default_court;
-        if (access(user_court.c_str(), F_OK) == 0 && IsFileRecent(user_court)) {
-            court_to_use = user_court;
-        }
-        std::ifstream fc(court_to_use);
-        if (!fc.is_open()) {
-            throw std::runtime_error("Court config file not found: " + court_to_use);
-        }
-        json court_data = json::parse(fc);
-        if (!court_data.contains("court_points")) {
-            throw std::runtime_error("Missing 'court_points' in court config");
-        }
-        params_.court_points.clear();
-        for (const auto& pt : court_data["court_points"]) {
-            if (!pt.contains("x") || !pt.contains("y")) {
-                throw std::runtime_error("Invalid court point format");
+        // 可选的焦点参数
+        if (data.contains("focus")) {
+            const json& fc = data["focus"];
+            auto& focus = params.focus;
+            const std::string mode = fc.value("mode", std::string("mean"));
+            if (mode == "mean") {
+                focus.mode = Params::FocusParams::Mode::Mean;
+            } else if (mode == "density") {
+                focus.mode = Params::FocusParams::Mode::Density;
+            } else {
+                throw std::runtime_error("Unknown focus mode: " + mode);
             }
-            params_.court_points.push_back({pt["x"], pt["y"]});
+            focus.bins = fc.value("bins", focus.bins);
+            focus.window_pixels = fc.value("window_pixels", focus.window_pixels);
+        }
+
+        // 可选的球跟踪参数
+        if (data.contains("ball_tracker")) {
+            const json& bt = data["ball_tracker"];
+            auto& tracker = params.ball_tracker;
+            tracker.gate_pixels = bt.value("gate_pixels", tracker.gate_pixels);
+            tracker.confirm_hits = bt.value("confirm_hits", tracker.confirm_hits);
+            tracker.max_misses = bt.value("max_misses", tracker.max_misses);
+            tracker.accel_noise = bt.value("accel_noise", tracker.accel_noise);
+            tracker.measurement_noise = bt.value("measurement_noise", tracker.measurement_noise);
+            tracker.player_affinity = bt.value("player_affinity", tracker.player_affinity);
         }
 
-        ValidateParams();
+        // 球场文件路径，球场点由调用方按当前时间选择文件后加载
+        ReadCourtPaths(data, default_court, user_court);
     } catch (const json::exception& e) {
         throw std::runtime_error("JSON parse error: " + std::string(e.what()));
     }
+    return result;
+}
+
+std::shared_ptr<ConfigManager::Params> ConfigManager::LoadSources(const std::string& config_path,
+                                                                  SourceFiles& files) {
+    // 优先使用预编译的二进制配置，不存在、过期或损坏时解析 JSON
+    const std::string blob_path = ConfigBlob::PathFor(config_path);
+    const time_t json_mtime = blob_path == config_path ? 0 : FileMtime(config_path);
+    try {
+        auto params = std::make_shared<Params>();
+        if (ConfigBlob::Read(blob_path, json_mtime, *params, files)) {
+            // 球场按当前时间重新选择，与编译时相同则直接使用内嵌的球场点
+            time_t mtime = 0;
+            std::string court_to_use = SelectCourtFile(files.default_court, files.user_court, &mtime);
+            if (court_to_use != files.court_file || mtime != files.court_mtime) {
+                params->court_points = LoadCourtPoints(court_to_use);
+                files.court_file = std::move(court_to_use);
+                files.court_mtime = mtime;
+            }
+            ValidateParams(*params);
+            return params;
+        }
+    } catch (const std::exception&) {
+        CAMERA_LOG("二进制配置无效，改用 JSON 解析");
+    }
+
+    return LoadJson(config_path, &files);
+}
+
+std::shared_ptr<ConfigManager::Params> ConfigManager::LoadParams(const std::string& config_path,
+                                                                 SourceFiles* files) {
+    SourceFiles local;
+    return LoadSources(config_path, files ? *files : local);
+}
+
+std::shared_ptr<ConfigManager::Params> ConfigManager::LoadJson(const std::string& config_path,
+                                                               SourceFiles* files) {
+    SourceFiles local;
+    SourceFiles& out = files ? *files : local;
+    auto params = ParseConfigFile(config_path, out.default_court, out.user_court);
+    out.court_file = SelectCourtFile(out.default_court, out.user_court, &out.court_mtime);
+    params->court_points = LoadCourtPoints(out.court_file);
+    ValidateParams(*params);
+    return params;
+}
+
+ConfigManager::ConfigManager(std::string config_path, bool watch)
+    : config_path_(std::move(config_path)) {
+    config_mtime_ = FileMtime(config_path_);
+    blob_mtime_ = FileMtime(ConfigBlob::PathFor(config_path_));
+    params_ = LoadSources(config_path_, files_);
+
+    if (watch) StartWatching();
+}
+
+ConfigManager::ConfigManager(std::shared_ptr<const Params> params) {
+    if (!params) throw std::invalid_argument("ConfigManager params must not be null");
+    ValidateParams(*params);
+    params_ = std::move(params);
+}
+
+ConfigManager::~ConfigManager() {
+    StopWatching();
+}
+
+std::shared_ptr<const ConfigManager::Params> ConfigManager::Snapshot() const {
+    return std::atomic_load_explicit(&params_, std::memory_order_acquire);
+}
+
+void ConfigManager::Publish(std::shared_ptr<const Params> next) {
+    // 先发布快照再递增版本，读端看到新版本时一定能取到对应快照
+    std::atomic_store_explicit(&params_, std::move(next), std::memory_order_release);
+    version_.fetch_add(1, std::memory_order_release);
+    CAMERA_COUNT(ConfigReload);
+}
+
+bool ConfigManager::Reload() {
+    if (config_path_.empty()) return false;
+    std::lock_guard<std::mutex> lock(reload_mutex_);
+    try {
+        // 主配置或二进制配置变化时整体重新加载，新快照构建完成前旧快照保持可用
+        const time_t config_mtime = FileMtime(config_path_);
+        const time_t blob_mtime = FileMtime(ConfigBlob::PathFor(config_path_));
+        if (config_mtime != config_mtime_ || blob_mtime != blob_mtime_) {
+            SourceFiles files;
+            auto next = LoadSources(config_path_, files);
+            config_mtime_ = config_mtime;
+            blob_mtime_ = blob_mtime;
+            files_ = std::move(files);
+            Publish(std::move(next));
+            return true;
+        }
+
+        // 只有球场文件变化（或用户球场过期）时复制当前快照并替换球场点
+        time_t court_mtime = 0;
+        std::string court_file = SelectCourtFile(files_.default_court, files_.user_court, &court_mtime);
+        if (court_file == files_.court_file && court_mtime == files_.court_mtime) {
+            return false;
+        }
+        std::vector<Point> court_points = LoadCourtPoints(court_file);
+        if (court_points.empty()) return false;
+
+        auto next = std::make_shared<Params>(*params_);
+        next->court_points = std::move(court_points);
+        files_.court_file = std::move(court_file);
+        files_.court_mtime = court_mtime;
+        Publish(std::move(next));
+        return true;
+    } catch (const std::exception&) {
+        // 配置正在写入或格式错误，保留旧快照，下次事件再试
+        return false;
+    }
+}
+
+std::vector<std::string> ConfigManager::WatchedFiles() const {
+    std::lock_guard<std::mutex> lock(reload_mutex_);
+    return {config_path_, files_.default_court, files_.user_court};
+}
+
+void ConfigManager::StartWatching() {
+    if (watcher_ || config_path_.empty()) return;
+    watcher_ = std::make_unique<ConfigWatcher>([this] {
+        Reload();
+        return WatchedFiles();
+    });
+    watcher_->Start();
+}
+
+void ConfigManager::StopWatching() {
+    watcher_.reset();
+}
+
+void ConfigManager::Retarget(const std::string& config_path) {
+    std::lock_guard<std::mutex> lock(reload_mutex_);
+    SourceFiles files;
+    auto next = LoadSources(config_path, files);
+    config_path_ = config_path;
+    config_mtime_ = FileMtime(config_path_);
+    blob_mtime_ = FileMtime(ConfigBlob::PathFor(config_path_));
+    files_ = std::move(files);
+    Publish(std::move(next));
+}
+
+void ConfigManager::Initialize(const std::string& config_path, bool watch) {
+    if (!default_) {
+        default_ = std::make_unique<ConfigManager>(config_path, watch);
+        return;
+    }
+    // 模型以引用持有默认实例，不能销毁重建：停止监视后原地切换，模型按版本号取到新快照
+    default_->StopWatching();
+    try {
+        default_->Retarget(config_path);
+    } catch (const std::exception&) {
+        if (watch) default_->StartWatching();
+        throw;
+    }
+    if (watch) default_->StartWatching();
+}
+
+ConfigManager& ConfigManager::Default() {
+    if (!default_) {
+        throw std::runtime_error("ConfigManager not initialized");
+    }
+    return *default_;
 }
 
 void ConfigManager::ParseKalmanParams(const json& j, Params::KalmanParams& params) {
@@ -191,12 +391,30 @@ void ConfigManager::ParseKalmanParams(const json& j, Params::KalmanParams& param
     params.variance_measurement = j["variance_measurement"];
     params.process_noise = j["process_noise"];
 }
-void ConfigManager::ValidateParams() {
-    if (params_.camera.memory_length <= 0) throw std::invalid_argument("Invalid memory_length");
-    if (params_.camera.fps <= 0) throw std::invalid_argument("Invalid fps");
+void ConfigManager::ValidateParams(const Params& params) {
+    if (params.camera.memory_length <= 0) throw std::invalid_argument("Invalid memory_length");
+    if (params.camera.fps <= 0) throw std::invalid_argument("Invalid fps");
+    if (params.safety.ball_loft_margin < 0) throw std::invalid_argument("Invalid safety.ball_loft_margin");
+    if (params.target_filter.process_noise <= 0) {
+        throw std::invalid_argument("Invalid target_filter.process_noise");
+    }
+    if (params.target_filter.lead_ms < 0) throw std::invalid_argument("Invalid target_filter.lead_ms");
+    if (params.focus.bins < 2 || params.focus.bins > 4096) throw std::invalid_argument("Invalid focus.bins");
+    if (!(params.focus.window_pixels > 0)) throw std::invalid_argument("Invalid focus.window_pixels");
+    if (params.ball_tracker.gate_pixels <= 0) throw std::invalid_argument("Invalid ball_tracker.gate_pixels");
+    if (params.ball_tracker.measurement_noise <= 0) {
+        throw std::invalid_argument("Invalid ball_tracker.measurement_noise");
+    }
+    if (params.ball_tracker.player_affinity <= 0) {
+        throw std::invalid_argument("Invalid ball_tracker.player_affinity");
+    }
     // 其他参数验证...
 }
 
 const ConfigManager::Params& ConfigManager::Get() {
-    return params_;
+    // 只保留最近交出的一份快照：热更新后再次调用时释放上一份，内存不随重载次数增长
+    std::shared_ptr<const Params> current = Default().Snapshot();
+    std::lock_guard<std::mutex> lock(pinned_mutex_);
+    if (pinned_ != current) pinned_ = std::move(current);
+    return *pinned_;
 }
\ No newline at end of file
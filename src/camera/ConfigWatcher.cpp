@@ -0,0 +1,114 @@
+#include "camera/ConfigWatcher.hpp"
+#include "camera/Instrumentation.hpp"
+#include <algorithm>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace {
+// inotify 模式下仍需定期检查，用户球场文件超过一天会自动失效
+constexpr int kRecencyCheckMs = 60 * 1000;
+// eventfd 不可用时 Stop() 无法唤醒监视线程，改为按此间隔醒来检查退出标志
+constexpr int kStopCheckMs = 100;
+
+std::string DirName(const std::string& path) {
+    const auto pos = path.find_last_of('/');
+    if (pos == std::string::npos) return ".";
+    if (pos == 0) return "/";
+    return path.substr(0, pos);
+}
+} // namespace
+
+ConfigWatcher::ConfigWatcher(RefreshFn refresh,
+                             std::chrono::milliseconds poll_interval)
+    : refresh_(std::move(refresh)),
+      poll_interval_(poll_interval) {}
+
+ConfigWatcher::~ConfigWatcher() {
+    Stop();
+}
+
+void ConfigWatcher::Start() {
+    if (running_.load()) return;
+
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        CAMERA_LOG("警告: eventfd 创建失败，监视线程改为短间隔轮询退出标志 (ms)",
+                   static_cast<float>(kStopCheckMs));
+    }
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    running_.store(true);
+    thread_ = std::thread(&ConfigWatcher::Run, this);
+}
+
+void ConfigWatcher::Stop() {
+    if (!running_.exchange(false)) return;
+    if (wake_fd_ >= 0) {
+        const uint64_t one = 1;
+        (void)!write(wake_fd_, &one, sizeof(one));
+    }
+    if (thread_.joinable()) thread_.join();
+    if (inotify_fd_ >= 0) close(inotify_fd_);
+    if (wake_fd_ >= 0) close(wake_fd_);
+    inotify_fd_ = -1;
+    wake_fd_ = -1;
+    watched_dirs_.clear();
+}
+
+void ConfigWatcher::AddWatches(const std::vector<std::string>& files) {
+    if (inotify_fd_ < 0) return;
+    const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE |
+                          IN_DELETE | IN_ATTRIB;
+    for (const auto& file : files) {
+        if (file.empty()) continue;
+        const std::string dir = DirName(file);
+        if (std::find(watched_dirs_.begin(), watched_dirs_.end(), dir) != watched_dirs_.end()) {
+            continue;
+        }
+        if (inotify_add_watch(inotify_fd_, dir.c_str(), mask) >= 0) {
+            watched_dirs_.push_back(dir);
+        }
+    }
+}
+
+void ConfigWatcher::Refresh() {
+    // 配置中的球场路径可能已改变，每次刷新后补充监听新目录
+    AddWatches(refresh_());
+}
+
+void ConfigWatcher::Run() {
+    Refresh();
+
+    const int refresh_ms = inotify_fd_ >= 0
+        ? kRecencyCheckMs
+        : static_cast<int>(poll_interval_.count());
+    // wake_fd_ 为 -1 时 poll 忽略该项，只能靠超时醒来
+    const int timeout_ms = wake_fd_ >= 0 ? refresh_ms : std::min(refresh_ms, kStopCheckMs);
+    auto last_refresh = std::chrono::steady_clock::now();
+
+    alignas(struct inotify_event) char buf[4096];
+    while (running_.load(std::memory_order_relaxed)) {
+        pollfd fds[2];
+        nfds_t nfds = 0;
+        fds[nfds++] = {wake_fd_, POLLIN, 0};
+        if (inotify_fd_ >= 0) fds[nfds++] = {inotify_fd_, POLLIN, 0};
+
+        const int ready = poll(fds, nfds, timeout_ms);
+        if (!running_.load(std::memory_order_relaxed)) break;
+        if (ready < 0) continue;
+
+        bool changed = false;
+        if (nfds > 1 && (fds[1].revents & POLLIN)) {
+            // 只关心是否有事件，具体文件由 Refresh() 通过 mtime 判断
+            while (read(inotify_fd_, buf, sizeof(buf)) > 0) {}
+            changed = true;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (changed || now - last_refresh >= std::chrono::milliseconds(refresh_ms)) {
+            Refresh();
+            last_refresh = now;
+        }
+    }
+}
@@ -0,0 +1,185 @@
+#include "camera/CourtIndex.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__)
+#define CAMERA_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr float kInf = std::numeric_limits<float>::infinity();
+
+// 水平线 y 与多边形各边交点的最左、最右 x；没有交点时为空区间
+CourtIndex::Extents ScanlineExtents(const std::vector<Point>& polygon, float y) {
+    CourtIndex::Extents e{kInf, -kInf};
+    const size_t n = polygon.size();
+    for (size_t i = 0; i < n; ++i) {
+        const Point& a = polygon[i];
+        const Point& b = polygon[i + 1 < n ? i + 1 : 0];
+        if (y < std::min(a.y, b.y) || y > std::max(a.y, b.y)) continue;
+        if (a.y == b.y) {
+            e.left = std::min({e.left, a.x, b.x});
+            e.right = std::max({e.right, a.x, b.x});
+            continue;
+        }
+        const float x = a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y);
+        e.left = std::min(e.left, x);
+        e.right = std::max(e.right, x);
+    }
+    return e;
+}
+
+#ifdef CAMERA_X86
+
+// 把 128 位通道内的乱序（0 1 4 5 | 2 3 6 7）恢复为 0..7
+__attribute__((target("avx2")))
+inline __m256 RestoreLaneOrder(__m256 v) {
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(v), _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+// 从 8 个 Point 中分别取出 x 与 y
+__attribute__((target("avx2")))
+inline void LoadPointsAvx2(const Point* p, __m256& x, __m256& y) {
+    const float* f = &p->x;
+    const __m256 lo = _mm256_loadu_ps(f);
+    const __m256 hi = _mm256_loadu_ps(f + 8);
+    x = RestoreLaneOrder(_mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+    y = RestoreLaneOrder(_mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+// 每次 8 个点：行号与有效性向量计算，按行号 gather 两侧边界，比较结果压成位掩码后依次写出。
+// 与标量路径做同样的浮点运算，结果逐位一致。返回已处理的输入个数（8 的倍数）
+__attribute__((target("avx2")))
+size_t FilterAvx2(const Point* points, size_t n, float y0, float inv_row_height, size_t rows,
+                  const float* row_left, const float* row_right, Point* out, size_t& kept) {
+    const size_t body = n - n % 8;
+    const __m256 origin = _mm256_set1_ps(y0);
+    const __m256 scale = _mm256_set1_ps(inv_row_height);
+    const __m256 limit = _mm256_set1_ps(static_cast<float>(rows));
+    const __m256 zero = _mm256_setzero_ps();
+    for (size_t i = 0; i < body; i += 8) {
+        __m256 x, y;
+        LoadPointsAvx2(points + i, x, y);
+        const __m256 r = _mm256_mul_ps(_mm256_sub_ps(y, origin), scale);
+        const __m256 valid = _mm256_and_ps(_mm256_cmp_ps(r, zero, _CMP_GE_OQ),
+                                           _mm256_cmp_ps(r, limit, _CMP_LT_OQ));
+        // 无效行号置 0，gather 不越界，结果由 valid 屏蔽
+        const __m256i row = _mm256_cvttps_epi32(_mm256_and_ps(r, valid));
+        const __m256 lo = _mm256_i32gather_ps(row_left, row, 4);
+        const __m256 hi = _mm256_i32gather_ps(row_right, row, 4);
+        const __m256 inside = _mm256_and_ps(
+            valid, _mm256_and_ps(_mm256_cmp_ps(x, lo, _CMP_GE_OQ), _mm256_cmp_ps(x, hi, _CMP_LE_OQ)));
+        for (unsigned mask = _mm256_movemask_ps(inside); mask; mask &= mask - 1) {
+            out[kept++] = points[i + __builtin_ctz(mask)];
+        }
+    }
+    return body;
+}
+
+#endif // CAMERA_X86
+
+} // namespace
+
+void CourtIndex::build(const std::vector<Point>& polygon, float margin, float loft) {
+    rows_ = 0;
+    row_left_.clear();
+    row_right_.clear();
+    if (polygon.empty()) return;
+
+    auto x_comparator = [](const Point& a, const Point& b) { return a.x < b.x; };
+    auto y_comparator = [](const Point& a, const Point& b) { return a.y < b.y; };
+    left_ = std::min_element(polygon.begin(), polygon.end(), x_comparator)->x;
+    right_ = std::max_element(polygon.begin(), polygon.end(), x_comparator)->x;
+    if (polygon.size() < 3) return;
+
+    margin_ = std::max(margin, 0.0f);
+    const float min_y = std::min_element(polygon.begin(), polygon.end(), y_comparator)->y;
+    const float max_y = std::max_element(polygon.begin(), polygon.end(), y_comparator)->y;
+    loft = std::max(loft, 0.0f);
+    const float top = min_y - margin_ - loft;
+    const float height = max_y + margin_ - top;
+    const float row_height = std::max(1.0f, height / kMaxRows);
+    const size_t rows = std::max<size_t>(1, static_cast<size_t>(std::ceil(height / row_height)));
+
+    // 先求每行中心处多边形的精确范围（超出多边形 y 范围的行取最近的上下沿）
+    std::vector<Extents> exact(rows);
+    for (size_t r = 0; r < rows; ++r) {
+        const float center = top + (r + 0.5f) * row_height;
+        exact[r] = ScanlineExtents(polygon, std::clamp(center, min_y, max_y));
+    }
+
+    // 再在上下 margin（向下另加 loft）内取最宽范围并左右外扩，每次加载只做一遍
+    const size_t reach = static_cast<size_t>(std::ceil(margin_ / row_height));
+    const size_t reach_down = reach + static_cast<size_t>(std::ceil(loft / row_height));
+    row_left_.resize(rows);
+    row_right_.resize(rows);
+    for (size_t r = 0; r < rows; ++r) {
+        const size_t first = r > reach ? r - reach : 0;
+        const size_t last = std::min(rows - 1, r + reach_down);
+        Extents e{kInf, -kInf};
+        for (size_t s = first; s <= last; ++s) {
+            e.left = std::min(e.left, exact[s].left);
+            e.right = std::max(e.right, exact[s].right);
+        }
+        row_left_[r] = e.left - margin_;
+        row_right_[r] = e.right + margin_;
+    }
+
+    y0_ = top;
+    inv_row_height_ = 1.0f / row_height;
+    rows_ = rows;
+}
+
+bool CourtIndex::extents(float y, Extents& out) const {
+    if (empty()) {
+        out = {left_, right_};
+        return true;
+    }
+    const float r = (y - y0_) * inv_row_height_;
+    if (!(r >= 0.0f && r < static_cast<float>(rows_))) return false;
+    const size_t row = static_cast<size_t>(r);
+    out = {row_left_[row], row_right_[row]};
+    return true;
+}
+
+bool CourtIndex::contains(Point p) const {
+    if (empty()) return true;
+    // 比较写成取反形式，NaN 坐标视为场外
+    const float r = (p.y - y0_) * inv_row_height_;
+    if (!(r >= 0.0f && r < static_cast<float>(rows_))) return false;
+    const size_t row = static_cast<size_t>(r);
+    return p.x >= row_left_[row] && p.x <= row_right_[row];
+}
+
+size_t CourtIndex::filter(Span<const Point> points, Point* out, size_t capacity) const {
+    return filter(points, out, capacity, DetectSimdLevel());
+}
+
+size_t CourtIndex::filter(Span<const Point> points, Point* out, size_t capacity,
+                          SimdLevel level) const {
+    const size_t n = std::min(points.size(), capacity);
+    if (empty()) {
+        std::copy(points.begin(), points.begin() + n, out);
+        return n;
+    }
+
+    size_t kept = 0;
+    size_t i = 0;
+#ifdef CAMERA_X86
+    if (level == SimdLevel::AVX2 && DetectSimdLevel() == SimdLevel::AVX2) {
+        i = FilterAvx2(points.data(), n, y0_, inv_row_height_, rows_,
+                       row_left_.data(), row_right_.data(), out, kept);
+    }
+#else
+    (void)level;
+#endif
+    // 无分支压缩：总是写入，只有场内的点推进输出位置
+    for (; i < n; ++i) {
+        out[kept] = points[i];
+        kept += contains(points[i]);
+    }
+    return kept;
+}
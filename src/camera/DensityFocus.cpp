@@ -0,0 +1,168 @@
+#include "camera/DensityFocus.hpp"
+#include "camera/StateBuffer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+void DensityFocus::configure(const Params& params, float left, float right) {
+    const float width = std::max(right - left, 1.0f);
+    params_ = params;
+    left_ = left;
+    bin_width_ = width / params.bins;
+    window_bins_ = std::clamp<size_t>(static_cast<size_t>(std::lround(params.window_pixels / bin_width_)),
+                                      1, params.bins);
+    hist_.assign(params.bins, 0);
+    rebin();
+}
+
+void DensityFocus::reset(size_t capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument("DensityFocus capacity must be > 0");
+    }
+    xs_.assign(capacity * kMaxFramePlayers, 0.0f);
+    counts_.assign(capacity, 0);
+    times_.clear();
+    horizon_us_ = 0;
+    head_ = 0;
+    size_ = 0;
+    rebin();
+}
+
+void DensityFocus::reset(size_t capacity, uint64_t horizon_us) {
+    if (capacity < 2) {
+        throw std::invalid_argument("Timed DensityFocus capacity must be >= 2");
+    }
+    if (horizon_us == 0) {
+        throw std::invalid_argument("DensityFocus horizon must be > 0");
+    }
+    reset(capacity);
+    times_.assign(capacity, 0);
+    horizon_us_ = horizon_us;
+}
+
+size_t DensityFocus::binOf(float x) const {
+    const float pos = (x - left_) / bin_width_;
+    // 场外（含 NaN）的 x 归入两端的桶
+    if (!(pos > 0.0f)) return 0;
+    return std::min(static_cast<size_t>(pos), hist_.size() - 1);
+}
+
+void DensityFocus::popOldest() {
+    const float* xs = &xs_[head_ * kMaxFramePlayers];
+    for (uint32_t i = 0; i < counts_[head_]; ++i) --hist_[binOf(xs[i])];
+    total_ -= counts_[head_];
+    head_ = wrap(head_ + 1);
+    --size_;
+}
+
+void DensityFocus::append(Span<const float> xs) {
+    const size_t slot = wrap(head_ + size_);
+    const uint32_t n = static_cast<uint32_t>(std::min(xs.size(), kMaxFramePlayers));
+    float* dst = &xs_[slot * kMaxFramePlayers];
+    for (uint32_t i = 0; i < n; ++i) {
+        dst[i] = xs[i];
+        ++hist_[binOf(xs[i])];
+    }
+    counts_[slot] = n;
+    total_ += n;
+    ++size_;
+}
+
+void DensityFocus::push(Span<const float> xs) {
+    if (counts_.empty() || hist_.empty()) return;
+    if (size_ == counts_.size()) popOldest();
+    append(xs);
+}
+
+void DensityFocus::push(Span<const float> xs, uint64_t timestamp_us) {
+    if (counts_.empty() || hist_.empty()) return;
+    if (size_ == counts_.size()) popOldest();
+    while (size_ >= 2 && timestamp_us - times_[head_] >= horizon_us_) popOldest();
+    times_[wrap(head_ + size_)] = timestamp_us;
+    append(xs);
+}
+
+void DensityFocus::rebin() {
+    std::fill(hist_.begin(), hist_.end(), 0u);
+    total_ = 0;
+    if (hist_.empty()) return;
+    for (size_t i = 0, slot = head_; i < size_; ++i, slot = wrap(slot + 1)) {
+        const float* xs = &xs_[slot * kMaxFramePlayers];
+        for (uint32_t j = 0; j < counts_[slot]; ++j) ++hist_[binOf(xs[j])];
+        total_ += counts_[slot];
+    }
+}
+
+bool DensityFocus::locate(float hint, float& x) const {
+    if (total_ == 0) return false;
+
+    // 窗口 [start, start + w) 的计数与按桶下标加权的和随窗口右移增量更新，整数运算无累计误差
+    const size_t w = window_bins_;
+    const size_t bins = hist_.size();
+    uint64_t count = 0, weighted = 0;
+    for (size_t b = 0; b < w; ++b) {
+        count += hist_[b];
+        weighted += uint64_t{hist_[b]} * b;
+    }
+    // 以桶下标计的 hint 位置减去半个窗口，用于比较窗口中心到 hint 的距离
+    const double hint_start = (hint - left_) / bin_width_ - 0.5 * w;
+    uint64_t best_count = count, best_weighted = weighted;
+    double best_distance = std::fabs(hint_start);
+    for (size_t start = 1; start + w <= bins; ++start) {
+        const uint32_t out = hist_[start - 1];
+        const uint32_t in = hist_[start + w - 1];
+        count += in;
+        count -= out;
+        weighted += uint64_t{in} * (start + w - 1);
+        weighted -= uint64_t{out} * (start - 1);
+        if (count < best_count) continue;
+        const double distance = std::fabs(hint_start - static_cast<double>(start));
+        if (count > best_count || distance < best_distance) {
+            best_count = count;
+            best_weighted = weighted;
+            best_distance = distance;
+        }
+    }
+    if (best_count == 0) return false;
+    x = left_ + (static_cast<float>(static_cast<double>(best_weighted) / best_count) + 0.5f) * bin_width_;
+    return true;
+}
+
+void DensityFocus::saveState(StateWriter& out) const {
+    // 只写窗口内的帧，按从旧到新的顺序，恢复后最旧帧位于槽位 0
+    out.put<uint64_t>(counts_.size());
+    out.put(horizon_us_);
+    out.put<uint64_t>(size_);
+    for (size_t i = 0, slot = head_; i < size_; ++i, slot = wrap(slot + 1)) {
+        out.put(counts_[slot]);
+        out.putArray(&xs_[slot * kMaxFramePlayers], counts_[slot]);
+        if (horizon_us_) out.put(times_[slot]);
+    }
+}
+
+void DensityFocus::loadState(StateReader& in) {
+    const size_t capacity = static_cast<size_t>(in.get<uint64_t>());
+    if (capacity == 0 || capacity > in.remaining()) {
+        throw std::runtime_error("Invalid DensityFocus capacity in state snapshot");
+    }
+    const uint64_t horizon_us = in.get<uint64_t>();
+    const size_t size = static_cast<size_t>(in.get<uint64_t>());
+    if (size > capacity) {
+        throw std::runtime_error("Invalid DensityFocus ring in state snapshot");
+    }
+    xs_.resize(capacity * kMaxFramePlayers);
+    counts_.assign(capacity, 0);
+    times_.assign(horizon_us ? capacity : 0, 0);
+    horizon_us_ = horizon_us;
+    head_ = 0;
+    size_ = size;
+    for (size_t slot = 0; slot < size; ++slot) {
+        counts_[slot] = in.get<uint32_t>();
+        if (counts_[slot] > kMaxFramePlayers) {
+            throw std::runtime_error("Invalid DensityFocus frame in state snapshot");
+        }
+        in.getArray(&xs_[slot * kMaxFramePlayers], counts_[slot]);
+        if (horizon_us_) times_[slot] = in.get<uint64_t>();
+    }
+    rebin();
+}
@@ -0,0 +1,4 @@
+// 部署配置模型的显式实例化，DeploymentProfile.hpp 由 config_codegen 在构建时生成
+#include "camera/DeploymentProfile.hpp"
+
+template class StaticCameramanModel<DeploymentProfile>;
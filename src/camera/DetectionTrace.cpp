@@ -0,0 +1,256 @@
+#include "camera/DetectionTrace.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr char kMagic[4] = {'C', 'M', 'T', 'R'};
+constexpr uint32_t kVersion = 1;
+
+struct FileCloser {
+    void operator()(FILE* f) const { if (f) std::fclose(f); }
+};
+using FilePtr = std::unique_ptr<FILE, FileCloser>;
+
+FilePtr OpenFile(const std::string& path, const char* mode) {
+    FilePtr f(std::fopen(path.c_str(), mode));
+    if (!f) throw std::runtime_error("Cannot open trace file: " + path);
+    return f;
+}
+
+void ReadExact(FILE* f, void* dst, size_t bytes, const std::string& path) {
+    if (bytes && std::fread(dst, 1, bytes, f) != bytes) {
+        throw std::runtime_error("Truncated trace file: " + path);
+    }
+}
+
+void WriteExact(FILE* f, const void* src, size_t bytes, const std::string& path) {
+    if (bytes && std::fwrite(src, 1, bytes, f) != bytes) {
+        throw std::runtime_error("Failed to write trace file: " + path);
+    }
+}
+
+bool EndsWith(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() &&
+           s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// 只依赖 mt19937 原始输出的分布变换，保证跨平台可复现
+class TraceRng {
+public:
+    explicit TraceRng(uint32_t seed) : engine_(seed) {}
+
+    float uniform() { return static_cast<float>(engine_() >> 8) * (1.0f / 16777216.0f); }
+    float uniform(float lo, float hi) { return lo + (hi - lo) * uniform(); }
+    bool chance(float p) { return uniform() < p; }
+
+    float normal() {
+        // Box-Muller，u1 取 (0, 1] 避免 log(0)
+        const float u1 = 1.0f - uniform();
+        const float u2 = uniform();
+        return std::sqrt(-2.0f * std::log(u1)) * std::cos(6.2831853f * u2);
+    }
+
+private:
+    std::mt19937 engine_;
+};
+
+} // namespace
+
+void DetectionTrace::addFrame(uint64_t timestamp_us, Span<const Point> frame_players,
+                              Span<const Point> frame_balls) {
+    frames.push_back({timestamp_us,
+                      static_cast<uint32_t>(players.size()),
+                      static_cast<uint32_t>(frame_players.size()),
+                      static_cast<uint32_t>(balls.size()),
+                      static_cast<uint32_t>(frame_balls.size())});
+    players.insert(players.end(), frame_players.begin(), frame_players.end());
+    balls.insert(balls.end(), frame_balls.begin(), frame_balls.end());
+}
+
+DetectionTrace DetectionTrace::Load(const std::string& path) {
+    return EndsWith(path, ".jsonl") ? LoadJsonl(path) : LoadBinary(path);
+}
+
+void DetectionTrace::save(const std::string& path) const {
+    if (EndsWith(path, ".jsonl")) {
+        saveJsonl(path);
+    } else {
+        saveBinary(path);
+    }
+}
+
+DetectionTrace DetectionTrace::LoadBinary(const std::string& path) {
+    FilePtr f = OpenFile(path, "rb");
+
+    char magic[4];
+    uint32_t version = 0;
+    uint64_t counts[3];
+    ReadExact(f.get(), magic, sizeof(magic), path);
+    ReadExact(f.get(), &version, sizeof(version), path);
+    if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || version != kVersion) {
+        throw std::runtime_error("Not a CMTR v1 trace file: " + path);
+    }
+    ReadExact(f.get(), counts, sizeof(counts), path);
+
+    DetectionTrace trace;
+    trace.frames.resize(counts[0]);
+    trace.players.resize(counts[1]);
+    trace.balls.resize(counts[2]);
+
+    uint64_t player_offset = 0, ball_offset = 0;
+    for (auto& frame : trace.frames) {
+        uint32_t sizes[2];
+        ReadExact(f.get(), &frame.timestamp_us, sizeof(frame.timestamp_us), path);
+        ReadExact(f.get(), sizes, sizeof(sizes), path);
+        frame.player_offset = static_cast<uint32_t>(player_offset);
+        frame.num_players = sizes[0];
+        frame.ball_offset = static_cast<uint32_t>(ball_offset);
+        frame.num_balls = sizes[1];
+        player_offset += sizes[0];
+        ball_offset += sizes[1];
+    }
+    if (player_offset != counts[1] || ball_offset != counts[2]) {
+        throw std::runtime_error("Corrupt trace frame table: " + path);
+    }
+    ReadExact(f.get(), trace.players.data(), trace.players.size() * sizeof(Point), path);
+    ReadExact(f.get(), trace.balls.data(), trace.balls.size() * sizeof(Point), path);
+    return trace;
+}
+
+void DetectionTrace::saveBinary(const std::string& path) const {
+    FilePtr f = OpenFile(path, "wb");
+    const uint64_t counts[3] = {frames.size(), players.size(), balls.size()};
+    WriteExact(f.get(), kMagic, sizeof(kMagic), path);
+    WriteExact(f.get(), &kVersion, sizeof(kVersion), path);
+    WriteExact(f.get(), counts, sizeof(counts), path);
+    for (const auto& frame : frames) {
+        const uint32_t sizes[2] = {frame.num_players, frame.num_balls};
+        WriteExact(f.get(), &frame.timestamp_us, sizeof(frame.timestamp_us), path);
+        WriteExact(f.get(), sizes, sizeof(sizes), path);
+    }
+    WriteExact(f.get(), players.data(), players.size() * sizeof(Point), path);
+    WriteExact(f.get(), balls.data(), balls.size() * sizeof(Point), path);
+}
+
+DetectionTrace DetectionTrace::LoadJsonl(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) throw std::runtime_error("Cannot open trace file: " + path);
+
+    DetectionTrace trace;
+    std::vector<Point> frame_players, frame_balls;
+    std::string line;
+    size_t line_no = 0;
+    while (std::getline(in, line)) {
+        ++line_no;
+        if (line.empty()) continue;
+        try {
+            const json j = json::parse(line);
+            frame_players.clear();
+            frame_balls.clear();
+            for (const auto& p : j.at("players")) frame_players.push_back({p.at(0), p.at(1)});
+            for (const auto& b : j.at("balls")) frame_balls.push_back({b.at(0), b.at(1)});
+            trace.addFrame(j.at("t").get<uint64_t>(), frame_players, frame_balls);
+        } catch (const json::exception& e) {
+            throw std::runtime_error("Invalid trace line " + std::to_string(line_no) +
+                                     " in " + path + ": " + e.what());
+        }
+    }
+    return trace;
+}
+
+void DetectionTrace::saveJsonl(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out.is_open()) throw std::runtime_error("Cannot open trace file: " + path);
+    for (size_t i = 0; i < frames.size(); ++i) {
+        json j;
+        j["t"] = frames[i].timestamp_us;
+        j["players"] = json::array();
+        j["balls"] = json::array();
+        for (const Point& p : framePlayers(i)) j["players"].push_back({p.x, p.y});
+        for (const Point& b : frameBalls(i)) j["balls"].push_back({b.x, b.y});
+        out << j.dump() << '\n';
+    }
+}
+
+DetectionTrace GenerateSyntheticTrace(const SyntheticTraceOptions& options) {
+    TraceRng rng(options.seed);
+    DetectionTrace trace;
+    trace.frames.reserve(options.frames);
+
+    const float width = options.court_width;
+    const float height = options.court_height;
+    const float dt = 1.0f / options.fps;
+
+    // 队形：每名球员相对重心的偏移，缓慢随机游走
+    std::vector<Point> offsets(options.players);
+    for (auto& o : offsets) o = {rng.normal() * 0.08f * width, rng.uniform(0.1f, 0.9f) * height};
+
+    float center = width * 0.5f;
+    float goal = center;
+    float speed = 0.0f;          // 当前重心移动速度上限 px/s
+    int hold_frames = 0;
+    bool fast_break = false;
+
+    std::vector<Point> frame_players, frame_balls;
+    for (size_t f = 0; f < options.frames; ++f) {
+        // 重心运动：普通推进缓慢移动，快攻时冲向另一端
+        if (!fast_break && rng.chance(options.fast_break_rate)) {
+            fast_break = true;
+            goal = center < width * 0.5f ? width * 0.88f : width * 0.12f;
+            speed = rng.uniform(1200.0f, 1800.0f);
+        } else if (!fast_break && --hold_frames <= 0) {
+            goal = rng.uniform(0.2f, 0.8f) * width;
+            speed = rng.uniform(80.0f, 250.0f);
+            hold_frames = static_cast<int>(rng.uniform(3.0f, 6.0f) * options.fps);
+        }
+        const float step = speed * dt;
+        const float delta = goal - center;
+        center += std::fabs(delta) <= step ? delta : std::copysign(step, delta);
+        if (fast_break && std::fabs(goal - center) < 1.0f) {
+            fast_break = false;
+            hold_frames = 0;
+        }
+
+        frame_players.clear();
+        frame_balls.clear();
+        const bool empty = rng.chance(options.empty_frame_rate);
+        if (!empty) {
+            for (auto& o : offsets) {
+                o.x += rng.normal() * 3.0f;
+                o.x *= 0.999f;    // 防止队形无限发散
+                if (rng.chance(options.miss_rate)) continue;
+                const float x = std::clamp(center + o.x + rng.normal() * options.noise_px,
+                                           0.0f, width);
+                const float y = std::clamp(o.y + rng.normal() * options.noise_px,
+                                           0.0f, height);
+                frame_players.push_back({x, y});
+            }
+            // 场外误检：观众、替补席
+            if (rng.chance(options.false_positive_rate)) {
+                const float y = rng.chance(0.5f) ? rng.uniform(-80.0f, 0.0f)
+                                                 : rng.uniform(height, height + 80.0f);
+                frame_players.push_back({rng.uniform(0.0f, width), y});
+            }
+            // 球：领先重心，偶尔出现第二个候选（备用球、误检）
+            const float lead = fast_break ? std::copysign(250.0f, goal - center) : 0.0f;
+            frame_balls.push_back({std::clamp(center + lead + rng.normal() * 150.0f, 0.0f, width),
+                                   rng.uniform(0.2f, 0.8f) * height});
+            if (rng.chance(0.05f)) {
+                frame_balls.push_back({rng.uniform(0.0f, width), rng.uniform(0.0f, height)});
+            }
+        }
+
+        const uint64_t timestamp_us = static_cast<uint64_t>(f) * 1000000ull / options.fps;
+        trace.addFrame(timestamp_us, frame_players, frame_balls);
+    }
+    return trace;
+}
@@ -0,0 +1,178 @@
+#include "camera/FramePipeline.hpp"
+#include <algorithm>
+#include <pthread.h>
+#include <sched.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define CAMERA_CPU_RELAX() _mm_pause()
+#else
+#define CAMERA_CPU_RELAX() ((void)0)
+#endif
+
+bool DetectionFrame::assign(Span<const Point> frame_players, Span<const Point> frame_balls) {
+    num_players = static_cast<uint32_t>(std::min(frame_players.size(), players.size()));
+    num_balls = static_cast<uint32_t>(std::min(frame_balls.size(), balls.size()));
+    std::copy_n(frame_players.begin(), num_players, players.begin());
+    std::copy_n(frame_balls.begin(), num_balls, balls.begin());
+    return num_players == frame_players.size() && num_balls == frame_balls.size();
+}
+
+FramePipeline::FramePipeline(CameramanModel& model, const Options& options)
+    : model_(model),
+      options_(options),
+      input_(options.input_capacity),
+      output_(options.output_capacity) {}
+
+FramePipeline::~FramePipeline() {
+    stop();
+}
+
+void FramePipeline::start() {
+    if (running_.exchange(true)) return;
+    worker_ = std::thread(&FramePipeline::run, this);
+}
+
+void FramePipeline::stop() {
+    if (!running_.exchange(false)) return;
+    if (worker_.joinable()) worker_.join();
+}
+
+bool FramePipeline::submit(const DetectionFrame& frame) {
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+
+    // 队列满时两种策略都淘汰最旧帧，新帧总能入队
+    bool evicted = false;
+    DetectionFrame victim;
+    while (!input_.tryPush(frame)) {
+        if (input_.tryPop(victim)) {
+            dropped_input_.fetch_add(1, std::memory_order_relaxed);
+            evicted = true;
+        }
+    }
+
+    const size_t depth = input_.size();
+    size_t seen = max_input_depth_.load(std::memory_order_relaxed);
+    while (depth > seen &&
+           !max_input_depth_.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {}
+    return !evicted;
+}
+
+bool FramePipeline::poll(PtzCommand& command) {
+    return output_.tryPop(command);
+}
+
+void FramePipeline::run() {
+    if (options_.cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(options_.cpu, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+            CAMERA_LOG("工作线程绑核失败 (cpu)", static_cast<float>(options_.cpu));
+        }
+    }
+
+    DetectionFrame frame;
+    uint32_t idle = 0;
+    for (;;) {
+        if (!input_.tryPop(frame)) {
+            // 停止时先排空队列再退出
+            if (!running_.load(std::memory_order_acquire)) break;
+            if (++idle < options_.idle_spin) {
+                CAMERA_CPU_RELAX();
+            } else {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+        idle = 0;
+
+        float target = PredictDetectionFrame(model_, frame);
+        processed_.fetch_add(1, std::memory_order_relaxed);
+
+        uint32_t merged = 1;
+        if (options_.policy == OverloadPolicy::Coalesce) {
+            // 积压帧依次送入模型保持历史连续，只为最新一帧输出指令。
+            // 只排空开始时已积压的帧：生产端持续超速时队列永不为空，不设上限就永远不会输出
+            size_t backlog = std::min(input_.size(), input_.capacity());
+            while (backlog-- > 0 && input_.tryPop(frame)) {
+                target = PredictDetectionFrame(model_, frame);
+                processed_.fetch_add(1, std::memory_order_relaxed);
+                ++merged;
+            }
+            coalesced_.fetch_add(merged - 1, std::memory_order_relaxed);
+        }
+        emit(frame, target, merged);
+    }
+}
+
+float PredictDetectionFrame(CameramanModel& model, const DetectionFrame& frame) {
+    // 带采集时刻的帧按实际间隔推进模型，丢帧时速度与滤波不受影响
+    if (frame.timestamp_ns == 0) return model.predict(frame.playerSpan(), frame.ballSpan());
+    return model.predict(frame.playerSpan(), frame.ballSpan(), frame.timestamp_ns / 1000);
+}
+
+void FramePipeline::emit(const DetectionFrame& frame, float target, uint32_t frames_merged) {
+    const auto [y, fov] = model_.transfer(target);
+    const uint64_t now = Instrumentation::NowNs();
+    const PtzCommand command{frame.sequence, frame.timestamp_ns, now, target, y, fov, frames_merged};
+
+    // 输出端消费过慢时淘汰最旧指令，云台总能拿到最新目标
+    PtzCommand stale;
+    while (!output_.tryPush(command)) {
+        if (output_.tryPop(stale)) {
+            dropped_output_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    emitted_.fetch_add(1, std::memory_order_relaxed);
+    // 固定帧率的帧没有采集时刻，不计入延迟统计
+    if (frame.timestamp_ns != 0) {
+        recordLatency(now > frame.timestamp_ns ? now - frame.timestamp_ns : 0);
+    }
+}
+
+void FramePipeline::recordLatency(uint64_t ns) {
+    latency_sum_ns_.fetch_add(ns, std::memory_order_relaxed);
+    if (ns > latency_max_ns_.load(std::memory_order_relaxed)) {
+        latency_max_ns_.store(ns, std::memory_order_relaxed);   // 只有工作线程写入
+    }
+    const size_t bucket = ns ? std::min<size_t>(64 - __builtin_clzll(ns), kLatencyBuckets - 1) : 0;
+    latency_hist_[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+FramePipeline::Metrics FramePipeline::metrics() const {
+    Metrics m{};
+    m.submitted = submitted_.load(std::memory_order_relaxed);
+    m.processed = processed_.load(std::memory_order_relaxed);
+    m.emitted = emitted_.load(std::memory_order_relaxed);
+    m.dropped_input = dropped_input_.load(std::memory_order_relaxed);
+    m.coalesced = coalesced_.load(std::memory_order_relaxed);
+    m.dropped_output = dropped_output_.load(std::memory_order_relaxed);
+    m.input_depth = input_.size();
+    m.output_depth = output_.size();
+    m.max_input_depth = max_input_depth_.load(std::memory_order_relaxed);
+    m.latency_max_ns = latency_max_ns_.load(std::memory_order_relaxed);
+
+    // 桶 b 覆盖 [2^(b-1), 2^b)，分位数取桶上界
+    uint64_t hist[kLatencyBuckets];
+    uint64_t total = 0;
+    for (size_t b = 0; b < kLatencyBuckets; ++b) {
+        hist[b] = latency_hist_[b].load(std::memory_order_relaxed);
+        total += hist[b];
+    }
+    auto quantile = [&](double q) -> uint64_t {
+        const uint64_t rank = static_cast<uint64_t>(q * total);
+        uint64_t seen = 0;
+        for (size_t b = 0; b < kLatencyBuckets; ++b) {
+            seen += hist[b];
+            if (seen > rank) return b ? (uint64_t{1} << b) - 1 : 0;
+        }
+        return m.latency_max_ns;
+    };
+    if (total) {
+        m.latency_mean_ns = latency_sum_ns_.load(std::memory_order_relaxed) / total;
+        m.latency_p50_ns = std::min(quantile(0.50), m.latency_max_ns);
+        m.latency_p99_ns = std::min(quantile(0.99), m.latency_max_ns);
+    }
+    return m;
+}
@@ -0,0 +1,287 @@
+#include "camera/Instrumentation.hpp"
+#include "camera/SpscRing.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+    uint64_t timestamp_ns;
+    const char* message;
+    float a;
+    float b;
+    uint32_t nargs;
+};
+
+constexpr size_t kRingCapacity = 4096;
+constexpr size_t kStageCount = static_cast<size_t>(Stage::Count);
+constexpr size_t kCounterCount = static_cast<size_t>(Counter::Count);
+
+const char* const kStageNames[kStageCount] = {
+    "reload_check", "court", "outlier", "stats", "focus", "ball_track", "speed", "filter", "clamp", "target_filter"
+};
+const char* const kCounterNames[kCounterCount] = {
+    "empty_frame_fallback", "boundary_clamp", "config_reload", "trace_dropped",
+    "outlier_rejected", "player_hold", "off_court_rejected", "input_truncated"
+};
+
+// 单写者累加：只有所属线程写入，其他线程读取，无需带锁前缀的原子加
+inline void Add(std::atomic<uint64_t>& c, uint64_t n) {
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+struct StageSlot {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> max_ns{0};
+};
+
+// 每个生产线程一份：消息环由本线程写入、导出端读取；阶段耗时与计数器就地累加
+struct ThreadBuffer {
+    SpscRing<TraceEvent, kRingCapacity> ring;
+    std::atomic<uint64_t> counters[kCounterCount] = {};
+    StageSlot stages[kStageCount];
+
+    void add(Counter counter, uint64_t n) {
+        Add(counters[static_cast<size_t>(counter)], n);
+    }
+};
+
+struct Registry {
+    std::mutex mutex;                                   // 仅线程注册、退出与汇总时使用
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    // 已退出线程交还的缓冲，新线程优先复用；未取出的消息和累计值随缓冲保留
+    std::vector<ThreadBuffer*> free_buffers;
+
+    std::mutex drain_mutex;                             // 保证环只有一个消费者
+    uint64_t reported_stages[kStageCount] = {};
+    uint64_t reported_counters[kCounterCount] = {};
+
+    std::mutex exporter_mutex;
+    std::condition_variable exporter_cv;
+    std::thread exporter;
+    bool exporter_running = false;
+    FILE* sink = stderr;
+
+    const uint64_t start_ns = Instrumentation::NowNs();
+
+    ~Registry() {
+        // 进程退出时导出线程可能仍在运行
+        {
+            std::lock_guard<std::mutex> lock(exporter_mutex);
+            exporter_running = false;
+        }
+        exporter_cv.notify_all();
+        if (exporter.joinable()) exporter.join();
+    }
+};
+
+Registry& GetRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+// 线程局部指针为平凡类型，热路径上只有一次 TLS 读取和判空
+thread_local ThreadBuffer* t_buffer = nullptr;
+thread_local bool t_exiting = false;
+
+// 线程退出时把缓冲交还空闲表。缓冲只换主、不释放，已有线程数的上限即缓冲数的上限，
+// 短生命周期线程（流水线、回放、C ABI 调用方）反复创建也不会累积
+struct BufferRelease {
+    ~BufferRelease() {
+        t_exiting = true;
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.free_buffers.push_back(t_buffer);
+        t_buffer = nullptr;
+    }
+};
+
+ThreadBuffer* AcquireBuffer() {
+    ThreadBuffer* buffer;
+    {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        if (!registry.free_buffers.empty()) {
+            buffer = registry.free_buffers.back();
+            registry.free_buffers.pop_back();
+        } else {
+            registry.buffers.push_back(std::make_shared<ThreadBuffer>());
+            buffer = registry.buffers.back().get();
+        }
+    }
+    // 退出过程中（其他线程局部对象析构时）的埋点取得的缓冲不再交还
+    if (!t_exiting) {
+        thread_local BufferRelease release;
+        (void)release;
+    }
+    return buffer;
+}
+
+ThreadBuffer& LocalBuffer() {
+    // 每线程首次埋点时取得一份缓冲，之后只访问线程局部指针
+    if (!t_buffer) t_buffer = AcquireBuffer();
+    return *t_buffer;
+}
+
+void Push(const char* message, float a, float b, uint32_t nargs) {
+    ThreadBuffer& buffer = LocalBuffer();   // 先注册，保证时间基准早于事件
+    if (!buffer.ring.tryPush({Instrumentation::NowNs(), message, a, b, nargs})) {
+        buffer.add(Counter::TraceDropped, 1);
+    }
+}
+
+void WriteEvent(FILE* sink, uint64_t start_ns, const TraceEvent& e) {
+    const double t = e.timestamp_ns > start_ns ? (e.timestamp_ns - start_ns) * 1e-9 : 0.0;
+    switch (e.nargs) {
+    case 0:  std::fprintf(sink, "[%10.3f] %s\n", t, e.message); break;
+    case 1:  std::fprintf(sink, "[%10.3f] %s: %g\n", t, e.message, e.a); break;
+    default: std::fprintf(sink, "[%10.3f] %s: %g, %g\n", t, e.message, e.a, e.b); break;
+    }
+}
+
+std::vector<std::shared_ptr<ThreadBuffer>> Buffers(Registry& registry) {
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.buffers;
+}
+
+// 取出全部线程的消息并输出
+void Drain(Registry& registry, FILE* sink) {
+    const auto buffers = Buffers(registry);
+    std::lock_guard<std::mutex> lock(registry.drain_mutex);
+    for (const auto& buffer : buffers) {
+        TraceEvent e;
+        while (buffer->ring.tryPop(e)) {
+            if (sink) WriteEvent(sink, registry.start_ns, e);
+        }
+    }
+}
+
+// 输出自上次报告以来有变化的阶段耗时与计数器
+void Report(Registry& registry, FILE* sink) {
+    if (!sink) return;
+    std::lock_guard<std::mutex> lock(registry.drain_mutex);
+    for (size_t i = 0; i < kStageCount; ++i) {
+        const StageStats s = Instrumentation::GetStageStats(static_cast<Stage>(i));
+        if (s.count == registry.reported_stages[i]) continue;
+        registry.reported_stages[i] = s.count;
+        std::fprintf(sink, "[stage] %-12s n=%llu mean=%.1fns max=%lluns\n",
+                     kStageNames[i], static_cast<unsigned long long>(s.count),
+                     static_cast<double>(s.total_ns) / s.count,
+                     static_cast<unsigned long long>(s.max_ns));
+    }
+    for (size_t i = 0; i < kCounterCount; ++i) {
+        const uint64_t value = Instrumentation::CounterValue(static_cast<Counter>(i));
+        if (value == registry.reported_counters[i]) continue;
+        registry.reported_counters[i] = value;
+        std::fprintf(sink, "[count] %s=%llu\n", kCounterNames[i],
+                     static_cast<unsigned long long>(value));
+    }
+    std::fflush(sink);
+}
+
+} // namespace
+
+std::atomic<bool> Instrumentation::timing_enabled_{false};
+
+void Instrumentation::StartExporter(FILE* sink, std::chrono::milliseconds interval) {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.exporter_mutex);
+    if (registry.exporter_running) return;
+    registry.exporter_running = true;
+    registry.sink = sink;
+    registry.exporter = std::thread([&registry, sink, interval] {
+        std::unique_lock<std::mutex> lock(registry.exporter_mutex);
+        while (registry.exporter_running) {
+            registry.exporter_cv.wait_for(lock, interval);
+            lock.unlock();
+            Drain(registry, sink);
+            Report(registry, sink);
+            lock.lock();
+        }
+    });
+}
+
+void Instrumentation::StopExporter() {
+    Registry& registry = GetRegistry();
+    std::thread exporter;
+    {
+        std::lock_guard<std::mutex> lock(registry.exporter_mutex);
+        if (!registry.exporter_running) return;
+        registry.exporter_running = false;
+        exporter = std::move(registry.exporter);
+    }
+    registry.exporter_cv.notify_all();
+    if (exporter.joinable()) exporter.join();
+}
+
+void Instrumentation::SetTimingEnabled(bool enabled) {
+    timing_enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void Instrumentation::Count(Counter counter, uint64_t n) {
+    LocalBuffer().add(counter, n);
+}
+
+void Instrumentation::RecordStage(Stage stage, uint64_t ns) {
+    StageSlot& slot = LocalBuffer().stages[static_cast<size_t>(stage)];
+    Add(slot.count, 1);
+    Add(slot.total_ns, ns);
+    if (ns > slot.max_ns.load(std::memory_order_relaxed)) {
+        slot.max_ns.store(ns, std::memory_order_relaxed);
+    }
+}
+
+void Instrumentation::Log(const char* message) {
+    Push(message, 0.0f, 0.0f, 0);
+}
+
+void Instrumentation::Log(const char* message, float a) {
+    Push(message, a, 0.0f, 1);
+}
+
+void Instrumentation::Log(const char* message, float a, float b) {
+    Push(message, a, b, 2);
+}
+
+size_t Instrumentation::ThreadBufferCount() {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.buffers.size();
+}
+
+uint64_t Instrumentation::CounterValue(Counter counter) {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    uint64_t total = 0;
+    for (const auto& buffer : registry.buffers) {
+        total += buffer->counters[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+StageStats Instrumentation::GetStageStats(Stage stage) {
+    StageStats stats;
+    for (const auto& buffer : Buffers(GetRegistry())) {
+        const StageSlot& slot = buffer->stages[static_cast<size_t>(stage)];
+        stats.count += slot.count.load(std::memory_order_relaxed);
+        stats.total_ns += slot.total_ns.load(std::memory_order_relaxed);
+        stats.max_ns = std::max(stats.max_ns, slot.max_ns.load(std::memory_order_relaxed));
+    }
+    return stats;
+}
+
+void Instrumentation::Flush() {
+    Registry& registry = GetRegistry();
+    FILE* sink;
+    {
+        std::lock_guard<std::mutex> lock(registry.exporter_mutex);
+        sink = registry.sink;
+    }
+    Drain(registry, sink);
+    Report(registry, sink);
+}
@@ -0,0 +1,95 @@
+#include "camera/PlayerFilter.hpp"
+#include "camera/StateBuffer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// 正态分布下 1.4826 * MAD 为标准差的一致估计，超过 3 倍视为离群
+constexpr float kMadScale = 1.4826f;
+constexpr float kMadCutoff = 3.0f;
+// 跳变持续这么多帧后视为真实转移（镜头切换、攻防转换）而非误检
+constexpr int kJumpConfirmFrames = 3;
+// 样本太少时中位数 / MAD 没有意义，全部保留
+constexpr size_t kMinRobustCount = 3;
+
+// 偶数个样本取两个中间值的均值；只重排 values[0, n)
+float Median(float* values, size_t n) {
+    float* mid = values + n / 2;
+    std::nth_element(values, mid, values + n);
+    const float upper = *mid;
+    if (n % 2) return upper;
+    const float lower = *std::max_element(values, mid);
+    return 0.5f * (lower + upper);
+}
+} // namespace
+
+PlayerFilter::PlayerFilter(const ConfigManager::Params::SafetyParams& params, size_t capacity)
+    : params_(params),
+      xs_(capacity),
+      deviations_(capacity),
+      survivors_(capacity) {}
+
+void PlayerFilter::reset() {
+    has_reference_ = false;
+    jump_frames_ = 0;
+}
+
+PlayerFilter::Result PlayerFilter::filter(Span<const Point> players) {
+    Result result{};
+    const size_t n = std::min(players.size(), xs_.size());
+    const float* survivors = xs_.data();
+    size_t kept = n;
+
+    for (size_t i = 0; i < n; ++i) xs_[i] = players[i].x;
+
+    if (n >= kMinRobustCount) {
+        const float median = Median(xs_.data(), n);
+        for (size_t i = 0; i < n; ++i) deviations_[i] = std::fabs(xs_[i] - median);
+        const float mad = Median(deviations_.data(), n);
+        const float limit = std::max(kMadCutoff * kMadScale * mad,
+                                     static_cast<float>(params_.noise_threshold));
+
+        // xs_ 已被重排，按原始顺序重新筛选
+        kept = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const float x = players[i].x;
+            if (std::fabs(x - median) <= limit) survivors_[kept++] = x;
+        }
+        survivors = survivors_.data();
+        result.rejected = n - kept;
+    }
+
+    result.survivors = Span<const float>(survivors, kept);
+
+    if (kept == 0 || kept < static_cast<size_t>(std::max(params_.min_players, 0))) {
+        result.held = true;
+        return result;
+    }
+
+    result.stats = ReducePlayerX(survivors, kept);
+
+    // 跳变检测：单帧跳变先保持，持续 kJumpConfirmFrames 帧才接受为新位置
+    const float mean = result.stats.mean();
+    if (has_reference_ && std::fabs(mean - reference_mean_) > params_.noise_threshold) {
+        if (++jump_frames_ < kJumpConfirmFrames) {
+            result.held = true;
+            return result;
+        }
+    }
+    jump_frames_ = 0;
+    has_reference_ = true;
+    reference_mean_ = mean;
+    return result;
+}
+
+void PlayerFilter::saveState(StateWriter& out) const {
+    out.put<uint8_t>(has_reference_);
+    out.put(reference_mean_);
+    out.put<int32_t>(jump_frames_);
+}
+
+void PlayerFilter::loadState(StateReader& in) {
+    has_reference_ = in.get<uint8_t>() != 0;
+    reference_mean_ = in.get<float>();
+    jump_frames_ = in.get<int32_t>();
+}
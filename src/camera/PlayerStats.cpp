@@ -0,0 +1,231 @@
+#include "camera/PlayerStats.hpp"
+#include <limits>
+
+#if defined(__x86_64__)
+#define CAMERA_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr size_t kLanes = 8;
+
+// 与 _mm_min_ps/_mm_max_ps 的操作数语义一致：比较失败时取第二个操作数
+inline float MinOp(float a, float b) { return a < b ? a : b; }
+inline float MaxOp(float a, float b) { return a > b ? a : b; }
+
+// 8 路结果按 AVX2 水平归约的顺序合并：(l + l+4)，再 (0,2)(1,3)，最后 0+1
+template <typename Op>
+inline float CombineLanes(const float* l, Op op) {
+    const float s0 = op(l[0], l[4]);
+    const float s1 = op(l[1], l[5]);
+    const float s2 = op(l[2], l[6]);
+    const float s3 = op(l[3], l[7]);
+    return op(op(s0, s2), op(s1, s3));
+}
+
+inline PlayerStats Finish(const float* sum, const float* mn, const float* mx,
+                          size_t count, bool has_lanes) {
+    PlayerStats stats{0.0f,
+                      std::numeric_limits<float>::infinity(),
+                      -std::numeric_limits<float>::infinity(),
+                      count};
+    if (has_lanes) {
+        stats.sum = CombineLanes(sum, [](float a, float b) { return a + b; });
+        stats.min = CombineLanes(mn, MinOp);
+        stats.max = CombineLanes(mx, MaxOp);
+    }
+    return stats;
+}
+
+inline void AccumulateTail(PlayerStats& stats, float x) {
+    stats.sum += x;
+    stats.min = MinOp(stats.min, x);
+    stats.max = MaxOp(stats.max, x);
+}
+
+// 标量参考实现，stride 为相邻 x 之间的 float 个数（SoA 为 1，Point 为 2）
+PlayerStats ReduceScalar(const float* xs, size_t count, size_t stride) {
+    const size_t body = count - count % kLanes;
+    float sum[kLanes], mn[kLanes], mx[kLanes];
+    if (body) {
+        for (size_t j = 0; j < kLanes; ++j) {
+            sum[j] = xs[j * stride];
+            mn[j] = mx[j] = xs[j * stride];
+        }
+        for (size_t i = kLanes; i < body; i += kLanes) {
+            for (size_t j = 0; j < kLanes; ++j) {
+                const float x = xs[(i + j) * stride];
+                sum[j] += x;
+                mn[j] = MinOp(mn[j], x);
+                mx[j] = MaxOp(mx[j], x);
+            }
+        }
+    }
+    PlayerStats stats = Finish(sum, mn, mx, count, body != 0);
+    for (size_t i = body; i < count; ++i) AccumulateTail(stats, xs[i * stride]);
+    return stats;
+}
+
+#ifdef CAMERA_X86
+
+// 两个 __m128 组成 8 路：a 为 lane 0-3，b 为 lane 4-7
+inline PlayerStats FinishSse(__m128 sum_a, __m128 sum_b, __m128 mn_a, __m128 mn_b,
+                             __m128 mx_a, __m128 mx_b, size_t count) {
+    alignas(16) float sum[kLanes], mn[kLanes], mx[kLanes];
+    _mm_store_ps(sum, sum_a); _mm_store_ps(sum + 4, sum_b);
+    _mm_store_ps(mn, mn_a);   _mm_store_ps(mn + 4, mn_b);
+    _mm_store_ps(mx, mx_a);   _mm_store_ps(mx + 4, mx_b);
+    return Finish(sum, mn, mx, count, true);
+}
+
+PlayerStats ReduceSse(const float* xs, size_t count) {
+    const size_t body = count - count % kLanes;
+    if (!body) return ReduceScalar(xs, count, 1);
+
+    __m128 a = _mm_loadu_ps(xs), b = _mm_loadu_ps(xs + 4);
+    __m128 sum_a = a, sum_b = b, mn_a = a, mn_b = b, mx_a = a, mx_b = b;
+    for (size_t i = kLanes; i < body; i += kLanes) {
+        a = _mm_loadu_ps(xs + i);
+        b = _mm_loadu_ps(xs + i + 4);
+        sum_a = _mm_add_ps(sum_a, a); sum_b = _mm_add_ps(sum_b, b);
+        mn_a = _mm_min_ps(mn_a, a);   mn_b = _mm_min_ps(mn_b, b);
+        mx_a = _mm_max_ps(mx_a, a);   mx_b = _mm_max_ps(mx_b, b);
+    }
+    PlayerStats stats = FinishSse(sum_a, sum_b, mn_a, mn_b, mx_a, mx_b, count);
+    for (size_t i = body; i < count; ++i) AccumulateTail(stats, xs[i]);
+    return stats;
+}
+
+// 从 4 个 Point 中取出 x（x0 y0 x1 y1 | x2 y2 x3 y3 -> x0 x1 x2 x3）
+inline __m128 LoadPointXSse(const Point* p) {
+    const float* f = &p->x;
+    return _mm_shuffle_ps(_mm_loadu_ps(f), _mm_loadu_ps(f + 4), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+PlayerStats ReducePointsSse(const Point* points, size_t count) {
+    const size_t body = count - count % kLanes;
+    if (!body) return ReduceScalar(&points->x, count, 2);
+
+    __m128 a = LoadPointXSse(points), b = LoadPointXSse(points + 4);
+    __m128 sum_a = a, sum_b = b, mn_a = a, mn_b = b, mx_a = a, mx_b = b;
+    for (size_t i = kLanes; i < body; i += kLanes) {
+        a = LoadPointXSse(points + i);
+        b = LoadPointXSse(points + i + 4);
+        sum_a = _mm_add_ps(sum_a, a); sum_b = _mm_add_ps(sum_b, b);
+        mn_a = _mm_min_ps(mn_a, a);   mn_b = _mm_min_ps(mn_b, b);
+        mx_a = _mm_max_ps(mx_a, a);   mx_b = _mm_max_ps(mx_b, b);
+    }
+    PlayerStats stats = FinishSse(sum_a, sum_b, mn_a, mn_b, mx_a, mx_b, count);
+    for (size_t i = body; i < count; ++i) AccumulateTail(stats, points[i].x);
+    return stats;
+}
+
+__attribute__((target("avx2")))
+PlayerStats FinishAvx2(__m256 sum, __m256 mn, __m256 mx, size_t count) {
+    alignas(32) float s[kLanes], lo[kLanes], hi[kLanes];
+    _mm256_store_ps(s, sum);
+    _mm256_store_ps(lo, mn);
+    _mm256_store_ps(hi, mx);
+    return Finish(s, lo, hi, count, true);
+}
+
+__attribute__((target("avx2")))
+PlayerStats ReduceAvx2(const float* xs, size_t count) {
+    const size_t body = count - count % kLanes;
+    if (!body) return ReduceScalar(xs, count, 1);
+
+    __m256 v = _mm256_loadu_ps(xs);
+    __m256 sum = v, mn = v, mx = v;
+    for (size_t i = kLanes; i < body; i += kLanes) {
+        v = _mm256_loadu_ps(xs + i);
+        sum = _mm256_add_ps(sum, v);
+        mn = _mm256_min_ps(mn, v);
+        mx = _mm256_max_ps(mx, v);
+    }
+    PlayerStats stats = FinishAvx2(sum, mn, mx, count);
+    for (size_t i = body; i < count; ++i) AccumulateTail(stats, xs[i]);
+    return stats;
+}
+
+// 从 8 个 Point 中取出 x，并把 128 位通道内的乱序恢复为 x0..x7
+__attribute__((target("avx2")))
+inline __m256 LoadPointXAvx2(const Point* p) {
+    const float* f = &p->x;
+    const __m256 xy = _mm256_shuffle_ps(_mm256_loadu_ps(f), _mm256_loadu_ps(f + 8),
+                                        _MM_SHUFFLE(2, 0, 2, 0));
+    return _mm256_castpd_ps(
+        _mm256_permute4x64_pd(_mm256_castps_pd(xy), _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+__attribute__((target("avx2")))
+PlayerStats ReducePointsAvx2(const Point* points, size_t count) {
+    const size_t body = count - count % kLanes;
+    if (!body) return ReduceScalar(&points->x, count, 2);
+
+    __m256 v = LoadPointXAvx2(points);
+    __m256 sum = v, mn = v, mx = v;
+    for (size_t i = kLanes; i < body; i += kLanes) {
+        v = LoadPointXAvx2(points + i);
+        sum = _mm256_add_ps(sum, v);
+        mn = _mm256_min_ps(mn, v);
+        mx = _mm256_max_ps(mx, v);
+    }
+    PlayerStats stats = FinishAvx2(sum, mn, mx, count);
+    for (size_t i = body; i < count; ++i) AccumulateTail(stats, points[i].x);
+    return stats;
+}
+
+#endif // CAMERA_X86
+
+SimdLevel Resolve(SimdLevel level) {
+    const SimdLevel best = DetectSimdLevel();
+    return static_cast<int>(level) <= static_cast<int>(best) ? level : SimdLevel::Scalar;
+}
+
+} // namespace
+
+SimdLevel DetectSimdLevel() {
+#ifdef CAMERA_X86
+    static const SimdLevel level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+        if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE;
+        return SimdLevel::Scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+PlayerStats ReducePlayerX(const float* xs, size_t count, SimdLevel level) {
+    if (count == 0) return ReduceScalar(nullptr, 0, 1);
+    switch (Resolve(level)) {
+#ifdef CAMERA_X86
+    case SimdLevel::AVX2: return ReduceAvx2(xs, count);
+    case SimdLevel::SSE:  return ReduceSse(xs, count);
+#endif
+    default:              return ReduceScalar(xs, count, 1);
+    }
+}
+
+PlayerStats ReducePlayerX(const Point* points, size_t count, SimdLevel level) {
+    static_assert(sizeof(Point) == 2 * sizeof(float), "Point must be two packed floats");
+    if (count == 0) return ReduceScalar(nullptr, 0, 2);
+    switch (Resolve(level)) {
+#ifdef CAMERA_X86
+    case SimdLevel::AVX2: return ReducePointsAvx2(points, count);
+    case SimdLevel::SSE:  return ReducePointsSse(points, count);
+#endif
+    default:              return ReduceScalar(&points->x, count, 2);
+    }
+}
+
+PlayerStats ReducePlayerX(const float* xs, size_t count) {
+    return ReducePlayerX(xs, count, DetectSimdLevel());
+}
+
+PlayerStats ReducePlayerX(const Point* points, size_t count) {
+    return ReducePlayerX(points, count, DetectSimdLevel());
+}
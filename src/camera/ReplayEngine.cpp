@@ -0,0 +1,303 @@
+#include "camera/ReplayEngine.hpp"
+#include "camera/CameramanModel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+
+namespace {
+
+constexpr char kMagic[4] = {'C', 'M', 'R', 'C'};
+constexpr uint32_t kVersion = 1;
+
+const char* const kColumnNames[ReplayColumns::kColumnCount] = {
+    "target", "raw_target", "mean_player_pos", "ball_x", "camera_y", "fov"
+};
+
+struct FileCloser {
+    void operator()(FILE* f) const { if (f) std::fclose(f); }
+};
+using FilePtr = std::unique_ptr<FILE, FileCloser>;
+
+void ReadExact(FILE* f, void* dst, size_t bytes, const std::string& path) {
+    if (bytes && std::fread(dst, 1, bytes, f) != bytes) {
+        throw std::runtime_error("Truncated replay columns file: " + path);
+    }
+}
+
+void WriteExact(FILE* f, const void* src, size_t bytes, const std::string& path) {
+    if (bytes && std::fwrite(src, 1, bytes, f) != bytes) {
+        throw std::runtime_error("Failed to write replay columns file: " + path);
+    }
+}
+
+void WriteString(FILE* f, const std::string& s, const std::string& path) {
+    const uint32_t size = static_cast<uint32_t>(s.size());
+    WriteExact(f, &size, sizeof(size), path);
+    WriteExact(f, s.data(), s.size(), path);
+}
+
+std::string ReadString(FILE* f, const std::string& path) {
+    uint32_t size = 0;
+    ReadExact(f, &size, sizeof(size), path);
+    std::string s(size, '\0');
+    ReadExact(f, &s[0], size, path);
+    return s;
+}
+
+// 一个 (配置, 分段) 任务，输出帧区间为 [begin, end)
+struct Task {
+    size_t config;
+    size_t begin;
+    size_t end;
+};
+
+// 每个工作线程一个双端队列：所有者从头部顺序取（同一配置的相邻分段），
+// 窃取者从尾部取。任务在开始前全部入队，之后只出不进，全部队列为空即结束。
+// 单个任务为毫秒级的整段回放，队列加锁的开销可以忽略。
+class TaskQueues {
+public:
+    explicit TaskQueues(size_t workers) : queues_(workers) {}
+
+    void push(size_t worker, const Task& task) { queues_[worker].tasks.push_back(task); }
+
+    bool pop(size_t worker, Task& task) {
+        {
+            Queue& own = queues_[worker];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = own.tasks.front();
+                own.tasks.pop_front();
+                return true;
+            }
+        }
+        for (size_t i = 1; i < queues_.size(); ++i) {
+            Queue& victim = queues_[(worker + i) % queues_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.back();
+                victim.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+    std::vector<Queue> queues_;
+};
+
+float PredictFrame(CameramanModel& model, const DetectionTrace& trace, size_t f, bool timestamps) {
+    if (!timestamps) return model.predict(trace.framePlayers(f), trace.frameBalls(f));
+    return model.predict(trace.framePlayers(f), trace.frameBalls(f), trace.frames[f].timestamp_us);
+}
+
+void RunTask(const Task& task, const ConfigManager& config, const DetectionTrace& trace,
+             const ReplayOptions& options, ReplayColumns& out) {
+    CameramanModel model(config);
+    const size_t warmup = options.warmup_frames;
+    const size_t start = task.begin > warmup ? task.begin - warmup : 0;
+    for (size_t f = start; f < task.begin; ++f) {
+        PredictFrame(model, trace, f, options.timestamps);
+    }
+
+    float* target = out.column(ReplayColumns::Target, task.config);
+    float* raw_target = out.column(ReplayColumns::RawTarget, task.config);
+    float* mean_pos = out.column(ReplayColumns::MeanPlayerPos, task.config);
+    float* ball_x = out.column(ReplayColumns::BallX, task.config);
+    float* camera_y = out.column(ReplayColumns::CameraY, task.config);
+    float* fov = out.column(ReplayColumns::Fov, task.config);
+    for (size_t f = task.begin; f < task.end; ++f) {
+        target[f] = PredictFrame(model, trace, f, options.timestamps);
+        std::tie(camera_y[f], fov[f]) = model.transfer(target[f]);
+        const auto& info = model.getDebugInfo();
+        raw_target[f] = info->raw_target;
+        mean_pos[f] = info->mean_player_pos;
+        ball_x[f] = info->ball_x;
+    }
+}
+
+} // namespace
+
+const char* ReplayColumns::ColumnName(Column column) {
+    return column < kColumnCount ? kColumnNames[column] : "unknown";
+}
+
+void ReplayColumns::save(const std::string& path) const {
+    FilePtr f(std::fopen(path.c_str(), "wb"));
+    if (!f) throw std::runtime_error("Cannot open replay columns file: " + path);
+    const uint64_t frame_count = frames;
+    const uint32_t config_count = static_cast<uint32_t>(configs.size());
+    const uint32_t column_count = kColumnCount;
+    WriteExact(f.get(), kMagic, sizeof(kMagic), path);
+    WriteExact(f.get(), &kVersion, sizeof(kVersion), path);
+    WriteExact(f.get(), &frame_count, sizeof(frame_count), path);
+    WriteExact(f.get(), &config_count, sizeof(config_count), path);
+    WriteExact(f.get(), &column_count, sizeof(column_count), path);
+    for (const auto& name : configs) WriteString(f.get(), name, path);
+    for (const char* name : kColumnNames) WriteString(f.get(), name, path);
+    for (const auto& column : columns) {
+        WriteExact(f.get(), column.data(), column.size() * sizeof(float), path);
+    }
+    if (std::fflush(f.get()) != 0) {
+        throw std::runtime_error("Failed to write replay columns file: " + path);
+    }
+}
+
+ReplayColumns ReplayColumns::Load(const std::string& path) {
+    FilePtr f(std::fopen(path.c_str(), "rb"));
+    if (!f) throw std::runtime_error("Cannot open replay columns file: " + path);
+    char magic[4];
+    uint32_t version = 0;
+    uint64_t frame_count = 0;
+    uint32_t config_count = 0;
+    uint32_t column_count = 0;
+    ReadExact(f.get(), magic, sizeof(magic), path);
+    ReadExact(f.get(), &version, sizeof(version), path);
+    if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || version != kVersion) {
+        throw std::runtime_error("Unsupported replay columns file: " + path);
+    }
+    ReadExact(f.get(), &frame_count, sizeof(frame_count), path);
+    ReadExact(f.get(), &config_count, sizeof(config_count), path);
+    ReadExact(f.get(), &column_count, sizeof(column_count), path);
+    if (column_count != kColumnCount) {
+        throw std::runtime_error("Unexpected column count in replay columns file: " + path);
+    }
+
+    ReplayColumns result;
+    result.frames = static_cast<size_t>(frame_count);
+    for (uint32_t i = 0; i < config_count; ++i) result.configs.push_back(ReadString(f.get(), path));
+    for (uint32_t i = 0; i < column_count; ++i) {
+        if (ReadString(f.get(), path) != kColumnNames[i]) {
+            throw std::runtime_error("Unexpected column in replay columns file: " + path);
+        }
+    }
+    for (auto& column : result.columns) {
+        column.resize(result.frames * config_count);
+        ReadExact(f.get(), column.data(), column.size() * sizeof(float), path);
+    }
+    return result;
+}
+
+ReplayColumns RunReplay(const DetectionTrace& trace,
+                        const std::vector<ReplayConfig>& configs,
+                        const ReplayOptions& options) {
+    if (configs.empty()) throw std::invalid_argument("RunReplay needs at least one config");
+
+    // 每个配置一个固定快照实例，构造时校验参数；任务线程只读
+    std::vector<std::unique_ptr<ConfigManager>> managers;
+    for (const auto& config : configs) {
+        managers.push_back(std::make_unique<ConfigManager>(config.params));
+    }
+
+    ReplayColumns result;
+    result.frames = trace.size();
+    for (const auto& config : configs) result.configs.push_back(config.name);
+    for (auto& column : result.columns) column.assign(result.frames * configs.size(), 0.0f);
+    if (trace.size() == 0) return result;
+
+    const size_t segment = options.segment_frames ? options.segment_frames : trace.size();
+    std::vector<Task> tasks;
+    for (size_t c = 0; c < configs.size(); ++c) {
+        for (size_t begin = 0; begin < trace.size(); begin += segment) {
+            tasks.push_back({c, begin, std::min(begin + segment, trace.size())});
+        }
+    }
+
+    size_t workers = options.threads ? options.threads : std::thread::hardware_concurrency();
+    workers = std::max<size_t>(1, std::min(workers, tasks.size()));
+
+    // 按配置顺序切成连续块分给各线程，线程先处理自己的块，做完再窃取
+    TaskQueues queues(workers);
+    for (size_t i = 0; i < tasks.size(); ++i) queues.push(i * workers / tasks.size(), tasks[i]);
+
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    auto work = [&](size_t worker) {
+        Task task;
+        while (queues.pop(worker, task)) {
+            try {
+                RunTask(task, *managers[task.config], trace, options, result);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t w = 1; w < workers; ++w) threads.emplace_back(work, w);
+    work(0);
+    for (auto& thread : threads) thread.join();
+    if (error) std::rethrow_exception(error);
+    return result;
+}
+
+void SetSweepParam(ConfigManager::Params& params, const std::string& key, double value) {
+    const float v = static_cast<float>(value);
+    const int i = static_cast<int>(std::lround(value));
+    auto kalman = [&](ConfigManager::Params::KalmanParams& k, const std::string& name) {
+        if (name == "variance_position") k.variance_position = v;
+        else if (name == "variance_measurement") k.variance_measurement = v;
+        else if (name == "process_noise") k.process_noise = v;
+        else return false;
+        return true;
+    };
+
+    const auto dot = key.find('.');
+    const std::string section = key.substr(0, dot);
+    const std::string name = dot == std::string::npos ? std::string() : key.substr(dot + 1);
+    bool ok = true;
+    if (section == "kalman" && name.rfind("base.", 0) == 0) {
+        ok = kalman(params.base, name.substr(5));
+    } else if (section == "kalman" && name.rfind("slider.", 0) == 0) {
+        ok = kalman(params.slider, name.substr(7));
+    } else if (section == "camera") {
+        auto& c = params.camera;
+        if (name == "memory_length") c.memory_length = v;
+        else if (name == "speed_max") c.speed_max = v;
+        else if (name == "buffer_pixels") c.buffer_pixels = i;
+        else if (name == "position_merge_ratio") c.position_merge_ratio = v;
+        else if (name == "speed_slider_gain") c.speed_slider_gain = v;
+        else ok = false;
+    } else if (section == "safety") {
+        auto& s = params.safety;
+        if (name == "noise_threshold") s.noise_threshold = i;
+        else if (name == "min_players") s.min_players = i;
+        else if (name == "boundary_margin") s.boundary_margin = i;
+        else if (name == "ball_loft_margin") s.ball_loft_margin = i;
+        else ok = false;
+    } else if (section == "ball_tracker") {
+        auto& b = params.ball_tracker;
+        if (name == "gate_pixels") b.gate_pixels = v;
+        else if (name == "confirm_hits") b.confirm_hits = i;
+        else if (name == "max_misses") b.max_misses = i;
+        else if (name == "accel_noise") b.accel_noise = v;
+        else if (name == "measurement_noise") b.measurement_noise = v;
+        else if (name == "player_affinity") b.player_affinity = v;
+        else ok = false;
+    } else if (section == "target_filter") {
+        auto& t = params.target_filter;
+        if (name == "process_noise") t.process_noise = v;
+        else if (name == "lead_ms") t.lead_ms = v;
+        else ok = false;
+    } else if (section == "focus") {
+        auto& f = params.focus;
+        if (name == "bins") f.bins = static_cast<uint32_t>(i);
+        else if (name == "window_pixels") f.window_pixels = v;
+        else ok = false;
+    } else {
+        ok = false;
+    }
+    if (!ok) throw std::invalid_argument("Unknown sweep parameter: " + key);
+}
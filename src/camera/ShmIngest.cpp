@@ -0,0 +1,66 @@
+#include "camera/ShmIngest.hpp"
+#include <thread>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define CAMERA_CPU_RELAX() _mm_pause()
+#else
+#define CAMERA_CPU_RELAX() ((void)0)
+#endif
+
+ShmIngest::ShmIngest(CameramanModel& model, const Options& options)
+    : model_(model),
+      options_(options),
+      detections_(options.detections, ShmMode::Create, options.detection_capacity),
+      commands_(options.commands, ShmMode::Create, options.command_capacity) {}
+
+size_t ShmIngest::poll() {
+    size_t count = 0;
+    while (const DetectionFrame* frame = detections_.peek()) {
+        // 直接读取共享内存中的槽位，release() 之前检测进程不会改写它
+        const float target = PredictDetectionFrame(model_, *frame);
+        const uint64_t sequence = frame->sequence;
+        const uint64_t timestamp_ns = frame->timestamp_ns;
+        detections_.release();
+        ++metrics_.processed;
+        ++count;
+
+        if (has_sequence_ && sequence > next_sequence_) {
+            metrics_.sequence_gaps += sequence - next_sequence_;
+        }
+        has_sequence_ = true;
+        next_sequence_ = sequence + 1;
+
+        // 输出环满说明云台进程停止读取，丢弃新指令而不阻塞检测链路
+        PtzCommand* command = commands_.acquire();
+        if (!command) {
+            ++metrics_.dropped_commands;
+            continue;
+        }
+        const auto [y, fov] = model_.transfer(target);
+        *command = PtzCommand{sequence, timestamp_ns, Instrumentation::NowNs(), target, y, fov, 1};
+        commands_.commit();
+        ++metrics_.emitted;
+    }
+    return count;
+}
+
+void ShmIngest::run(const std::atomic<bool>& stop) {
+    uint32_t idle = 0;
+    for (;;) {
+        if (poll()) {
+            idle = 0;
+            continue;
+        }
+        // 停止时先排空输入环再退出
+        if (stop.load(std::memory_order_acquire)) {
+            poll();
+            break;
+        }
+        if (++idle < options_.idle_spin) {
+            CAMERA_CPU_RELAX();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
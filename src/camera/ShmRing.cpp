@@ -0,0 +1,110 @@
+#include "camera/ShmRing.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kMagic[4] = {'C', 'M', 'S', 'R'};
+constexpr size_t kLine = 64;
+
+// 段头、head、tail 各占一个缓存行，槽位从第四个缓存行开始
+struct alignas(kLine) RingHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t slot_size;
+    uint32_t capacity;
+    std::atomic<uint32_t> ready;   // 创建者写完段头后置 1，打开者据此判断初始化完成
+};
+
+constexpr size_t kHeadOffset = kLine;
+constexpr size_t kTailOffset = 2 * kLine;
+constexpr size_t kSlotsOffset = 3 * kLine;
+
+static_assert(sizeof(RingHeader) == kLine, "ring header must fill one cache line");
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+              "ring indices must be lock-free atomics to live in shared memory");
+
+} // namespace
+
+ShmRingBase::ShmRingBase(const std::string& name, ShmMode mode, size_t slot_size, size_t capacity)
+    : name_(name),
+      owner_(mode == ShmMode::Create),
+      slot_size_(slot_size) {
+    if (name.size() < 2 || name[0] != '/' || name.find('/', 1) != std::string::npos) {
+        throw std::runtime_error("Shared-memory ring name must look like /name: " + name);
+    }
+    if (owner_ && (capacity < 2 || (capacity & (capacity - 1)) != 0 || capacity > UINT32_MAX)) {
+        throw std::runtime_error("Shared-memory ring capacity must be a power of two: " + name);
+    }
+
+    int fd = -1;
+    if (owner_) {
+        // 上次运行崩溃留下的旧段直接删除，对端须在创建之后打开
+        shm_unlink(name.c_str());
+        fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        if (fd < 0) throw std::runtime_error("Cannot create shared-memory ring: " + name);
+        mapped_size_ = kSlotsOffset + capacity * slot_size;
+        if (ftruncate(fd, static_cast<off_t>(mapped_size_)) != 0) {
+            close(fd);
+            shm_unlink(name.c_str());
+            throw std::runtime_error("Cannot size shared-memory ring: " + name);
+        }
+    } else {
+        fd = shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0);
+        if (fd < 0) throw std::runtime_error("Shared-memory ring does not exist: " + name);
+        struct stat st;
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < kSlotsOffset) {
+            close(fd);
+            throw std::runtime_error("Shared-memory ring is not initialized: " + name);
+        }
+        mapped_size_ = static_cast<size_t>(st.st_size);
+    }
+
+    void* p = mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);   // 映射保持段的引用
+    if (p == MAP_FAILED) {
+        if (owner_) shm_unlink(name.c_str());
+        throw std::runtime_error("Cannot map shared-memory ring: " + name);
+    }
+    mapping_ = p;
+    auto* base = static_cast<uint8_t*>(p);
+    auto* header = reinterpret_cast<RingHeader*>(base);
+    head_ = reinterpret_cast<std::atomic<uint64_t>*>(base + kHeadOffset);
+    tail_ = reinterpret_cast<std::atomic<uint64_t>*>(base + kTailOffset);
+    slots_ = base + kSlotsOffset;
+
+    if (owner_) {
+        // ftruncate 已把段清零，head/tail 均为 0
+        std::memcpy(header->magic, kMagic, sizeof(kMagic));
+        header->version = kFormatVersion;
+        header->slot_size = static_cast<uint32_t>(slot_size);
+        header->capacity = static_cast<uint32_t>(capacity);
+        header->ready.store(1, std::memory_order_release);
+    } else {
+        const bool ok = header->ready.load(std::memory_order_acquire) == 1 &&
+                        std::memcmp(header->magic, kMagic, sizeof(kMagic)) == 0 &&
+                        header->version == kFormatVersion &&
+                        header->slot_size == slot_size &&
+                        header->capacity >= 2 && (header->capacity & (header->capacity - 1)) == 0 &&
+                        kSlotsOffset + size_t{header->capacity} * slot_size <= mapped_size_;
+        if (!ok) {
+            munmap(mapping_, mapped_size_);
+            throw std::runtime_error("Unsupported or uninitialized shared-memory ring: " + name);
+        }
+        capacity = header->capacity;
+    }
+    mask_ = capacity - 1;
+
+    // 打开已在使用的段时从当前位置接续
+    cached_head_ = head_->load(std::memory_order_acquire);
+    cached_tail_ = tail_->load(std::memory_order_acquire);
+}
+
+ShmRingBase::~ShmRingBase() {
+    if (mapping_) munmap(mapping_, mapped_size_);
+    if (owner_) shm_unlink(name_.c_str());
+}
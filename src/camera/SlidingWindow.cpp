@@ -0,0 +1,178 @@
+#include "camera/SlidingWindow.hpp"
+#include "camera/StateBuffer.hpp"
+#include <stdexcept>
+
+void SlidingWindow::MonotonicQueue::reset(size_t capacity) {
+    slots.assign(capacity, 0);
+    head = 0;
+    size = 0;
+}
+
+void SlidingWindow::reset(size_t capacity, float initial) {
+    if (capacity == 0) {
+        throw std::invalid_argument("SlidingWindow capacity must be > 0");
+    }
+    values_.assign(capacity, initial);
+    times_.clear();
+    horizon_us_ = 0;
+    min_queue_.reset(capacity);
+    max_queue_.reset(capacity);
+    head_ = 0;
+    size_ = 0;
+    pushes_since_sum_ = 0;
+    sum_ = 0.0;
+    for (size_t i = 0; i < capacity; ++i) {
+        push(initial);
+    }
+}
+
+void SlidingWindow::reset(size_t capacity, float initial, uint64_t horizon_us, uint64_t timestamp_us) {
+    if (capacity < 2) {
+        throw std::invalid_argument("Timed SlidingWindow capacity must be >= 2");
+    }
+    if (horizon_us == 0) {
+        throw std::invalid_argument("SlidingWindow horizon must be > 0");
+    }
+    values_.assign(capacity, initial);
+    times_.assign(capacity, timestamp_us);
+    horizon_us_ = horizon_us;
+    min_queue_.reset(capacity);
+    max_queue_.reset(capacity);
+    head_ = 0;
+    size_ = 0;
+    pushes_since_sum_ = 0;
+    sum_ = 0.0;
+    append(initial);
+}
+
+void SlidingWindow::popOldest() {
+    sum_ -= values_[head_];
+    if (min_queue_.size && min_queue_.front() == head_) min_queue_.popFront();
+    if (max_queue_.size && max_queue_.front() == head_) max_queue_.popFront();
+    head_ = wrap(head_ + 1);
+    --size_;
+}
+
+void SlidingWindow::append(float value) {
+    // 调用方保证窗口未满
+    const size_t slot = wrap(head_ + size_);
+    ++size_;
+    values_[slot] = value;
+    sum_ += value;
+
+    while (min_queue_.size && values_[min_queue_.back()] >= value) min_queue_.popBack();
+    min_queue_.pushBack(static_cast<uint32_t>(slot));
+    while (max_queue_.size && values_[max_queue_.back()] <= value) max_queue_.popBack();
+    max_queue_.pushBack(static_cast<uint32_t>(slot));
+
+    // 每入队一个容量的样本重新求和一次，抵消增减累积的浮点误差（均摊 O(1)）
+    if (++pushes_since_sum_ == values_.size()) {
+        pushes_since_sum_ = 0;
+        recomputeSum();
+    }
+}
+
+void SlidingWindow::push(float value) {
+    if (values_.empty()) return;
+    // 窗口已满时淘汰最旧样本
+    if (size_ == values_.size()) popOldest();
+    append(value);
+}
+
+void SlidingWindow::push(float value, uint64_t timestamp_us) {
+    if (values_.empty()) return;
+    if (size_ == values_.size()) popOldest();
+    // 新样本入队后与最旧样本相距达到 horizon 的样本出队，保留至少两个样本供求速度
+    while (size_ >= 2 && timestamp_us - times_[head_] >= horizon_us_) popOldest();
+    times_[wrap(head_ + size_)] = timestamp_us;
+    append(value);
+}
+
+void SlidingWindow::recomputeSum() {
+    double sum = 0.0;
+    for (size_t i = 0, slot = head_; i < size_; ++i, slot = wrap(slot + 1)) sum += values_[slot];
+    sum_ = sum;
+}
+
+float SlidingWindow::front() const {
+    if (size_ == 0) return 0.0f;
+    return values_[head_];
+}
+
+float SlidingWindow::back() const {
+    if (size_ == 0) return 0.0f;
+    return values_[newest()];
+}
+
+uint64_t SlidingWindow::duration() const {
+    if (!timed() || size_ == 0) return 0;
+    return times_[newest()] - times_[head_];
+}
+
+float SlidingWindow::mean() const {
+    if (size_ == 0) return 0.0f;
+    return static_cast<float>(sum_ / static_cast<double>(size_));
+}
+
+float SlidingWindow::min() const {
+    if (min_queue_.size == 0) return 0.0f;
+    return values_[min_queue_.front()];
+}
+
+float SlidingWindow::max() const {
+    if (max_queue_.size == 0) return 0.0f;
+    return values_[max_queue_.front()];
+}
+
+void SlidingWindow::saveState(StateWriter& out) const {
+    out.put<uint64_t>(values_.size());
+    out.put(horizon_us_);
+    out.put<uint64_t>(head_);
+    out.put<uint64_t>(size_);
+    out.put<uint64_t>(pushes_since_sum_);
+    out.put(sum_);
+    out.putArray(values_.data(), values_.size());
+    if (timed()) out.putArray(times_.data(), times_.size());
+    for (const MonotonicQueue* queue : {&min_queue_, &max_queue_}) {
+        out.put<uint64_t>(queue->head);
+        out.put<uint64_t>(queue->size);
+        out.putArray(queue->slots.data(), queue->slots.size());
+    }
+}
+
+void SlidingWindow::loadState(StateReader& in) {
+    const size_t capacity = static_cast<size_t>(in.get<uint64_t>());
+    if (capacity == 0 || capacity > in.remaining()) {
+        throw std::runtime_error("Invalid SlidingWindow capacity in state snapshot");
+    }
+    horizon_us_ = in.get<uint64_t>();
+    head_ = static_cast<size_t>(in.get<uint64_t>());
+    size_ = static_cast<size_t>(in.get<uint64_t>());
+    pushes_since_sum_ = static_cast<size_t>(in.get<uint64_t>());
+    sum_ = in.get<double>();
+    if (head_ >= capacity || size_ > capacity || pushes_since_sum_ >= capacity) {
+        throw std::runtime_error("Invalid SlidingWindow ring in state snapshot");
+    }
+    values_.resize(capacity);
+    in.getArray(values_.data(), capacity);
+    if (timed()) {
+        times_.resize(capacity);
+        in.getArray(times_.data(), capacity);
+    } else {
+        times_.clear();
+    }
+    for (MonotonicQueue* queue : {&min_queue_, &max_queue_}) {
+        queue->head = static_cast<size_t>(in.get<uint64_t>());
+        queue->size = static_cast<size_t>(in.get<uint64_t>());
+        queue->slots.resize(capacity);
+        in.getArray(queue->slots.data(), capacity);
+        if (queue->head >= capacity || queue->size > capacity) {
+            throw std::runtime_error("Invalid SlidingWindow queue in state snapshot");
+        }
+        for (size_t i = 0; i < capacity; ++i) {
+            if (queue->slots[i] >= capacity) {
+                throw std::runtime_error("Invalid SlidingWindow queue in state snapshot");
+            }
+        }
+    }
+}
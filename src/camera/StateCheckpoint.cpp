@@ -0,0 +1,164 @@
+#include "camera/StateCheckpoint.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kMagic[4] = {'C', 'M', 'S', 'K'};
+constexpr size_t kAlign = 64;
+constexpr size_t kSlotCount = 2;
+// 读到正在改写的槽位时的重试次数，写入只需微秒级，超过即视为写入进程已崩溃
+constexpr int kReadRetries = 64;
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t capacity;
+};
+
+size_t AlignUp(size_t n) {
+    return (n + kAlign - 1) / kAlign * kAlign;
+}
+
+uint64_t Fnv1a(const uint8_t* data, size_t size) {
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+// 槽位头独占一个缓存行，快照数据紧随其后。
+// seq：0 表示从未写入，奇数表示正在写入，偶数 2n 表示第 n 次写入已完成
+struct alignas(kAlign) StateCheckpoint::Slot {
+    std::atomic<uint64_t> seq;
+    uint64_t size;
+    uint64_t checksum;
+
+    uint8_t* data() { return reinterpret_cast<uint8_t*>(this) + kAlign; }
+};
+
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t) &&
+              std::atomic<uint64_t>::is_always_lock_free,
+              "checkpoint sequence must be a lock-free 64-bit atomic to live in shared memory");
+
+StateCheckpoint::StateCheckpoint(const std::string& path, size_t capacity)
+    : capacity_(capacity),
+      slot_stride_(kAlign + AlignUp(capacity)) {
+    if (capacity == 0) {
+        throw std::invalid_argument("StateCheckpoint capacity must be > 0");
+    }
+    mapped_size_ = kAlign + kSlotCount * slot_stride_;
+
+    fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw std::runtime_error("Cannot open state checkpoint: " + path);
+    }
+    struct stat st;
+    if (fstat(fd_, &st) != 0) {
+        close(fd_);
+        throw std::runtime_error("Cannot stat state checkpoint: " + path);
+    }
+    const bool created = st.st_size == 0;
+    if (created && ftruncate(fd_, static_cast<off_t>(mapped_size_)) != 0) {
+        close(fd_);
+        throw std::runtime_error("Cannot size state checkpoint: " + path);
+    }
+    if (!created && static_cast<size_t>(st.st_size) != mapped_size_) {
+        close(fd_);
+        throw std::runtime_error("State checkpoint capacity mismatch: " + path);
+    }
+
+    void* p = mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+        close(fd_);
+        throw std::runtime_error("Cannot map state checkpoint: " + path);
+    }
+    data_ = static_cast<char*>(p);
+
+    // 新建文件由 ftruncate 清零，槽位 seq 均为 0
+    FileHeader header;
+    if (created) {
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kFormatVersion;
+        header.capacity = capacity;
+        std::memcpy(data_, &header, sizeof(header));
+    } else {
+        std::memcpy(&header, data_, sizeof(header));
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+            header.version != kFormatVersion || header.capacity != capacity) {
+            munmap(data_, mapped_size_);
+            close(fd_);
+            throw std::runtime_error("Unsupported state checkpoint: " + path);
+        }
+    }
+    next_sequence_ = sequence() + 1;
+}
+
+StateCheckpoint::~StateCheckpoint() {
+    if (data_) munmap(data_, mapped_size_);
+    if (fd_ >= 0) close(fd_);
+}
+
+StateCheckpoint::Slot* StateCheckpoint::slot(size_t index) const {
+    return reinterpret_cast<Slot*>(data_ + kAlign + index * slot_stride_);
+}
+
+void StateCheckpoint::write(Span<const uint8_t> state) {
+    if (state.size() > capacity_) {
+        throw std::invalid_argument("State snapshot exceeds checkpoint capacity");
+    }
+    // 第 n 次写入使用槽位 n % 2，覆盖的总是较旧的快照
+    const uint64_t n = next_sequence_++;
+    Slot* s = slot(n % kSlotCount);
+    s->seq.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s->size = state.size();
+    s->checksum = Fnv1a(state.data(), state.size());
+    std::memcpy(s->data(), state.data(), state.size());
+    s->seq.store(2 * n, std::memory_order_release);
+}
+
+bool StateCheckpoint::read(std::vector<uint8_t>& out) const {
+    // 先尝试较新的槽位，失败（正在改写或校验不通过）再退回较旧的
+    Slot* slots[kSlotCount] = {slot(0), slot(1)};
+    if (slots[1]->seq.load(std::memory_order_acquire) / 2 >
+        slots[0]->seq.load(std::memory_order_acquire) / 2) {
+        std::swap(slots[0], slots[1]);
+    }
+    for (Slot* s : slots) {
+        for (int attempt = 0; attempt < kReadRetries; ++attempt) {
+            const uint64_t before = s->seq.load(std::memory_order_acquire);
+            if (before == 0) break;
+            if (before % 2) continue;
+            const size_t size = s->size;
+            const uint64_t checksum = s->checksum;
+            if (size > capacity_) break;
+            out.resize(size);
+            std::memcpy(out.data(), s->data(), size);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s->seq.load(std::memory_order_relaxed) != before) continue;
+            if (Fnv1a(out.data(), size) != checksum) break;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t StateCheckpoint::sequence() const {
+    uint64_t latest = 0;
+    for (size_t i = 0; i < kSlotCount; ++i) {
+        const uint64_t seq = slot(i)->seq.load(std::memory_order_acquire);
+        if (seq % 2 == 0) latest = std::max(latest, seq / 2);
+    }
+    return latest;
+}
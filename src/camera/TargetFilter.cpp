@@ -0,0 +1,160 @@
+#include "camera/TargetFilter.hpp"
+#include "camera/StateBuffer.hpp"
+
+namespace {
+// 首帧速度、加速度未知时的初始标准差
+constexpr float kInitialSpeedStd = 1000.0f;   // 像素/秒
+constexpr float kInitialAccelStd = 2000.0f;   // 像素/秒²
+
+template <typename Filter>
+Filter MakeFilter() {
+    typename Filter::ObservationMatrix H = Filter::ObservationMatrix::Zero();
+    H(0, 0) = 1.0f;
+    return Filter(Filter::State::Zero(),
+                  Filter::StateMatrix::Identity(),
+                  H,
+                  Filter::StateMatrix::Identity(),
+                  Filter::StateMatrix::Zero(),
+                  Filter::MeasurementMatrix::Identity());
+}
+} // namespace
+
+TargetFilter::TargetFilter(const ConfigManager::Params& params)
+    : cv_(MakeFilter<CV>()),
+      ca_(MakeFilter<CA>()) {
+    configure(params);
+}
+
+void TargetFilter::configure(const ConfigManager::Params& params) {
+    const auto& tf = params.target_filter;
+    if (tf.model != model_) {
+        model_ = tf.model;
+        initialized_ = false;
+    }
+    lead_s_ = tf.lead_ms * 0.001f;
+    q_ = tf.process_noise * tf.process_noise;
+    nominal_dt_ = 1.0f / static_cast<float>(params.camera.fps);
+
+    const float r = params.base.variance_measurement;
+    const float p0 = params.base.variance_position;
+    cv_P0_ << p0,   0.0f,
+              0.0f, kInitialSpeedStd * kInitialSpeedStd;
+    cv_.setMeasurementNoise(CV::MeasurementMatrix::Constant(r));
+    ca_P0_ << p0,   0.0f,                                0.0f,
+              0.0f, kInitialSpeedStd * kInitialSpeedStd, 0.0f,
+              0.0f, 0.0f,                                kInitialAccelStd * kInitialAccelStd;
+    ca_.setMeasurementNoise(CA::MeasurementMatrix::Constant(r));
+    setTimeStep(nominal_dt_);
+}
+
+void TargetFilter::setTimeStep(float dt) {
+    dt_ = dt;
+    const float dt2 = dt * dt, dt3 = dt2 * dt, dt4 = dt3 * dt, dt5 = dt4 * dt;
+    const float q = q_;
+
+    // 常速度：白噪声加速度
+    CV::StateMatrix F2, Q2;
+    F2 << 1.0f, dt,
+          0.0f, 1.0f;
+    Q2 << q * dt4 / 4.0f, q * dt3 / 2.0f,
+          q * dt3 / 2.0f, q * dt2;
+    cv_.setTransition(F2);
+    cv_.setProcessNoise(Q2);
+
+    // 常加速度：白噪声加加速度
+    CA::StateMatrix F3, Q3;
+    F3 << 1.0f, dt,   dt2 / 2.0f,
+          0.0f, 1.0f, dt,
+          0.0f, 0.0f, 1.0f;
+    Q3 << q * dt5 * dt / 36.0f, q * dt5 / 12.0f, q * dt4 / 6.0f,
+          q * dt5 / 12.0f,      q * dt4 / 4.0f,  q * dt3 / 2.0f,
+          q * dt4 / 6.0f,       q * dt3 / 2.0f,  q * dt2;
+    ca_.setTransition(F3);
+    ca_.setProcessNoise(Q3);
+}
+
+void TargetFilter::reset() {
+    initialized_ = false;
+}
+
+float TargetFilter::update(float measurement) {
+    return update(measurement, nominal_dt_);
+}
+
+float TargetFilter::update(float measurement, float dt) {
+    if (dt != dt_) setTimeStep(dt);
+    last_measurement_ = measurement;
+    switch (model_) {
+    case Model::ConstantVelocity: {
+        if (!initialized_) {
+            cv_.reset(CV::State(measurement, 0.0f), cv_P0_);
+            initialized_ = true;
+        } else {
+            cv_.predict();
+            cv_.update(CV::Measurement::Constant(measurement));
+        }
+        const auto& x = cv_.state();
+        return x(0) + x(1) * lead_s_;
+    }
+    case Model::ConstantAcceleration: {
+        if (!initialized_) {
+            ca_.reset(CA::State(measurement, 0.0f, 0.0f), ca_P0_);
+            initialized_ = true;
+        } else {
+            ca_.predict();
+            ca_.update(CA::Measurement::Constant(measurement));
+        }
+        const auto& x = ca_.state();
+        return x(0) + x(1) * lead_s_ + 0.5f * x(2) * lead_s_ * lead_s_;
+    }
+    default:
+        return measurement;
+    }
+}
+
+float TargetFilter::position() const {
+    switch (model_) {
+    case Model::ConstantVelocity:     return cv_.state()(0);
+    case Model::ConstantAcceleration: return ca_.state()(0);
+    default:                          return last_measurement_;
+    }
+}
+
+float TargetFilter::velocity() const {
+    switch (model_) {
+    case Model::ConstantVelocity:     return cv_.state()(1);
+    case Model::ConstantAcceleration: return ca_.state()(1);
+    default:                          return 0.0f;
+    }
+}
+
+float TargetFilter::acceleration() const {
+    return model_ == Model::ConstantAcceleration ? ca_.state()(2) : 0.0f;
+}
+
+void TargetFilter::saveState(StateWriter& out) const {
+    out.put(model_);
+    out.put<uint8_t>(initialized_);
+    out.put(last_measurement_);
+    out.putMatrix(cv_.state());
+    out.putMatrix(cv_.covariance());
+    out.putMatrix(ca_.state());
+    out.putMatrix(ca_.covariance());
+}
+
+void TargetFilter::loadState(StateReader& in) {
+    const Model model = in.get<Model>();
+    const bool initialized = in.get<uint8_t>() != 0;
+    last_measurement_ = in.get<float>();
+    CV::State cv_x;
+    CV::StateMatrix cv_P;
+    CA::State ca_x;
+    CA::StateMatrix ca_P;
+    in.getMatrix(cv_x);
+    in.getMatrix(cv_P);
+    in.getMatrix(ca_x);
+    in.getMatrix(ca_P);
+    cv_.reset(cv_x, cv_P);
+    ca_.reset(ca_x, ca_P);
+    initialized_ = initialized && model == model_;
+}
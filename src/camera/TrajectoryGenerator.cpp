@@ -0,0 +1,277 @@
+#include "camera/TrajectoryGenerator.hpp"
+#include "camera/Instrumentation.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <pthread.h>
+#include <sched.h>
+#include <stdexcept>
+#include <time.h>
+
+namespace {
+
+constexpr size_t kSlopeSamples = 64;
+
+// transfer 曲线在 [x_min, x_max] 上的最大斜率（按等距采样的差分估计），
+// 下限为平均斜率的 5%，曲线在某段接近水平时该轴仍能移动
+void MaxSlopes(const ConfigManager::Params::TransferParams& t, float& y_slope, float& fov_slope) {
+    const float width = t.x_max - t.x_min;
+    const float step = width / kSlopeSamples;
+    y_slope = 0.05f * std::fabs(t.y_max - t.y_min) / width;
+    fov_slope = 0.05f * std::fabs(t.fov_max - t.fov_min) / width;
+    auto [prev_y, prev_fov] = t.curve.evaluate(t.x_min);
+    for (size_t i = 1; i <= kSlopeSamples; ++i) {
+        const auto [y, fov] = t.curve.evaluate(t.x_min + step * i);
+        y_slope = std::max(y_slope, std::fabs(y - prev_y) / step);
+        fov_slope = std::max(fov_slope, std::fabs(fov - prev_fov) / step);
+        prev_y = y;
+        prev_fov = fov;
+    }
+}
+
+TrajectoryGenerator::AxisLimits Scale(const TrajectoryGenerator::AxisLimits& limits, float factor) {
+    return {limits.velocity * factor, limits.acceleration * factor, limits.jerk * factor};
+}
+
+uint64_t PeriodNs(double rate_hz) {
+    if (!(rate_hz > 0.0)) throw std::invalid_argument("Invalid control rate");
+    return static_cast<uint64_t>(1e9 / rate_hz);
+}
+
+void SleepUntil(uint64_t deadline_ns) {
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(deadline_ns / 1000000000u);
+    ts.tv_nsec = static_cast<long>(deadline_ns % 1000000000u);
+    // 与 steady_clock 同为 CLOCK_MONOTONIC；被信号打断时重新睡到同一时刻
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+}
+
+} // namespace
+
+TrajectoryGenerator::Limits TrajectoryGenerator::DeriveLimits(const ConfigManager::Params& params,
+                                                              const Options& options) {
+    if (!(options.accel_time > 0.0f) || !(options.jerk_time > 0.0f)) {
+        throw std::invalid_argument("Invalid trajectory accel_time/jerk_time");
+    }
+    if (!(params.camera.speed_max > 0.0f) || !(params.camera.speed_slider_gain > 0.0f)) {
+        throw std::invalid_argument("Invalid speed_max/speed_slider_gain");
+    }
+    if (!(params.transfer.x_max > params.transfer.x_min)) {
+        throw std::invalid_argument("Invalid transfer x range");
+    }
+
+    Limits limits;
+    limits.x.velocity = params.camera.speed_max * params.camera.speed_slider_gain;
+    limits.x.acceleration = limits.x.velocity / options.accel_time;
+    limits.x.jerk = limits.x.acceleration / options.jerk_time;
+
+    float y_slope, fov_slope;
+    MaxSlopes(params.transfer, y_slope, fov_slope);
+    limits.y = Scale(limits.x, y_slope);
+    limits.fov = Scale(limits.x, fov_slope);
+    return limits;
+}
+
+TrajectoryGenerator::TrajectoryGenerator(const Limits& limits, const Options& options)
+    : limits_(limits),
+      options_(options) {
+    for (const AxisLimits* axis : {&limits.x, &limits.y, &limits.fov}) {
+        if (!(axis->velocity > 0.0f) || !(axis->acceleration > 0.0f) || !(axis->jerk > 0.0f)) {
+            throw std::invalid_argument("Invalid trajectory limits");
+        }
+    }
+    if (!(options.response_time > 0.0f)) throw std::invalid_argument("Invalid trajectory response_time");
+    if (!(options.max_lead >= 0.0f)) throw std::invalid_argument("Invalid trajectory max_lead");
+
+    // 三重极点 -1/tau_a：s³ + s²/τa + s/(τa·τv) + 1/(τa·τv·τp) = (s + 1/τa)³ 要求 τv = 3τa、τp = 9τa
+    tau_p_ = options.response_time;
+    tau_v_ = tau_p_ / 3.0f;
+    tau_a_ = tau_p_ / 9.0f;
+    // 显式积分在步长不超过最快时间常数的 1/4 时稳定且与采样频率基本无关
+    max_step_ = tau_a_ / 4.0f;
+}
+
+TrajectoryGenerator::TrajectoryGenerator(const ConfigManager::Params& params, const Options& options)
+    : TrajectoryGenerator(DeriveLimits(params, options), options) {}
+
+void TrajectoryGenerator::reset() {
+    x_ = y_ = fov_ = Axis{};
+    initialized_ = false;
+    target_ns_ = time_ns_ = 0;
+}
+
+void TrajectoryGenerator::setTarget(const Setpoint& setpoint) {
+    if (!initialized_) {
+        x_ = Axis{setpoint.x, 0.0f, setpoint.x, 0.0f, 0.0f};
+        y_ = Axis{setpoint.y, 0.0f, setpoint.y, 0.0f, 0.0f};
+        fov_ = Axis{setpoint.fov, 0.0f, setpoint.fov, 0.0f, 0.0f};
+        target_ns_ = time_ns_ = setpoint.time_ns;
+        initialized_ = true;
+        return;
+    }
+
+    // 先按旧目标积分到新目标的时刻，轨迹只取决于目标的时刻而与采样时刻无关
+    advance(setpoint.time_ns);
+
+    // 前馈速度取相邻两个目标的差分，按速度限值截断
+    auto update = [&](Axis& axis, const AxisLimits& limits, float value, float dt) {
+        if (dt > 0.0f) {
+            axis.target_velocity = std::clamp((value - axis.target) / dt, -limits.velocity, limits.velocity);
+        }
+        axis.target = value;
+    };
+    const float dt = setpoint.time_ns > target_ns_ ? (setpoint.time_ns - target_ns_) * 1e-9f : 0.0f;
+    update(x_, limits_.x, setpoint.x, dt);
+    update(y_, limits_.y, setpoint.y, dt);
+    update(fov_, limits_.fov, setpoint.fov, dt);
+    target_ns_ = std::max(target_ns_, setpoint.time_ns);
+}
+
+void TrajectoryGenerator::step(Axis& axis, const AxisLimits& limits, float lead, float h) const {
+    // 位置环：误差按 tau_p 收敛，修正速度不超过以一半最大加速度能在误差内刹停的速度，
+    // 留出的余量吸收加速度爬升（加加速度受限）带来的制动延迟，大步进时不过冲
+    const float error = axis.target + axis.target_velocity * lead - axis.position;
+    const float brake = std::sqrt(limits.acceleration * std::fabs(error));
+    const float correction = std::copysign(std::min(std::fabs(error) / tau_p_, brake), error);
+    const float velocity = std::clamp(axis.target_velocity + correction, -limits.velocity, limits.velocity);
+
+    // 速度环与加速度环，各级输出按限值截断
+    const float acceleration = std::clamp((velocity - axis.velocity) / tau_v_,
+                                          -limits.acceleration, limits.acceleration);
+    const float jerk = std::clamp((acceleration - axis.acceleration) / tau_a_, -limits.jerk, limits.jerk);
+
+    // 步内加加速度恒定，梯形积分
+    const float next_acceleration = std::clamp(axis.acceleration + jerk * h,
+                                               -limits.acceleration, limits.acceleration);
+    const float next_velocity = std::clamp(axis.velocity + 0.5f * (axis.acceleration + next_acceleration) * h,
+                                           -limits.velocity, limits.velocity);
+    axis.position += 0.5f * (axis.velocity + next_velocity) * h;
+    axis.velocity = next_velocity;
+    axis.acceleration = next_acceleration;
+}
+
+void TrajectoryGenerator::advance(uint64_t time_ns) {
+    if (time_ns <= time_ns_) return;
+    // 步数不超过 ceil(kMaxElapsedS / max_step_)
+    const float elapsed = std::min((time_ns - time_ns_) * 1e-9f, kMaxElapsedS);
+    const int steps = std::max(1, static_cast<int>(std::ceil(elapsed / max_step_)));
+    const float h = elapsed / steps;
+    // 外推时长从当前目标的时刻起算；目标时刻晚于积分时刻时不外推
+    const float since_target = static_cast<float>(static_cast<int64_t>(time_ns - target_ns_) * 1e-9) - elapsed;
+    for (int i = 1; i <= steps; ++i) {
+        const float lead = std::clamp(since_target + h * i, 0.0f, options_.max_lead);
+        step(x_, limits_.x, lead, h);
+        step(y_, limits_.y, lead, h);
+        step(fov_, limits_.fov, lead, h);
+    }
+    time_ns_ = time_ns;
+}
+
+bool TrajectoryGenerator::sample(uint64_t time_ns, TrajectorySample& out) {
+    if (!initialized_) return false;
+    advance(time_ns);
+    out = TrajectorySample{time_ns_, x_.position, y_.position, fov_.position,
+                           x_.velocity, y_.velocity, fov_.velocity};
+    return true;
+}
+
+ControlLoop::ControlLoop(const TrajectoryGenerator::Limits& limits, const Options& options)
+    : generator_(limits, options.trajectory),
+      options_(options),
+      period_ns_(PeriodNs(options.rate_hz)),
+      setpoints_(options.setpoint_capacity),
+      output_(options.output_capacity) {}
+
+ControlLoop::ControlLoop(const ConfigManager::Params& params, const Options& options)
+    : ControlLoop(TrajectoryGenerator::DeriveLimits(params, options.trajectory), options) {}
+
+ControlLoop::~ControlLoop() {
+    stop();
+}
+
+void ControlLoop::start() {
+    if (running_.exchange(true)) return;
+    worker_ = std::thread(&ControlLoop::run, this);
+}
+
+void ControlLoop::stop() {
+    if (!running_.exchange(false)) return;
+    if (worker_.joinable()) worker_.join();
+}
+
+void ControlLoop::submit(const Setpoint& setpoint) {
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+    // 控制线程只需要最新的目标，队列满时淘汰最旧的
+    Setpoint stale;
+    while (!setpoints_.tryPush(setpoint)) setpoints_.tryPop(stale);
+}
+
+void ControlLoop::submit(const PtzCommand& command) {
+    submit(Setpoint{command.emit_ns, command.target_x, command.y, command.fov});
+}
+
+bool ControlLoop::poll(TrajectorySample& sample) {
+    return output_.tryPop(sample);
+}
+
+void ControlLoop::run() {
+    if (options_.cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(options_.cpu, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+            CAMERA_LOG("控制线程绑核失败 (cpu)", static_cast<float>(options_.cpu));
+        }
+    }
+    if (options_.rt_priority > 0) {
+        sched_param param{};
+        param.sched_priority = options_.rt_priority;
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+            CAMERA_LOG("控制线程设置实时优先级失败 (priority)", static_cast<float>(options_.rt_priority));
+        }
+    }
+
+    Setpoint setpoint;
+    TrajectorySample sample;
+    uint64_t next = Instrumentation::NowNs();
+    while (running_.load(std::memory_order_acquire)) {
+        SleepUntil(next);
+        const uint64_t now = Instrumentation::NowNs();
+
+        const uint64_t lateness = now > next ? now - next : 0;
+        if (lateness > max_lateness_ns_.load(std::memory_order_relaxed)) {
+            max_lateness_ns_.store(lateness, std::memory_order_relaxed);   // 只有控制线程写入
+        }
+        // 落后超过一个周期时跳过错过的节拍，不连续补发
+        if (lateness >= period_ns_) {
+            const uint64_t missed = lateness / period_ns_;
+            missed_ticks_.fetch_add(missed, std::memory_order_relaxed);
+            next += missed * period_ns_;
+        }
+        next += period_ns_;
+
+        // 积压的目标依次送入，前馈速度取最新两个目标的差分
+        while (setpoints_.tryPop(setpoint)) generator_.setTarget(setpoint);
+        if (generator_.sample(now, sample)) emit(sample);
+    }
+}
+
+void ControlLoop::emit(const TrajectorySample& sample) {
+    TrajectorySample stale;
+    while (!output_.tryPush(sample)) {
+        if (output_.tryPop(stale)) {
+            dropped_samples_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    samples_.fetch_add(1, std::memory_order_relaxed);
+}
+
+ControlLoop::Metrics ControlLoop::metrics() const {
+    Metrics m{};
+    m.setpoints = submitted_.load(std::memory_order_relaxed);
+    m.samples = samples_.load(std::memory_order_relaxed);
+    m.dropped_samples = dropped_samples_.load(std::memory_order_relaxed);
+    m.missed_ticks = missed_ticks_.load(std::memory_order_relaxed);
+    m.max_lateness_ns = max_lateness_ns_.load(std::memory_order_relaxed);
+    return m;
+}
@@ -0,0 +1,126 @@
+#include "camera/TransferCurve.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+// 基于篮球场特性的映射函数，归一化坐标 norm ∈ [0, 1]。
+// 原实现为 std::pow(2 * norm - 1, 2)，float 参数提升为 double 计算；
+// float 平方在 double 中精确可表示，u * u 与 pow 结果逐位相同且便于向量化。
+inline float ExactY(const TransferCurve::Range& t, float norm) {
+    // Y轴：中间位置需要更低（因为全景图畸变），两端稍高
+    // 使用反向二次函数：中心最小，两端较大
+    const double u = 2 * norm - 1;
+    float y_factor = 0.8f + 0.2f * (u * u);  // 中心0.8，两端1.0
+    return t.y_min + (t.y_max - t.y_min) * y_factor;
+}
+
+inline float ExactFov(const TransferCurve::Range& t, float norm) {
+    // FOV：根据实际需求，中间区域视角稍大，两端稍小
+    // 使用轻微的反向二次函数
+    const double u = 2 * norm - 1;
+    float fov_factor = 1.0f - 0.15f * (u * u);  // 中心1.0，两端0.85
+    return t.fov_min + (t.fov_max - t.fov_min) * fov_factor;
+}
+
+// 过 (0, f0), (0.5, fm), (1, f1) 的二次多项式系数
+void FitQuadratic(float f0, float fm, float f1, float coef[3]) {
+    coef[0] = f0;
+    coef[1] = -3.0f * f0 + 4.0f * fm - f1;
+    coef[2] = 2.0f * f0 - 4.0f * fm + 2.0f * f1;
+}
+
+} // namespace
+
+TransferCurve::Mode TransferCurve::ParseMode(const std::string& name) {
+    if (name == "exact") return Mode::Exact;
+    if (name == "lut") return Mode::Lut;
+    if (name == "polynomial") return Mode::Polynomial;
+    throw std::invalid_argument("Unknown transfer mode: " + name);
+}
+
+void TransferCurve::build(Mode mode, const Range& range, size_t lut_size) {
+    if (!(range.x_max > range.x_min)) {
+        throw std::invalid_argument("Invalid transfer range: x_max must exceed x_min");
+    }
+    mode_ = mode;
+    range_ = range;
+
+    y_lut_.clear();
+    fov_lut_.clear();
+    lut_scale_ = 0.0f;
+
+    if (mode == Mode::Polynomial) {
+        FitQuadratic(ExactY(range, 0.0f), ExactY(range, 0.5f), ExactY(range, 1.0f), y_coef_);
+        FitQuadratic(ExactFov(range, 0.0f), ExactFov(range, 0.5f), ExactFov(range, 1.0f), fov_coef_);
+    } else if (mode == Mode::Lut) {
+        if (lut_size < 2) {
+            throw std::invalid_argument("Invalid transfer lut_size: must be at least 2");
+        }
+        y_lut_.resize(lut_size);
+        fov_lut_.resize(lut_size);
+        for (size_t i = 0; i < lut_size; ++i) {
+            const float norm = static_cast<float>(i) / static_cast<float>(lut_size - 1);
+            y_lut_[i] = ExactY(range, norm);
+            fov_lut_[i] = ExactFov(range, norm);
+        }
+        lut_scale_ = static_cast<float>(lut_size - 1);
+    }
+}
+
+void TransferCurve::evaluateOne(float x, float& y, float& fov) const {
+    const float norm = normalize(x);
+    switch (mode_) {
+    case Mode::Polynomial:
+        y = y_coef_[0] + norm * (y_coef_[1] + norm * y_coef_[2]);
+        fov = fov_coef_[0] + norm * (fov_coef_[1] + norm * fov_coef_[2]);
+        break;
+    case Mode::Lut: {
+        const float pos = norm * lut_scale_;
+        const size_t last = y_lut_.size() - 2;
+        const size_t i = std::min(static_cast<size_t>(pos), last);
+        const float frac = pos - static_cast<float>(i);
+        y = y_lut_[i] + frac * (y_lut_[i + 1] - y_lut_[i]);
+        fov = fov_lut_[i] + frac * (fov_lut_[i + 1] - fov_lut_[i]);
+        break;
+    }
+    default:
+        y = ExactY(range_, norm);
+        fov = ExactFov(range_, norm);
+        break;
+    }
+}
+
+void TransferCurve::evaluateMany(Span<const float> xs, float* ys, float* fovs) const {
+    const size_t n = xs.size();
+    const float* in = xs.data();
+
+    // 模式分支提到循环外，Exact / Polynomial 循环体无分支，编译器可直接向量化
+    switch (mode_) {
+    case Mode::Polynomial: {
+        const float y0 = y_coef_[0], y1 = y_coef_[1], y2 = y_coef_[2];
+        const float f0 = fov_coef_[0], f1 = fov_coef_[1], f2 = fov_coef_[2];
+        for (size_t k = 0; k < n; ++k) {
+            const float norm = normalize(in[k]);
+            ys[k] = y0 + norm * (y1 + norm * y2);
+            fovs[k] = f0 + norm * (f1 + norm * f2);
+        }
+        break;
+    }
+    case Mode::Lut:
+        // 查表是聚集访问，保持标量循环
+        for (size_t k = 0; k < n; ++k) {
+            evaluateOne(in[k], ys[k], fovs[k]);
+        }
+        break;
+    default: {
+        const Range t = range_;
+        for (size_t k = 0; k < n; ++k) {
+            const float norm = normalize(in[k]);
+            ys[k] = ExactY(t, norm);
+            fovs[k] = ExactFov(t, norm);
+        }
+        break;
+    }
+    }
+}
@@ -0,0 +1,156 @@
+#include "camera/cameraman_c.h"
+#include "camera/CameramanModel.hpp"
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+static_assert(sizeof(Point) == 2 * sizeof(float) && alignof(Point) == alignof(float),
+              "C ABI passes points as packed float pairs");
+
+struct cameraman_model {
+    explicit cameraman_model(const char* config_path)
+        : config(config_path, false),
+          model(config) {}
+
+    ConfigManager config;
+    CameramanModel model;
+    std::vector<uint8_t> state;   // 快照暂存，容量足够后不再分配
+};
+
+namespace {
+
+thread_local std::string g_last_error;
+
+cameraman_status Fail(cameraman_status status, const char* message) {
+    g_last_error = message;
+    return status;
+}
+
+// 异常不跨越 C ABI：std::invalid_argument 映射为参数错误，其余为运行时错误
+template <typename Fn>
+cameraman_status Guard(Fn&& fn) {
+    try {
+        g_last_error.clear();
+        return fn();
+    } catch (const std::invalid_argument& e) {
+        return Fail(CAMERAMAN_INVALID_ARGUMENT, e.what());
+    } catch (const std::bad_alloc&) {
+        return Fail(CAMERAMAN_RUNTIME_ERROR, "out of memory");
+    } catch (const std::exception& e) {
+        return Fail(CAMERAMAN_RUNTIME_ERROR, e.what());
+    } catch (...) {
+        return Fail(CAMERAMAN_RUNTIME_ERROR, "unknown error");
+    }
+}
+
+Span<const Point> Points(const float* xy, size_t count) {
+    return {reinterpret_cast<const Point*>(xy), count};
+}
+
+// offsets 须从 0 开始单调不减，且 points 非空或点数为 0
+bool ValidOffsets(const uint64_t* offsets, size_t frames, const float* points) {
+    if (!offsets || offsets[0] != 0) return false;
+    for (size_t f = 0; f < frames; ++f) {
+        if (offsets[f + 1] < offsets[f]) return false;
+    }
+    return points || offsets[frames] == 0;
+}
+
+} // namespace
+
+extern "C" {
+
+uint32_t cameraman_abi_version(void) {
+    return CAMERAMAN_ABI_VERSION;
+}
+
+const char* cameraman_last_error(void) {
+    return g_last_error.c_str();
+}
+
+cameraman_status cameraman_create(const char* config_path, cameraman_model** out) {
+    if (!config_path || !out) return Fail(CAMERAMAN_INVALID_ARGUMENT, "null argument");
+    *out = nullptr;
+    return Guard([&] {
+        *out = new cameraman_model(config_path);
+        return CAMERAMAN_OK;
+    });
+}
+
+void cameraman_destroy(cameraman_model* model) {
+    delete model;
+}
+
+cameraman_status cameraman_predict(cameraman_model* model,
+                                   const float* players, size_t num_players,
+                                   const float* balls, size_t num_balls,
+                                   float* target) {
+    if (!model || !target || (!players && num_players) || (!balls && num_balls)) {
+        return Fail(CAMERAMAN_INVALID_ARGUMENT, "null argument");
+    }
+    return Guard([&] {
+        *target = model->model.predict(Points(players, num_players), Points(balls, num_balls));
+        return CAMERAMAN_OK;
+    });
+}
+
+cameraman_status cameraman_predict_batch(cameraman_model* model, size_t frames,
+                                         const float* players, const uint64_t* player_offsets,
+                                         const float* balls, const uint64_t* ball_offsets,
+                                         const uint64_t* timestamps_us, float* targets) {
+    if (!model || (!targets && frames)) return Fail(CAMERAMAN_INVALID_ARGUMENT, "null argument");
+    if (!ValidOffsets(player_offsets, frames, players) || !ValidOffsets(ball_offsets, frames, balls)) {
+        return Fail(CAMERAMAN_INVALID_ARGUMENT, "offsets must start at 0 and be non-decreasing");
+    }
+    return Guard([&] {
+        CameramanModel& m = model->model;
+        for (size_t f = 0; f < frames; ++f) {
+            const Span<const Point> frame_players = Points(players + 2 * player_offsets[f],
+                                                           player_offsets[f + 1] - player_offsets[f]);
+            const Span<const Point> frame_balls = Points(balls + 2 * ball_offsets[f],
+                                                         ball_offsets[f + 1] - ball_offsets[f]);
+            targets[f] = timestamps_us ? m.predict(frame_players, frame_balls, timestamps_us[f])
+                                       : m.predict(frame_players, frame_balls);
+        }
+        return CAMERAMAN_OK;
+    });
+}
+
+cameraman_status cameraman_transfer_many(const cameraman_model* model,
+                                         const float* xs, size_t count,
+                                         float* ys, float* fovs) {
+    if (!model || (count && (!xs || !ys || !fovs))) {
+        return Fail(CAMERAMAN_INVALID_ARGUMENT, "null argument");
+    }
+    return Guard([&] {
+        model->model.transferMany(Span<const float>(xs, count), ys, fovs);
+        return CAMERAMAN_OK;
+    });
+}
+
+cameraman_status cameraman_save_state(cameraman_model* model, uint8_t* buffer,
+                                      size_t capacity, size_t* size) {
+    if (!model || !size) return Fail(CAMERAMAN_INVALID_ARGUMENT, "null argument");
+    return Guard([&] {
+        model->model.saveState(model->state);
+        *size = model->state.size();
+        if (!buffer || capacity < model->state.size()) {
+            return Fail(CAMERAMAN_BUFFER_TOO_SMALL, "state buffer too small");
+        }
+        std::memcpy(buffer, model->state.data(), model->state.size());
+        return CAMERAMAN_OK;
+    });
+}
+
+cameraman_status cameraman_restore_state(cameraman_model* model, const uint8_t* state, size_t size) {
+    if (!model || (!state && size)) return Fail(CAMERAMAN_INVALID_ARGUMENT, "null argument");
+    return Guard([&] {
+        model->model.restoreState(Span<const uint8_t>(state, size));
+        return CAMERAMAN_OK;
+    });
+}
+
+} // extern "C"
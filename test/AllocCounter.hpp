@@ -0,0 +1,45 @@
+// 分配计数钩子：在 malloc 层计数（覆盖 operator new 与 Eigen 的 aligned_malloc），glibc 专用。
+// 只统计打开了 ScopedAllocCount 的线程，后台线程（如 ConfigWatcher）不计入。
+// 每个可执行文件只能由一个源文件包含。
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+
+extern "C" void* __libc_malloc(std::size_t size);
+extern "C" void* __libc_calloc(std::size_t n, std::size_t size);
+extern "C" void* __libc_realloc(void* p, std::size_t size);
+
+namespace alloc_counter {
+inline thread_local bool tracking = false;
+inline thread_local size_t count = 0;
+
+inline void Record() {
+    if (tracking) ++count;
+}
+} // namespace alloc_counter
+
+extern "C" void* malloc(std::size_t size) noexcept {
+    alloc_counter::Record();
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(std::size_t n, std::size_t size) noexcept {
+    alloc_counter::Record();
+    return __libc_calloc(n, size);
+}
+
+extern "C" void* realloc(void* p, std::size_t size) noexcept {
+    alloc_counter::Record();
+    return __libc_realloc(p, size);
+}
+
+// 作用域内统计当前线程的分配次数
+class ScopedAllocCount {
+public:
+    ScopedAllocCount() : start_(alloc_counter::count) { alloc_counter::tracking = true; }
+    ~ScopedAllocCount() { alloc_counter::tracking = false; }
+    size_t count() const { return alloc_counter::count - start_; }
+
+private:
+    size_t start_;
+};
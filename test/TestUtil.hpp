@@ -0,0 +1,13 @@
+// 测试公用的断言：失败时打印说明并计数，main 结束时按 g_failures 决定返回值。
+// 只用 C 与 C++ 共同的子集，纯 C 编译的 c_api_test 同样包含；每个可执行文件只能由一个源文件包含。
+#pragma once
+#include <stdio.h>
+
+static int g_failures = 0;
+
+static inline void Expect(int ok, const char* what) {
+    if (!ok) {
+        fprintf(stderr, "失败: %s\n", what);
+        ++g_failures;
+    }
+}
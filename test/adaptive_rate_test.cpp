@@ -0,0 +1,143 @@
+// 变帧率：带时间戳回放全部帧时与固定帧率结果一致；降到 15 fps 或随机丢帧时，
+// 按时间戳计算的速度与目标仍贴近全帧率参照，而按固定帧率处理的偏差显著更大。
+// 另测按时间淘汰的窗口语义与帧路径零分配。
+#include "AllocCounter.hpp"
+#include "TestUtil.hpp"
+#include "camera/CameramanModel.hpp"
+#include "camera/DetectionTrace.hpp"
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct FrameOutput {
+    float target;
+    float speed;
+};
+
+// keep[f] 为 false 的帧被丢弃；返回与 trace 等长的输出，丢弃的帧沿用上一帧输出
+std::vector<FrameOutput> Run(const DetectionTrace& trace, const std::vector<bool>& keep, bool timed) {
+    ConfigManager config("../config/camera_config.json", false);
+    CameramanModel model(config);
+    std::vector<FrameOutput> out(trace.size());
+    FrameOutput last{0.0f, 0.0f};
+    for (size_t f = 0; f < trace.size(); ++f) {
+        if (keep[f]) {
+            last.target = timed
+                ? model.predict(trace.framePlayers(f), trace.frameBalls(f), trace.frames[f].timestamp_us)
+                : model.predict(trace.framePlayers(f), trace.frameBalls(f));
+            last.speed = model.getDebugInfo()->calculated_speed;
+        }
+        out[f] = last;
+    }
+    return out;
+}
+
+struct Error {
+    double speed_mean;
+    double speed_max;
+    double target_mean;
+};
+
+// 只在保留的帧上与参照比较
+Error Compare(const std::vector<FrameOutput>& reference, const std::vector<FrameOutput>& run,
+              const std::vector<bool>& keep) {
+    Error e{0.0, 0.0, 0.0};
+    size_t n = 0;
+    for (size_t f = 0; f < reference.size(); ++f) {
+        if (!keep[f]) continue;
+        const double ds = std::fabs(run[f].speed - reference[f].speed);
+        e.speed_mean += ds;
+        e.speed_max = std::max(e.speed_max, ds);
+        e.target_mean += std::fabs(run[f].target - reference[f].target);
+        ++n;
+    }
+    e.speed_mean /= n;
+    e.target_mean /= n;
+    return e;
+}
+
+} // namespace
+
+int main() {
+    try {
+        {
+            // 按时间淘汰：名义 30 fps、horizon 4.5 帧时保留 5 个样本；长时间中断后仍保留中断前的一个样本
+            SlidingWindow window;
+            const uint64_t frame_us = 33333;
+            window.reset(20, 0.0f, frame_us * 9 / 2, 0);
+            for (uint64_t i = 1; i <= 10; ++i) window.push(static_cast<float>(i), i * frame_us);
+            Expect(window.size() == 5, "名义帧率下窗口样本数");
+            Expect(window.front() == 6.0f && window.back() == 10.0f, "最旧与最新样本");
+            Expect(window.duration() == 4 * frame_us, "窗口时长");
+            Expect(window.min() == 6.0f && window.max() == 10.0f && window.mean() == 8.0f, "窗口统计");
+            window.push(20.0f, 100 * frame_us);
+            Expect(window.size() == 2 && window.front() == 10.0f, "中断后保留一个旧样本");
+            for (uint64_t i = 0; i < 30; ++i) window.push(1.0f, 100 * frame_us + i);
+            Expect(window.size() == 20, "突发帧超出容量时按样本数淘汰");
+        }
+
+        SyntheticTraceOptions options;
+        options.frames = 30 * 60 * 3;
+        options.fast_break_rate = 0.01f;
+        const DetectionTrace trace = GenerateSyntheticTrace(options);
+
+        const std::vector<bool> all(trace.size(), true);
+        std::vector<bool> half(trace.size());
+        for (size_t f = 0; f < trace.size(); ++f) half[f] = f % 2 == 0;
+        std::vector<bool> dropped(trace.size());
+        std::mt19937 rng(11);
+        for (size_t f = 0; f < trace.size(); ++f) dropped[f] = f == 0 || rng() % 100 >= 30;
+
+        const auto reference = Run(trace, all, false);
+
+        const Error timed_all = Compare(reference, Run(trace, all, true), all);
+        std::printf("全部帧      : 速度偏差均值 %.4f，目标偏差均值 %.4f 像素\n",
+                    timed_all.speed_mean, timed_all.target_mean);
+        Expect(timed_all.speed_mean < 0.05 && timed_all.target_mean < 0.05,
+               "全部帧带时间戳与固定帧率结果一致");
+
+        const Error fixed_half = Compare(reference, Run(trace, half, false), half);
+        const Error timed_half = Compare(reference, Run(trace, half, true), half);
+        std::printf("15 fps      : 速度偏差均值 固定 %.2f / 时间戳 %.2f，目标偏差均值 固定 %.2f / 时间戳 %.2f\n",
+                    fixed_half.speed_mean, timed_half.speed_mean,
+                    fixed_half.target_mean, timed_half.target_mean);
+        Expect(timed_half.speed_mean < 0.5 * fixed_half.speed_mean, "15 fps 时速度偏差显著减小");
+        Expect(timed_half.target_mean < fixed_half.target_mean, "15 fps 时目标偏差减小");
+
+        const Error fixed_drop = Compare(reference, Run(trace, dropped, false), dropped);
+        const Error timed_drop = Compare(reference, Run(trace, dropped, true), dropped);
+        std::printf("随机丢帧 30%%: 速度偏差 均值/最大 固定 %.2f/%.2f，时间戳 %.2f/%.2f\n",
+                    fixed_drop.speed_mean, fixed_drop.speed_max,
+                    timed_drop.speed_mean, timed_drop.speed_max);
+        Expect(timed_drop.speed_mean < 0.5 * fixed_drop.speed_mean, "丢帧时速度偏差显著减小");
+
+        {
+            // 预热后带时间戳的帧路径不分配（含时间戳抖动与倒退）
+            ConfigManager config("../config/camera_config.json", false);
+            CameramanModel model(config);
+            model.predict(trace.framePlayers(0), trace.frameBalls(0), trace.frames[0].timestamp_us);
+            size_t allocations = 0;
+            {
+                ScopedAllocCount counter;
+                for (size_t f = 1; f < trace.size(); ++f) {
+                    const uint64_t jitter = f % 7 == 0 ? 40000 : 0;
+                    model.predict(trace.framePlayers(f), trace.frameBalls(f),
+                                  trace.frames[f].timestamp_us - jitter);
+                }
+                allocations = counter.count();
+            }
+            Expect(allocations == 0, "带时间戳的帧路径不分配");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (g_failures) return 1;
+    std::cout << "全部通过" << std::endl;
+    return 0;
+}
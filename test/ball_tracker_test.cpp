@@ -0,0 +1,74 @@
+// BallTracker：备用球排在首位、混有随机误检时仍跟住运动的比赛球；
+// 比赛球短暂丢失时靠预测外推，长时间丢失后轨迹结束；跟踪过程不产生堆分配。
+#include "AllocCounter.hpp"
+#include "TestUtil.hpp"
+#include "camera/BallTracker.hpp"
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main() {
+    const ConfigManager::Params::BallTrackerParams params;
+    const int fps = 30;
+    BallTracker tracker(params, fps);
+
+    std::mt19937 rng(20240615);
+    std::normal_distribution<float> noise(0.0f, 3.0f);
+    std::uniform_real_distribution<float> anywhere(0.0f, 5376.0f);
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+    std::uniform_real_distribution<float> spread(-400.0f, 400.0f);
+
+    // 预先生成全部帧：备用球固定在场边且总在首位，比赛球往返运动，30% 帧带一个误检
+    const size_t frames = 600;
+    std::vector<std::vector<Point>> balls(frames);
+    std::vector<float> truth(frames), players(frames);
+    float x = 1000.0f, v = 900.0f;
+    for (size_t f = 0; f < frames; ++f) {
+        x += v / fps;
+        if (x < 800.0f || x > 4500.0f) v = -v;
+        truth[f] = x;
+        players[f] = x + spread(rng);   // 球员均值在比赛球附近摆动
+        balls[f].push_back({300.0f + noise(rng), 1400.0f + noise(rng)});
+        const bool dropout = f >= 300 && f < 305;   // 比赛球被遮挡 5 帧
+        if (!dropout) balls[f].push_back({x + noise(rng), 600.0f + noise(rng)});
+        if (chance(rng) < 0.3f) balls[f].push_back({anywhere(rng), anywhere(rng) * 0.3f});
+    }
+
+    // 备用球先出现，比赛球随后入场：稳定后必须切换到运动的球
+    float worst = 0.0f;
+    size_t allocations = 0;
+    {
+        ScopedAllocCount counter;
+        for (size_t f = 0; f < frames; ++f) {
+            float ball_x = 0.0f;
+            const bool ok = tracker.update(Span<const Point>(balls[f]), players[f], ball_x);
+            if (f >= 30) {
+                Expect(ok, "存在可用轨迹");
+                worst = std::max(worst, std::fabs(ball_x - truth[f]));
+            }
+        }
+        allocations = counter.count();
+    }
+    std::cout << "最大跟踪误差: " << worst << " px, 活动轨迹: " << tracker.activeTracks()
+              << ", 堆分配: " << allocations << "\n";
+    // 匀速段误差为噪声量级，折返和遮挡处允许外推误差
+    Expect(worst < 60.0f, "跟住比赛球而不是首位的备用球");
+    Expect(allocations == 0, "跟踪不分配内存");
+    Expect(tracker.activeTracks() <= BallTracker::kMaxTracks, "轨迹数不超过池容量");
+
+    // 所有候选消失：max_misses 帧内外推，之后全部轨迹结束
+    float ball_x = 0.0f;
+    for (int i = 0; i < params.max_misses; ++i) {
+        Expect(tracker.update(Span<const Point>(), 2000.0f, ball_x), "丢失期间继续外推");
+    }
+    Expect(!tracker.update(Span<const Point>(), 2000.0f, ball_x), "连续丢失后轨迹结束");
+    Expect(tracker.activeTracks() == 0, "无活动轨迹");
+
+    if (g_failures) {
+        std::cerr << g_failures << " 项失败\n";
+        return 1;
+    }
+    std::cout << "全部通过\n";
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * C ABI：以纯 C 编译，只链接 libcameraman_c。批量 predict 与逐帧调用逐位一致，
+ * transfer_many、快照大小查询与恢复、参数与配置错误的状态码和错误信息。
+ */
+#include "TestUtil.hpp"
+#include "camera/cameraman_c.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum { kFrames = 600, kPlayers = 5 };
+
+/* 确定性的伪随机序列（LCG），每帧 kPlayers 名球员、每 7 帧一帧空球 */
+static unsigned g_seed = 12345u;
+static float Noise(void) {
+    g_seed = g_seed * 1103515245u + 12345u;
+    return (float)((g_seed >> 16) & 0x7fff) / 32768.0f - 0.5f;
+}
+
+int main(void) {
+    static float players[kFrames * kPlayers * 2];
+    static float balls[kFrames * 2];
+    static uint64_t player_offsets[kFrames + 1];
+    static uint64_t ball_offsets[kFrames + 1];
+    static uint64_t timestamps[kFrames];
+    static float batch[kFrames];
+    static float single[kFrames];
+    size_t num_balls = 0;
+
+    for (size_t f = 0; f < kFrames; ++f) {
+        const float center = 1500.0f + 1200.0f * (float)f / kFrames;
+        player_offsets[f] = f * kPlayers;
+        for (size_t i = 0; i < kPlayers; ++i) {
+            players[2 * (f * kPlayers + i)] = center + 300.0f * Noise();
+            players[2 * (f * kPlayers + i) + 1] = 400.0f + 150.0f * (float)i;
+        }
+        ball_offsets[f] = num_balls;
+        if (f % 7 != 0) {
+            balls[2 * num_balls] = center + 100.0f * Noise();
+            balls[2 * num_balls + 1] = 700.0f;
+            ++num_balls;
+        }
+        timestamps[f] = 1000000u + f * 33333u;
+    }
+    player_offsets[kFrames] = kFrames * kPlayers;
+    ball_offsets[kFrames] = num_balls;
+
+    Expect(cameraman_abi_version() == CAMERAMAN_ABI_VERSION, "ABI 版本");
+
+    cameraman_model* bad = NULL;
+    Expect(cameraman_create("missing_config.json", &bad) == CAMERAMAN_RUNTIME_ERROR && bad == NULL &&
+           strlen(cameraman_last_error()) > 0, "配置不存在时返回错误信息");
+
+    cameraman_model* a = NULL;
+    cameraman_model* b = NULL;
+    if (cameraman_create("../config/camera_config.json", &a) != CAMERAMAN_OK ||
+        cameraman_create("../config/camera_config.json", &b) != CAMERAMAN_OK) {
+        fprintf(stderr, "Error: %s\n", cameraman_last_error());
+        return 1;
+    }
+
+    /* 整段一次调用与逐帧调用一致 */
+    Expect(cameraman_predict_batch(a, kFrames, players, player_offsets, balls, ball_offsets,
+                                   NULL, batch) == CAMERAMAN_OK, "批量 predict");
+    int same = 1;
+    for (size_t f = 0; f < kFrames; ++f) {
+        const uint64_t nb = ball_offsets[f + 1] - ball_offsets[f];
+        same &= cameraman_predict(b, players + 2 * player_offsets[f], kPlayers,
+                                  balls + 2 * ball_offsets[f], nb, &single[f]) == CAMERAMAN_OK;
+        same &= memcmp(&batch[f], &single[f], sizeof(float)) == 0;
+    }
+    Expect(same, "批量与逐帧结果逐位一致");
+
+    /* transfer_many 与逐个映射一致 */
+    float ys[kFrames], fovs[kFrames], y1, fov1;
+    Expect(cameraman_transfer_many(a, batch, kFrames, ys, fovs) == CAMERAMAN_OK, "批量映射");
+    Expect(cameraman_transfer_many(a, batch + 100, 1, &y1, &fov1) == CAMERAMAN_OK &&
+           y1 == ys[100] && fov1 == fovs[100], "批量映射与单点一致");
+
+    /* 快照：先查询大小，恢复到另一个句柄后两者后续输出一致 */
+    size_t size = 0;
+    Expect(cameraman_save_state(a, NULL, 0, &size) == CAMERAMAN_BUFFER_TOO_SMALL && size > 0,
+           "快照大小查询");
+    uint8_t* state = (uint8_t*)malloc(size);
+    size_t written = 0;
+    Expect(cameraman_save_state(a, state, size, &written) == CAMERAMAN_OK && written == size, "保存快照");
+    cameraman_model* c = NULL;
+    Expect(cameraman_create("../config/camera_config.json", &c) == CAMERAMAN_OK &&
+           cameraman_restore_state(c, state, size) == CAMERAMAN_OK, "恢复快照");
+    float after_a[kFrames], after_c[kFrames];
+    Expect(cameraman_predict_batch(a, kFrames, players, player_offsets, balls, ball_offsets,
+                                   timestamps, after_a) == CAMERAMAN_OK &&
+           cameraman_predict_batch(c, kFrames, players, player_offsets, balls, ball_offsets,
+                                   timestamps, after_c) == CAMERAMAN_OK &&
+           memcmp(after_a, after_c, sizeof(after_a)) == 0, "恢复后带时间戳的输出一致");
+    Expect(cameraman_restore_state(c, state, size / 2) == CAMERAMAN_RUNTIME_ERROR, "截断的快照");
+    free(state);
+
+    /* 参数错误 */
+    uint64_t broken[3] = {0, 5, 2};
+    Expect(cameraman_predict_batch(a, 2, players, broken, balls, ball_offsets, NULL, batch) ==
+           CAMERAMAN_INVALID_ARGUMENT && strlen(cameraman_last_error()) > 0, "偏移不单调");
+    Expect(cameraman_predict(a, NULL, 3, NULL, 0, batch) == CAMERAMAN_INVALID_ARGUMENT, "空指针");
+    Expect(cameraman_predict_batch(a, 0, NULL, player_offsets, NULL, ball_offsets, NULL, NULL) ==
+           CAMERAMAN_OK && cameraman_last_error()[0] == '\0', "空序列");
+
+    cameraman_destroy(a);
+    cameraman_destroy(b);
+    cameraman_destroy(c);
+    cameraman_destroy(NULL);
+
+    if (g_failures) return 1;
+    printf("全部通过\n");
+    return 0;
+}
@@ -0,0 +1,169 @@
+// 多路批量推进：三路相机（两路共用同一配置实例）在回放序列上与三个独立的 CameramanModel 逐位一致，
+// 覆盖 density 焦点、目标滤波、空帧、固定帧率切换到带时间戳（含抖动与长间隔）以及两次配置热更新；
+// 速度与 slider 滤波值与模型调试信息一致；配置不变时批量推进不分配。
+#include "AllocCounter.hpp"
+#include "TestUtil.hpp"
+#include "camera/CameramanBank.hpp"
+#include "camera/CameramanModel.hpp"
+#include "camera/DetectionTrace.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <unistd.h>
+#include <utime.h>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace {
+
+bool SameBits(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+// 以基础配置为模板写出配置文件，patch 修改各段；bump 使 mtime 与上次不同（秒级精度）
+void WriteConfig(const std::string& path, const std::function<void(json&)>& patch, int bump) {
+    std::ifstream base("../config/camera_config.json");
+    json data = json::parse(base);
+    data["court_config"]["user"] = path + ".missing_user_court.json";
+    patch(data);
+    std::ofstream(path) << data.dump(2);
+    const utimbuf times{time(nullptr) + bump, time(nullptr) + bump};
+    utime(path.c_str(), &times);
+}
+
+} // namespace
+
+int main() {
+    constexpr size_t kCameras = 3;
+    constexpr size_t kFrames = 1200;
+    constexpr size_t kTimedFrom = 600;   // 之后改为带时间戳调用
+
+    char tmpl[] = "/tmp/cameraman_bank_test.XXXXXX";
+    if (!mkdtemp(tmpl)) {
+        std::cerr << "Error: mkdtemp failed" << std::endl;
+        return 1;
+    }
+    const std::string dir = tmpl;
+    const std::string config_a = dir + "/camera_a.json";
+    const std::string config_b = dir + "/camera_b.json";
+
+    try {
+        WriteConfig(config_a, [](json& data) {
+            data["camera"]["memory_length"] = 0.4;
+            data["focus"]["mode"] = "density";
+            data["target_filter"]["model"] = "cv";
+            data["target_filter"]["lead_ms"] = 40;
+        }, 0);
+        WriteConfig(config_b, [](json&) {}, 0);
+        ConfigManager manager_a(config_a, false);
+        ConfigManager manager_b(config_b, false);
+
+        // 第 0、2 路共用 manager_a，各路使用不同种子的回放序列
+        const std::vector<const ConfigManager*> configs = {&manager_a, &manager_b, &manager_a};
+        CameramanBank bank(configs);
+        std::vector<CameramanModel> models;
+        models.reserve(kCameras);
+        std::vector<DetectionTrace> traces;
+        for (size_t k = 0; k < kCameras; ++k) {
+            models.emplace_back(*configs[k]);
+            SyntheticTraceOptions options;
+            options.frames = kFrames;
+            options.seed = static_cast<uint32_t>(11 + k);
+            traces.push_back(GenerateSyntheticTrace(options));
+        }
+        Expect(bank.size() == kCameras, "路数");
+
+        bool same_targets = true;
+        bool same_speed = true;
+        bool same_slider = true;
+        bool same_transfer = true;
+        size_t allocations = 0;
+        std::vector<CameramanBank::CameraInput> inputs(kCameras);
+        std::vector<uint64_t> timestamps(kCameras, 0);
+        std::vector<float> targets(kCameras);
+        for (size_t f = 0; f < kFrames; ++f) {
+            if (f == 300) {
+                // 固定帧率段内热更新：记忆窗口变长、改为 density 焦点与常加速度滤波
+                WriteConfig(config_b, [](json& data) {
+                    data["camera"]["memory_length"] = 0.8;
+                    data["focus"]["mode"] = "density";
+                    data["target_filter"]["model"] = "ca";
+                    data["safety"]["boundary_margin"] = 0;
+                }, 100);
+                Expect(manager_b.Reload(), "第 1 路配置热更新");
+            }
+            if (f == 900) {
+                // 带时间戳段内热更新共用的配置：两路同时切换
+                WriteConfig(config_a, [](json& data) {
+                    data["camera"]["memory_length"] = 0.3;
+                    data["camera"]["position_merge_ratio"] = 0.8;
+                    data["target_filter"]["model"] = "off";
+                }, 200);
+                Expect(manager_a.Reload(), "第 0、2 路配置热更新");
+            }
+
+            const bool timed = f >= kTimedFrom;
+            for (size_t k = 0; k < kCameras; ++k) {
+                // 第 2 路周期性整段无球员，第 1 路每 50 帧中断 0.2 s，其余帧带 ±3 ms 抖动
+                const bool empty = k == 2 && f % 97 >= 90;
+                inputs[k].players = empty ? Span<const Point>() : traces[k].framePlayers(f);
+                inputs[k].balls = traces[k].frameBalls(f);
+                timestamps[k] = 1000000 + f * 33333 + (f * 7 + k * 3) % 7 * 1000 +
+                                (k == 1 ? f / 50 * 200000 : 0);
+            }
+
+            {
+                ScopedAllocCount counter;
+                if (timed) {
+                    bank.predictBatch(Span<const CameramanBank::CameraInput>(inputs.data(), kCameras),
+                                      timestamps.data(), targets.data());
+                } else {
+                    bank.predictBatch(Span<const CameramanBank::CameraInput>(inputs.data(), kCameras),
+                                      targets.data());
+                }
+                // 首帧初始化、配置切换与调用方式切换的帧重建窗口，其余帧不分配
+                if (f != 0 && f != 300 && f != kTimedFrom && f != 900) allocations += counter.count();
+            }
+
+            for (size_t k = 0; k < kCameras; ++k) {
+                const float expected = timed
+                    ? models[k].predict(inputs[k].players, inputs[k].balls, timestamps[k])
+                    : models[k].predict(inputs[k].players, inputs[k].balls);
+                const auto debug = models[k].getDebugInfo();
+                same_targets &= SameBits(targets[k], expected);
+                same_speed &= SameBits(bank.speed(k), debug->calculated_speed);
+                same_slider &= SameBits(bank.filteredSlider(k), debug->focus_slider);
+                const auto [ya, fova] = bank.transfer(k, targets[k]);
+                const auto [yb, fovb] = models[k].transfer(expected);
+                same_transfer &= SameBits(ya, yb) && SameBits(fova, fovb);
+            }
+        }
+
+        Expect(same_targets, "各路目标与独立模型逐位一致");
+        Expect(same_speed, "各路速度与独立模型一致");
+        Expect(same_slider, "各路 slider 滤波与独立模型一致");
+        Expect(same_transfer, "各路 transfer 使用各自配置");
+        Expect(allocations == 0, "配置不变时批量推进不分配");
+
+        bool threw = false;
+        try {
+            bank.predictBatch(Span<const CameramanBank::CameraInput>(inputs.data(), 1), targets.data());
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        Expect(threw, "输入路数不符时抛出异常");
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        ++g_failures;
+    }
+
+    for (const auto& path : {config_a, config_b}) std::remove(path.c_str());
+    rmdir(dir.c_str());
+
+    if (g_failures) return 1;
+    std::cout << "全部通过" << std::endl;
+    return 0;
+}
@@ -0,0 +1,120 @@
+// 预编译配置：与 JSON 加载结果逐字段一致；JSON 修改后视为过期；损坏的文件被拒绝；
+// 只有 .bin 时也能启动。
+#include "TestUtil.hpp"
+#include "camera/ConfigBlob.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+using json = nlohmann::json;
+
+namespace {
+
+template <typename T>
+bool SameBytes(const T& a, const T& b) {
+    return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+bool SameParams(const ConfigManager::Params& a, const ConfigManager::Params& b) {
+    if (!SameBytes(a.base, b.base) || !SameBytes(a.slider, b.slider) ||
+        !SameBytes(a.camera, b.camera) || !SameBytes(a.safety, b.safety) ||
+        !SameBytes(a.transfer.curve.range(), b.transfer.curve.range()) ||
+        a.transfer.curve.mode() != b.transfer.curve.mode() ||
+        a.court_points.size() != b.court_points.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.court_points.size(); ++i) {
+        if (!SameBytes(a.court_points[i], b.court_points[i])) return false;
+    }
+    return true;
+}
+
+time_t Mtime(const std::string& path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 ? st.st_mtime : 0;
+}
+
+} // namespace
+
+int main() {
+    try {
+        char tmpl[] = "/tmp/config_blob_test.XXXXXX";
+        if (!mkdtemp(tmpl)) throw std::runtime_error("mkdtemp failed");
+        const std::string dir = tmpl;
+        const std::string config = dir + "/camera_config.json";
+        const std::string blob = ConfigBlob::PathFor(config);
+        Expect(blob == dir + "/camera_config.bin", "PathFor 替换扩展名");
+
+        // 球场路径改为绝对路径，配置可以放在临时目录
+        std::ifstream base("../config/camera_config.json");
+        json data = json::parse(base);
+        char cwd[4096];
+        if (!getcwd(cwd, sizeof(cwd))) throw std::runtime_error("getcwd failed");
+        data["court_config"]["default"] = std::string(cwd) + "/../config/default_court_config.json";
+        data["court_config"]["user"] = dir + "/missing_user_court.json";
+        data["transfer"]["mode"] = "lut";
+        std::ofstream(config) << data.dump(2);
+
+        ConfigManager::SourceFiles json_files;
+        const auto from_json = ConfigManager::LoadJson(config, &json_files);
+        ConfigBlob::Write(blob, *from_json, json_files, Mtime(config));
+
+        ConfigManager::Params from_blob;
+        ConfigManager::SourceFiles blob_files;
+        Expect(ConfigBlob::Read(blob, Mtime(config), from_blob, blob_files), "读取二进制配置");
+        Expect(SameParams(*from_json, from_blob), "二进制与 JSON 参数一致");
+        Expect(blob_files.court_file == json_files.court_file &&
+               blob_files.court_mtime == json_files.court_mtime, "记录所选球场文件");
+
+        // JSON 修改后二进制视为过期，LoadParams 改用 JSON
+        data["camera"]["fps"] = 60;
+        std::ofstream(config) << data.dump(2);
+        const utimbuf later{time(nullptr) + 10, time(nullptr) + 10};
+        utime(config.c_str(), &later);
+        Expect(!ConfigBlob::Read(blob, Mtime(config), from_blob, blob_files), "JSON 修改后过期");
+        Expect(ConfigManager::LoadParams(config)->camera.fps == 60, "过期时回退到 JSON");
+
+        // 损坏的负载被拒绝，LoadParams 回退到 JSON
+        ConfigBlob::Write(blob, *ConfigManager::LoadJson(config, &json_files), json_files,
+                          Mtime(config));
+        {
+            std::fstream f(blob, std::ios::in | std::ios::out | std::ios::binary);
+            f.seekp(-3, std::ios::end);
+            f.put('\x7f');
+        }
+        bool rejected = false;
+        try {
+            ConfigBlob::Read(blob, Mtime(config), from_blob, blob_files);
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        Expect(rejected, "校验和不符时拒绝");
+        Expect(ConfigManager::LoadParams(config)->camera.fps == 60, "损坏时回退到 JSON");
+
+        // 只部署 .bin：没有 JSON 也能直接启动
+        ConfigBlob::Write(blob, *ConfigManager::LoadJson(config, &json_files), json_files,
+                          Mtime(config));
+        std::remove(config.c_str());
+        ConfigManager only_blob(config, false);
+        Expect(only_blob.Snapshot()->camera.fps == 60, "仅有二进制配置时启动");
+        Expect(only_blob.Snapshot()->transfer.curve.mode() == TransferCurve::Mode::Lut,
+               "transfer 模式随二进制恢复");
+
+        std::remove(blob.c_str());
+        rmdir(dir.c_str());
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (g_failures) {
+        std::cerr << g_failures << " 项失败\n";
+        return 1;
+    }
+    std::cout << "全部通过\n";
+    return 0;
+}
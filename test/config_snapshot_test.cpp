@@ -0,0 +1,168 @@
+// 多实例配置快照：两路相机各自绑定不同球场的 ConfigManager，在各自线程上 predict，
+// 重新加载只影响所属实例，格式错误的配置不会替换已发布的快照；
+// 再次 Initialize 原地切换默认实例，绑定它的模型继续可用，Get() 看到热更新且不保留旧快照。
+#include "TestUtil.hpp"
+#include "camera/CameramanModel.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <unistd.h>
+#include <utime.h>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace {
+
+std::string g_dir;
+
+void WriteCourt(const std::string& path, float right) {
+    json court;
+    court["court_points"] = {{{"x", 0}, {"y", 0}}, {{"x", right}, {"y", 0}},
+                             {{"x", right}, {"y", 1520}}, {{"x", 0}, {"y", 1520}}};
+    std::ofstream(path) << court.dump();
+}
+
+// 以基础配置为模板写出指向 court 的配置；bump 使 mtime 与上次不同（秒级精度）
+void WriteConfig(const std::string& path, const std::string& court, int bump) {
+    std::ifstream base("../config/camera_config.json");
+    json data = json::parse(base);
+    data["court_config"]["default"] = court;
+    data["court_config"]["user"] = g_dir + "/missing_user_court.json";
+    // 余量覆盖 FarRightTarget 的检测，使其不被场内过滤丢弃，只检验目标裁剪到哪条右边界
+    data["safety"]["boundary_margin"] = 10000;
+    std::ofstream(path) << data.dump(2);
+    const utimbuf times{time(nullptr) + bump, time(nullptr) + bump};
+    utime(path.c_str(), &times);
+}
+
+void Touch(const std::string& path, int bump) {
+    const utimbuf times{time(nullptr) + bump, time(nullptr) + bump};
+    utime(path.c_str(), &times);
+}
+
+// 球员和球都在球场右侧之外（余量以内），目标被裁剪到 right + buffer_pixels
+float FarRightTarget(CameramanModel& model) {
+    const std::vector<Point> players = {{9000, 300}, {9100, 400}, {9200, 500}};
+    const std::vector<Point> balls = {{9000, 350}};
+    return model.predict(players, balls);
+}
+
+} // namespace
+
+int main() {
+    try {
+        char tmpl[] = "/tmp/config_snapshot_test.XXXXXX";
+        if (!mkdtemp(tmpl)) throw std::runtime_error("mkdtemp failed");
+        g_dir = tmpl;
+
+        const std::string court_a = g_dir + "/court_a.json";
+        const std::string court_b = g_dir + "/court_b.json";
+        const std::string config_a = g_dir + "/config_a.json";
+        const std::string config_b = g_dir + "/config_b.json";
+        WriteCourt(court_a, 1000);
+        WriteCourt(court_b, 3000);
+        WriteConfig(config_a, court_a, 0);
+        WriteConfig(config_b, court_b, 0);
+
+        ConfigManager cfg_a(config_a, false);
+        ConfigManager cfg_b(config_b, false);
+        const float buffer = cfg_a.Snapshot()->camera.buffer_pixels;
+
+        CameramanModel model_a(cfg_a);
+        CameramanModel model_b(cfg_b);
+        Expect(FarRightTarget(model_a) == 1000 + buffer, "实例 A 使用自己的球场");
+        Expect(FarRightTarget(model_b) == 3000 + buffer, "实例 B 使用自己的球场");
+
+        // 两路模型在各自线程上运行，同时反复重新加载 A 的球场
+        std::atomic<bool> stop{false};
+        std::atomic<int> bad_b{0};
+        std::thread thread_a([&] { while (!stop) FarRightTarget(model_a); });
+        std::thread thread_b([&] {
+            while (!stop) {
+                if (FarRightTarget(model_b) != 3000 + buffer) ++bad_b;
+            }
+        });
+        const auto old_a = cfg_a.Snapshot();
+        for (int i = 1; i <= 20; ++i) {
+            WriteCourt(court_a, 1000 + 50 * i);
+            Touch(court_a, i);
+            Expect(cfg_a.Reload(), "球场文件变化时发布新快照");
+        }
+        stop = true;
+        thread_a.join();
+        thread_b.join();
+
+        Expect(cfg_a.Version() == 20, "每次发布递增版本");
+        Expect(cfg_b.Version() == 0, "其他实例版本不变");
+        Expect(bad_b == 0, "实例 B 不受 A 的重新加载影响");
+        Expect(old_a->court_points[1].x == 1000, "已取得的旧快照保持不变");
+        Expect(FarRightTarget(model_a) == 2000 + buffer, "实例 A 切换到最新球场");
+        Expect(!cfg_a.Reload(), "文件未变化时不发布");
+
+        // 格式错误的配置保留旧快照
+        std::ofstream(config_a) << "{ \"kalman\": ";
+        Touch(config_a, 100);
+        Expect(!cfg_a.Reload(), "格式错误的配置不发布");
+        Expect(cfg_a.Version() == 20, "格式错误时版本不变");
+
+        // 修复后整体重新解析，参数变化随快照生效
+        WriteConfig(config_a, court_a, 200);
+        Expect(cfg_a.Reload(), "配置修复后发布新快照");
+        Expect(cfg_a.Snapshot()->court_points[1].x == 2000, "重新解析后球场保持");
+
+        // 后台监视：文件变化后无需手动 Reload
+        ConfigManager watched(config_b, true);
+        CameramanModel model_w(watched);
+        Expect(FarRightTarget(model_w) == 3000 + buffer, "监视实例初始球场");
+        WriteCourt(court_b, 4000);
+        Touch(court_b, 300);
+        bool seen = false;
+        for (int i = 0; i < 300 && !seen; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            seen = FarRightTarget(model_w) == 4000 + buffer;
+        }
+        Expect(seen, "监视线程发布球场变化");
+
+        // 默认实例：再次 Initialize 不销毁已被模型引用的实例，Get() 跟随最新快照
+        ConfigManager::Initialize(config_a, false);
+        CameramanModel model_d(ConfigManager::Default().Snapshot()->court_points);
+        ConfigManager::Get();
+        std::weak_ptr<const ConfigManager::Params> first = ConfigManager::Default().Snapshot();
+        Expect(FarRightTarget(model_d) == 2000 + buffer, "默认实例初始球场");
+        ConfigManager::Initialize(config_b, false);
+        Expect(&ConfigManager::Default().Snapshot()->court_points == &ConfigManager::Get().court_points,
+               "Get() 返回当前快照");
+        Expect(ConfigManager::Get().court_points[1].x == 4000, "重新初始化后 Get() 使用新配置");
+        Expect(FarRightTarget(model_d) == 4000 + buffer, "已绑定默认实例的模型切换到新配置");
+        Expect(first.expired(), "Get() 不保留热更新前的快照");
+        WriteCourt(court_b, 5000);
+        Touch(court_b, 400);
+        Expect(ConfigManager::Default().Reload(), "默认实例重新加载");
+        Expect(ConfigManager::Get().court_points[1].x == 5000, "Get() 看到热更新");
+        bool threw = false;
+        try {
+            ConfigManager::Initialize(g_dir + "/missing_config.json", false);
+        } catch (const std::exception&) {
+            threw = true;
+        }
+        Expect(threw && ConfigManager::Get().court_points[1].x == 5000, "加载失败时保留原配置");
+
+        for (const auto& path : {court_a, court_b, config_a, config_b}) std::remove(path.c_str());
+        rmdir(g_dir.c_str());
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (g_failures) {
+        std::cerr << g_failures << " 项失败\n";
+        return 1;
+    }
+    std::cout << "全部通过\n";
+    return 0;
+}
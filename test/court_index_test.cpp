@@ -0,0 +1,182 @@
+// 球场几何索引：透视四边形按行栅格化后的场内判断、逐行边界、边界余量，
+// 标量与 SIMD 过滤结果一致，以及模型在统计前丢弃场外检测；高空球不被当作场外，
+// 超出暂存区容量的检测计入调试信息。
+#include "TestUtil.hpp"
+#include "camera/CameramanModel.hpp"
+#include "camera/CourtIndex.hpp"
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+// 全景下的球场：远端边线短、近端边线长
+const std::vector<Point> kCourt = {{1000, 100}, {4376, 100}, {5376, 1400}, {0, 1400}};
+
+// 精确的点在凸四边形内判断（各边叉积同号），作为参照
+bool InsideConvex(const std::vector<Point>& polygon, Point p) {
+    bool positive = false, negative = false;
+    for (size_t i = 0; i < polygon.size(); ++i) {
+        const Point& a = polygon[i];
+        const Point& b = polygon[(i + 1) % polygon.size()];
+        const float cross = (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+        positive |= cross > 0;
+        negative |= cross < 0;
+    }
+    return !(positive && negative);
+}
+
+// 左右斜边上 y 处的精确 x
+float LeftEdge(float y) { return 1000.0f - (y - 100.0f) * 1000.0f / 1300.0f; }
+float RightEdge(float y) { return 4376.0f + (y - 100.0f) * 1000.0f / 1300.0f; }
+
+} // namespace
+
+int main() {
+    try {
+        {
+            CourtIndex index;
+            Expect(index.empty() && index.left() == 0.0f && index.right() == 1920.0f, "未构建时的默认边界");
+            Expect(index.contains({-1000.0f, -1000.0f}), "未构建时不过滤");
+
+            index.build(kCourt, 0.0f);
+            Expect(!index.empty() && index.rows() == 1300, "每像素一行");
+            Expect(index.left() == 0.0f && index.right() == 5376.0f, "整体 x 范围");
+
+            // 无余量时与精确判断一致，只允许边线附近一行斜率（约 1 像素）内的差异
+            std::mt19937 rng(3);
+            std::uniform_real_distribution<float> ux(-200.0f, 5576.0f), uy(0.0f, 1500.0f);
+            size_t mismatches = 0;
+            for (int i = 0; i < 200000; ++i) {
+                const Point p{ux(rng), uy(rng)};
+                const float band = std::min({std::fabs(p.x - LeftEdge(p.y)), std::fabs(p.x - RightEdge(p.y)),
+                                             std::fabs(p.y - 100.0f), std::fabs(p.y - 1400.0f)});
+                if (band > 2.0f && index.contains(p) != InsideConvex(kCourt, p)) ++mismatches;
+            }
+            Expect(mismatches == 0, "无余量时与精确多边形判断一致");
+
+            CourtIndex::Extents e;
+            Expect(index.extents(750.0f, e) && std::fabs(e.left - LeftEdge(750.0f)) < 1.0f &&
+                   std::fabs(e.right - RightEdge(750.0f)) < 1.0f, "逐行边界随 y 变化");
+            Expect(index.extents(150.0f, e) && e.left > 900.0f && e.right < 4500.0f, "远端边线附近较窄");
+            Expect(!index.extents(50.0f, e) && !index.extents(1450.0f, e), "索引以外的行");
+        }
+
+        {
+            CourtIndex index;
+            index.build(kCourt, 50.0f);
+            Expect(index.margin() == 50.0f && index.rows() == 1400, "余量扩展行数");
+            Expect(index.contains({2000.0f, 60.0f}), "远端边线外余量以内");
+            Expect(!index.contains({2000.0f, 40.0f}), "远端边线外余量以外（观众）");
+            Expect(index.contains({-40.0f, 1400.0f}), "近端角外余量以内");
+            Expect(!index.contains({-80.0f, 1400.0f}), "近端角外余量以外");
+            Expect(!index.contains({700.0f, 200.0f}), "远端角外侧");
+            Expect(!index.contains({std::numeric_limits<float>::quiet_NaN(), 500.0f}) &&
+                   !index.contains({500.0f, std::numeric_limits<float>::quiet_NaN()}), "NaN 视为场外");
+
+            // 标量与 SIMD 路径：相同的保留集合与顺序
+            std::mt19937 rng(7);
+            std::uniform_real_distribution<float> ux(-300.0f, 5676.0f), uy(-100.0f, 1600.0f);
+            std::vector<Point> points(1003);
+            for (auto& p : points) p = {ux(rng), uy(rng)};
+            points[5].y = std::numeric_limits<float>::quiet_NaN();
+            points[17].x = std::numeric_limits<float>::infinity();
+            std::vector<Point> scalar(points.size()), simd(points.size());
+            const size_t n_scalar = index.filter(points, scalar.data(), points.size(), SimdLevel::Scalar);
+            const size_t n_simd = index.filter(points, simd.data(), points.size(), SimdLevel::AVX2);
+            bool same = n_scalar == n_simd;
+            size_t expected = 0;
+            for (const auto& p : points) expected += index.contains(p);
+            for (size_t i = 0; same && i < n_scalar; ++i) {
+                same = scalar[i].x == simd[i].x && scalar[i].y == simd[i].y && index.contains(scalar[i]);
+            }
+            Expect(same && n_scalar == expected && expected > 0 && expected < points.size(),
+                   "标量与 SIMD 过滤结果一致");
+            Expect(index.filter(points, simd.data(), 10) <= 10, "超出容量的输入被忽略");
+        }
+
+        {
+            // 向上放宽：画面中高于地面投影的点按其下方 loft 以内的范围判断
+            CourtIndex floor, lofted;
+            floor.build(kCourt, 50.0f);
+            lofted.build(kCourt, 50.0f, 400.0f);
+            Expect(!floor.contains({200.0f, 1000.0f}) && lofted.contains({200.0f, 1000.0f}),
+                   "近端边线上方的高空球");
+            Expect(!floor.contains({2000.0f, -200.0f}) && lofted.contains({2000.0f, -200.0f}),
+                   "远端边线上方的高空球");
+            Expect(!lofted.contains({2000.0f, -400.0f}) && !lofted.contains({-300.0f, 1300.0f}) &&
+                   !lofted.contains({200.0f, 150.0f}), "放宽范围以外仍为场外");
+            Expect(lofted.contains({-40.0f, 1400.0f}) && !lofted.contains({-80.0f, 1400.0f}),
+                   "左右与向下余量不变");
+        }
+
+        {
+            // 模型：场外误检（观众、替补席）不影响目标，且计入调试信息
+            ConfigManager config("../config/camera_config.json", false);
+            CameramanModel clean(config, kCourt);
+            CameramanModel noisy(config, kCourt);
+            bool same = true;
+            uint32_t off_court = 0;
+            for (int f = 0; f < 90; ++f) {
+                const float x = 2000.0f + 10.0f * f;
+                const std::vector<Point> players = {{x, 400}, {x + 100, 700}, {x + 200, 1000}, {x + 50, 1200}};
+                const std::vector<Point> balls = {{x + 80, 800}};
+                std::vector<Point> noisy_players = players;
+                noisy_players.push_back({x + 150, 30});      // 远端看台
+                noisy_players.push_back({x - 300, 1490});    // 近端替补席
+                std::vector<Point> noisy_balls = balls;
+                noisy_balls.push_back({200, 150});           // 场外的备用球
+                const float a = clean.predict(players, balls);
+                const float b = noisy.predict(noisy_players, noisy_balls);
+                same = same && a == b;
+                off_court += noisy.getDebugInfo()->off_court;
+            }
+            Expect(same, "场外检测不影响输出");
+            Expect(off_court == 90 * 3, "场外检测计数");
+            Expect(clean.getDebugInfo()->off_court == 0, "场内检测不计数");
+        }
+
+        {
+            // 模型：靠近左侧边线的高空球投影在地面多边形之外，仍参与融合
+            ConfigManager config("../config/camera_config.json", false);
+            CameramanModel model(config, kCourt);
+            bool kept = true;
+            for (int f = 0; f < 10; ++f) {
+                const std::vector<Point> players = {{400, 1200}, {500, 1250}, {600, 1300}};
+                const std::vector<Point> balls = {{200.0f + f, 1000.0f - 10.0f * f}};
+                model.predict(players, balls);
+                kept = kept && model.getDebugInfo()->off_court == 0;
+            }
+            Expect(kept, "高空球不计为场外");
+            Expect(std::fabs(model.getDebugInfo()->ball_x - 209.0f) < 20.0f, "高空球参与融合");
+        }
+
+        {
+            // 模型：超出暂存区容量的检测被截断并计入调试信息与计数器
+            ConfigManager config("../config/camera_config.json", false);
+            CameramanModel model(config, kCourt);
+            const uint64_t before = Instrumentation::CounterValue(Counter::InputTruncated);
+            std::vector<Point> players(PlayerFilter::kDefaultCapacity + 44, Point{2500, 800});
+            const std::vector<Point> balls = {{2500, 800}};
+            model.predict(players, balls);
+            Expect(model.getDebugInfo()->truncated == 44, "截断数计入调试信息");
+#ifdef CAMERA_ENABLE_TRACE
+            Expect(Instrumentation::CounterValue(Counter::InputTruncated) - before == 44, "截断计数");
+#else
+            (void)before;
+#endif
+            players.resize(PlayerFilter::kDefaultCapacity);
+            model.predict(players, balls);
+            Expect(model.getDebugInfo()->truncated == 0, "容量以内不截断");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (g_failures) return 1;
+    std::cout << "全部通过" << std::endl;
+    return 0;
+}
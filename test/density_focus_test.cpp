@@ -0,0 +1,231 @@
+// 密度焦点：一端扎堆、少数球员落后时焦点对准扎堆一侧而均值被拉向中间；
+// 增量维护的直方图与只用窗口内各帧重新构建的结果逐位一致（按帧数与按时间淘汰）；
+// 计数相同的区间取靠近 hint 的一个。模型按 focus 配置切换，density 模式每帧不分配，
+// 快照恢复后输出逐位一致，未知模式的配置被拒绝。
+#include "AllocCounter.hpp"
+#include "TestUtil.hpp"
+#include "camera/CameramanModel.hpp"
+#include "camera/DetectionTrace.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <unistd.h>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace {
+
+const char* const kConfig = "../config/camera_config.json";
+constexpr float kCourtWidth = 5376.0f;
+
+bool SameBits(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+DensityFocus::Params DensityParams() {
+    DensityFocus::Params params;
+    params.mode = DensityFocus::Params::Mode::Density;
+    params.bins = 256;
+    params.window_pixels = 1200.0f;
+    return params;
+}
+
+// 6 名球员在右侧 3800~4300 扎堆，4 名分散落后在 2200~3400；全部通过 MAD 剔除
+std::vector<Point> ClusteredPlayers(float jitter) {
+    std::vector<Point> players;
+    for (float x : {3800.0f, 3900.0f, 4000.0f, 4100.0f, 4200.0f, 4300.0f, 2200.0f, 2600.0f, 3000.0f, 3400.0f}) {
+        players.push_back({x + jitter, 600.0f});
+    }
+    return players;
+}
+
+std::shared_ptr<ConfigManager::Params> LoadParams() {
+    ConfigManager file(kConfig, false);
+    return std::make_shared<ConfigManager::Params>(*file.Snapshot());
+}
+
+// 增量直方图与只用最近若干帧重新构建的直方图比较，timed 时按随机间隔带时间戳入队
+void CheckIncremental(bool timed) {
+    const size_t capacity = timed ? 60 : 15;
+    const uint64_t horizon_us = 483333;
+    DensityFocus incremental;
+    incremental.configure(DensityParams(), 0.0f, kCourtWidth);
+    if (timed) {
+        incremental.reset(capacity, horizon_us);
+    } else {
+        incremental.reset(capacity);
+    }
+
+    std::mt19937 rng(timed ? 7 : 3);
+    std::uniform_real_distribution<float> x_dist(-100.0f, kCourtWidth + 100.0f);
+    std::uniform_int_distribution<int> count_dist(0, 12);
+    std::uniform_int_distribution<uint64_t> gap_dist(10000, 70000);
+    std::vector<std::vector<float>> frames;
+    std::vector<uint64_t> times;
+    uint64_t now = 1000000;
+    bool same = true;
+    for (int f = 0; f < 400; ++f) {
+        std::vector<float> xs(count_dist(rng));
+        for (float& x : xs) x = x_dist(rng);
+        now += gap_dist(rng);
+        frames.push_back(xs);
+        times.push_back(now);
+        if (timed) {
+            incremental.push(Span<const float>(xs), now);
+        } else {
+            incremental.push(Span<const float>(xs));
+        }
+
+        // 重新构建：按相同规则得到窗口内的帧，依次入队到足够大的窗口
+        size_t first = frames.size() > capacity ? frames.size() - capacity : 0;
+        while (timed && frames.size() - first > 2 && now - times[first] >= horizon_us) ++first;
+        DensityFocus fresh;
+        fresh.configure(DensityParams(), 0.0f, kCourtWidth);
+        fresh.reset(frames.size() + 1);
+        for (size_t i = first; i < frames.size(); ++i) fresh.push(Span<const float>(frames[i]));
+
+        float a = 0.0f, b = 0.0f;
+        const bool found_a = incremental.locate(2500.0f, a);
+        const bool found_b = fresh.locate(2500.0f, b);
+        same &= incremental.total() == fresh.total() && found_a == found_b && SameBits(a, b);
+    }
+    Expect(same, timed ? "按时间淘汰的增量直方图与重新构建一致" : "按帧数淘汰的增量直方图与重新构建一致");
+}
+
+} // namespace
+
+int main() {
+    try {
+        {
+            // 扎堆一侧：焦点落在右侧球员群中，均值被落后球员拉向左侧
+            DensityFocus focus;
+            focus.configure(DensityParams(), 0.0f, kCourtWidth);
+            focus.reset(15);
+            std::vector<float> xs;
+            for (const Point& p : ClusteredPlayers(0.0f)) xs.push_back(p.x);
+            float mean = 0.0f;
+            for (float x : xs) mean += x;
+            mean /= xs.size();
+            focus.push(Span<const float>(xs));
+            float x = 0.0f;
+            Expect(focus.locate(mean, x) && x > 3700.0f && x < 4150.0f && x - mean > 250.0f,
+                   "焦点对准扎堆的一侧");
+
+            // 两群人数相同：取靠近 hint 的一群
+            DensityFocus twin;
+            twin.configure(DensityParams(), 0.0f, kCourtWidth);
+            twin.reset(15);
+            const std::vector<float> groups = {1000.0f, 1050.0f, 1100.0f, 4000.0f, 4050.0f, 4100.0f};
+            twin.push(Span<const float>(groups));
+            float left = 0.0f, right = 0.0f;
+            Expect(twin.locate(900.0f, left) && twin.locate(4200.0f, right) &&
+                   std::fabs(left - 1050.0f) < 30.0f && std::fabs(right - 4050.0f) < 30.0f,
+                   "计数相同时取靠近 hint 的区间");
+
+            DensityFocus empty;
+            empty.configure(DensityParams(), 0.0f, kCourtWidth);
+            empty.reset(15);
+            empty.push(Span<const float>());
+            Expect(!empty.locate(2000.0f, x), "窗口内没有球员时不输出");
+        }
+
+        CheckIncremental(false);
+        CheckIncremental(true);
+
+        // 模型：mean 模式下融合位置就是均值；density 模式对准扎堆一侧
+        auto mean_params = LoadParams();
+        mean_params->focus.mode = ConfigManager::Params::FocusParams::Mode::Mean;
+        auto density_params = std::make_shared<ConfigManager::Params>(*mean_params);
+        density_params->focus.mode = ConfigManager::Params::FocusParams::Mode::Density;
+        ConfigManager mean_config(mean_params);
+        ConfigManager density_config(density_params);
+        {
+            CameramanModel mean_model(mean_config);
+            CameramanModel density_model(density_config);
+            const std::vector<Point> balls = {{3900.0f, 700.0f}};
+            for (int f = 0; f < 30; ++f) {
+                const std::vector<Point> players = ClusteredPlayers(static_cast<float>(f % 5));
+                mean_model.predict(players, balls);
+                density_model.predict(players, balls);
+            }
+            const auto mean_info = mean_model.getDebugInfo();
+            const auto density_info = density_model.getDebugInfo();
+            Expect(mean_info && SameBits(mean_info->focus_x, mean_info->mean_player_pos),
+                   "mean 模式融合均值");
+            Expect(density_info && density_info->focus_x > 3700.0f && density_info->focus_x < 4150.0f &&
+                   density_info->raw_target > mean_info->raw_target + 150.0f, "density 模式对准扎堆一侧");
+        }
+
+        {
+            // 合成序列：density 模式每帧不分配，快照恢复后后续输出逐位一致
+            SyntheticTraceOptions options;
+            options.frames = 900;
+            const DetectionTrace trace = GenerateSyntheticTrace(options);
+            CameramanModel primary(density_config);
+            // 首帧初始化记忆窗口与帧环
+            primary.predict(trace.framePlayers(0), trace.frameBalls(0), trace.frames[0].timestamp_us);
+            size_t allocations = 0;
+            {
+                ScopedAllocCount counter;
+                for (size_t f = 1; f < 450; ++f) {
+                    primary.predict(trace.framePlayers(f), trace.frameBalls(f),
+                                    trace.frames[f].timestamp_us);
+                }
+                allocations = counter.count();
+            }
+            Expect(allocations == 0, "density 模式每帧不分配");
+
+            std::vector<uint8_t> state;
+            primary.saveState(state);
+            CameramanModel standby(density_config);
+            standby.restoreState(Span<const uint8_t>(state));
+            bool same = true;
+            for (size_t f = 450; f < trace.size(); ++f) {
+                const float a = primary.predict(trace.framePlayers(f), trace.frameBalls(f),
+                                                trace.frames[f].timestamp_us);
+                const float b = standby.predict(trace.framePlayers(f), trace.frameBalls(f),
+                                                trace.frames[f].timestamp_us);
+                same &= SameBits(a, b);
+            }
+            Expect(same, "快照恢复后输出逐位一致");
+        }
+
+        {
+            // 配置文件：focus 段按名称选择模式，未知名称拒绝
+            char dir_template[] = "/tmp/density_focus_testXXXXXX";
+            const std::string dir = mkdtemp(dir_template);
+            const std::string path = dir + "/camera_config.json";
+            json data = json::parse(std::ifstream(kConfig));
+            data["focus"] = {{"mode", "density"}, {"bins", 128}, {"window_pixels", 900}};
+            std::ofstream(path) << data.dump(2);
+            {
+                ConfigManager config(path, false);
+                const auto& focus = config.Snapshot()->focus;
+                Expect(focus.mode == ConfigManager::Params::FocusParams::Mode::Density &&
+                       focus.bins == 128 && focus.window_pixels == 900.0f, "读取 focus 段");
+            }
+            data["focus"]["mode"] = "median";
+            std::ofstream(path) << data.dump(2);
+            bool rejected = false;
+            try {
+                ConfigManager config(path, false);
+            } catch (const std::runtime_error&) {
+                rejected = true;
+            }
+            Expect(rejected, "未知 focus 模式被拒绝");
+            std::remove(path.c_str());
+            rmdir(dir.c_str());
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (g_failures) return 1;
+    std::cout << "全部通过" << std::endl;
+    return 0;
+}
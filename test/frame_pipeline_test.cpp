@@ -0,0 +1,216 @@
+// 异步流水线：BoundedQueue 多生产者多消费者争用下每个元素恰好出队一次、同一生产者的元素保持顺序；
+// DropOldest 积压时只保留最新的若干帧且每帧一条指令；Coalesce 积压时全部送入模型、只输出最新一帧；
+// 生产端持续超速时两种策略都仍在输出指令；固定帧率的帧不计入延迟统计。
+#include "TestUtil.hpp"
+#include "camera/FramePipeline.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+DetectionFrame MakeFrame(uint64_t sequence) {
+    const float x = 2500.0f + static_cast<float>(sequence % 40) * 10.0f;
+    const std::vector<Point> players = {{x - 100.0f, 600.0f}, {x, 600.0f}, {x + 100.0f, 600.0f}};
+    const std::vector<Point> balls = {{x, 700.0f}};
+    DetectionFrame frame;
+    frame.sequence = sequence;
+    frame.timestamp_ns = Instrumentation::NowNs();
+    frame.assign(players, balls);
+    return frame;
+}
+
+// 生产者不停提交预先生成的帧，消费者收到 20 条指令（或超时）后停止；
+// 返回生产端运行期间收到的指令数，max_merged 为单条指令合并的最多帧数
+uint64_t RunOverloaded(CameramanModel& model, FramePipeline::OverloadPolicy policy,
+                       FramePipeline::Metrics& metrics, uint32_t& max_merged) {
+    FramePipeline::Options options;
+    options.policy = policy;
+    FramePipeline pipeline(model, options);
+    std::vector<DetectionFrame> frames;
+    for (uint64_t s = 0; s < 64; ++s) frames.push_back(MakeFrame(s));
+    pipeline.start();
+
+    constexpr uint64_t kWanted = 20;
+    std::atomic<bool> producing{true};
+    std::thread producer([&] {
+        for (size_t i = 0; producing.load(std::memory_order_relaxed); ++i) {
+            DetectionFrame& frame = frames[i % frames.size()];
+            frame.sequence = i;
+            frame.timestamp_ns = Instrumentation::NowNs();
+            pipeline.submit(frame);
+        }
+    });
+
+    uint64_t received = 0;
+    max_merged = 0;
+    PtzCommand command;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (received < kWanted && std::chrono::steady_clock::now() < deadline) {
+        if (pipeline.poll(command)) {
+            ++received;
+            max_merged = std::max(max_merged, command.frames_merged);
+        }
+    }
+    producing.store(false);
+    producer.join();
+    pipeline.stop();
+    metrics = pipeline.metrics();
+    return received;
+}
+
+} // namespace
+
+int main() {
+    {
+        // 4 个生产者、4 个消费者争用容量 64 的队列
+        constexpr uint32_t kProducers = 4;
+        constexpr uint32_t kConsumers = 4;
+        constexpr uint32_t kPerProducer = 100000;
+        BoundedQueue<uint64_t> queue(64);
+        std::vector<std::vector<uint64_t>> popped(kConsumers);
+        std::atomic<uint32_t> producers_done{0};
+
+        std::vector<std::thread> threads;
+        for (uint32_t p = 0; p < kProducers; ++p) {
+            threads.emplace_back([&, p] {
+                for (uint32_t i = 0; i < kPerProducer; ++i) {
+                    const uint64_t value = (uint64_t{p} << 32) | i;
+                    while (!queue.tryPush(value)) std::this_thread::yield();
+                }
+                producers_done.fetch_add(1);
+            });
+        }
+        for (uint32_t c = 0; c < kConsumers; ++c) {
+            threads.emplace_back([&, c] {
+                uint64_t value;
+                for (;;) {
+                    if (queue.tryPop(value)) {
+                        popped[c].push_back(value);
+                    } else if (producers_done.load() == kProducers && queue.size() == 0) {
+                        break;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+
+        std::vector<uint32_t> seen(size_t{kProducers} * kPerProducer, 0);
+        bool ordered = true;
+        for (const auto& values : popped) {
+            std::vector<int64_t> last(kProducers, -1);
+            for (uint64_t value : values) {
+                const uint32_t p = static_cast<uint32_t>(value >> 32);
+                const uint32_t i = static_cast<uint32_t>(value);
+                ordered &= p < kProducers && static_cast<int64_t>(i) > last[p];
+                if (p < kProducers) {
+                    last[p] = i;
+                    ++seen[size_t{p} * kPerProducer + i];
+                }
+            }
+        }
+        bool exactly_once = true;
+        for (uint32_t n : seen) exactly_once &= n == 1;
+        Expect(exactly_once, "争用下每个元素恰好出队一次");
+        Expect(ordered, "同一生产者的元素按入队顺序出队");
+        Expect(queue.capacity() == 64 && queue.size() == 0, "容量与排空后的深度");
+    }
+
+    try {
+        ConfigManager config("../config/camera_config.json", false);
+
+        {
+            // DropOldest：工作线程启动前提交 20 帧，队列只保留最新 8 帧，每帧一条指令
+            CameramanModel model(config);
+            FramePipeline::Options options;
+            options.policy = FramePipeline::OverloadPolicy::DropOldest;
+            FramePipeline pipeline(model, options);
+            size_t rejected = 0;
+            for (uint64_t s = 0; s < 20; ++s) rejected += !pipeline.submit(MakeFrame(s));
+            pipeline.start();
+            pipeline.stop();
+
+            const auto m = pipeline.metrics();
+            Expect(rejected == 12 && m.dropped_input == 12, "DropOldest 淘汰最旧的 12 帧");
+            Expect(m.processed == 8 && m.emitted == 8 && m.coalesced == 0, "DropOldest 每帧一条指令");
+            PtzCommand command;
+            bool in_order = true;
+            for (uint64_t s = 12; s < 20; ++s) {
+                in_order &= pipeline.poll(command) && command.sequence == s && command.frames_merged == 1;
+            }
+            Expect(in_order && !pipeline.poll(command), "DropOldest 按顺序输出最新 8 帧");
+        }
+
+        {
+            // Coalesce：积压的 8 帧全部送入模型，只为最新一帧输出一条指令
+            CameramanModel model(config);
+            CameramanModel reference(config);
+            FramePipeline::Options options;
+            options.policy = FramePipeline::OverloadPolicy::Coalesce;
+            FramePipeline pipeline(model, options);
+            float expected = 0.0f;
+            for (uint64_t s = 0; s < 20; ++s) {
+                const DetectionFrame frame = MakeFrame(s);
+                pipeline.submit(frame);
+                if (s >= 12) expected = PredictDetectionFrame(reference, frame);
+            }
+            pipeline.start();
+            pipeline.stop();
+
+            const auto m = pipeline.metrics();
+            PtzCommand command;
+            Expect(m.processed == 8 && m.emitted == 1 && m.coalesced == 7, "Coalesce 合并积压帧");
+            Expect(pipeline.poll(command) && command.sequence == 19 && command.frames_merged == 8 &&
+                   command.target_x == expected, "Coalesce 输出最新一帧且历史连续");
+        }
+
+        {
+            // 固定帧率（timestamp_ns 为 0）的帧没有采集时刻，延迟统计保持为 0
+            CameramanModel model(config);
+            FramePipeline pipeline(model, FramePipeline::Options());
+            for (uint64_t s = 0; s < 4; ++s) {
+                DetectionFrame frame = MakeFrame(s);
+                frame.timestamp_ns = 0;
+                pipeline.submit(frame);
+            }
+            pipeline.start();
+            pipeline.stop();
+
+            const auto m = pipeline.metrics();
+            Expect(m.emitted == 4, "固定帧率的帧全部输出");
+            Expect(m.latency_max_ns == 0 && m.latency_mean_ns == 0 && m.latency_p99_ns == 0,
+                   "固定帧率的帧不计入延迟");
+        }
+
+        {
+            // 生产端持续超速：队列一直非空，两种策略都必须持续输出指令
+            for (auto policy : {FramePipeline::OverloadPolicy::DropOldest,
+                                FramePipeline::OverloadPolicy::Coalesce}) {
+                CameramanModel model(config);
+                FramePipeline::Metrics m{};
+                uint32_t max_merged = 0;
+                const uint64_t received = RunOverloaded(model, policy, m, max_merged);
+                const bool coalesce = policy == FramePipeline::OverloadPolicy::Coalesce;
+                Expect(received >= 20, coalesce ? "Coalesce 过载时仍输出指令"
+                                                : "DropOldest 过载时仍输出指令");
+                // 每条指令最多合并取帧时已积压的帧，不超过输入队列容量
+                Expect(max_merged >= 1 && max_merged <= FramePipeline::Options().input_capacity,
+                       coalesce ? "Coalesce 单条指令合并的帧数有界" : "DropOldest 每帧一条指令");
+                Expect(m.submitted > m.emitted && m.dropped_input + m.coalesced > 0,
+                       coalesce ? "Coalesce 过载时丢弃或合并了帧" : "DropOldest 过载时丢弃了帧");
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (g_failures) return 1;
+    std::cout << "全部通过" << std::endl;
+    return 0;
+}
@@ -0,0 +1,56 @@
+// 埋点线程缓冲：短生命周期线程退出后缓冲交由新线程复用，缓冲数不随线程创建次数增长；
+// 已退出线程的计数保留在汇总中，未导出的消息仍由导出线程输出。
+#include "TestUtil.hpp"
+#include "camera/Instrumentation.hpp"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+int main() {
+    constexpr int kBatches = 50;
+    constexpr int kThreadsPerBatch = 4;
+
+    FILE* sink = std::tmpfile();
+    if (!sink) {
+        std::cerr << "Error: tmpfile failed" << std::endl;
+        return 1;
+    }
+    Instrumentation::StartExporter(sink, std::chrono::hours(1));
+
+    // 主线程先取得自己的缓冲
+    Instrumentation::Count(Counter::BoundaryClamp, 0);
+    const size_t initial_buffers = Instrumentation::ThreadBufferCount();
+    const uint64_t initial_count = Instrumentation::CounterValue(Counter::BoundaryClamp);
+
+    for (int b = 0; b < kBatches; ++b) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreadsPerBatch; ++t) {
+            threads.emplace_back([] {
+                Instrumentation::Count(Counter::BoundaryClamp, 3);
+                Instrumentation::Log("instrumentation_test worker");
+            });
+        }
+        for (auto& t : threads) t.join();
+    }
+
+    Expect(Instrumentation::ThreadBufferCount() <= initial_buffers + kThreadsPerBatch,
+           "缓冲数以并发线程数为上限");
+    Expect(Instrumentation::CounterValue(Counter::BoundaryClamp) - initial_count ==
+           3u * kBatches * kThreadsPerBatch, "已退出线程的计数保留");
+
+    Instrumentation::StopExporter();
+    std::rewind(sink);
+    char line[256];
+    int messages = 0;
+    while (std::fgets(line, sizeof(line), sink)) {
+        messages += std::strstr(line, "instrumentation_test worker") != nullptr;
+    }
+    std::fclose(sink);
+    Expect(messages == kBatches * kThreadsPerBatch, "已退出线程的消息全部导出");
+
+    if (g_failures) return 1;
+    std::cout << "全部通过" << std::endl;
+    return 0;
+}
@@ -4,13 +4,15 @@
 
 int main() {
     try {
+        // 诊断信息由导出线程输出，帧路径不做控制台 I/O
+        Instrumentation::StartExporter();
         ConfigManager::Initialize("../config/camera_config.json");
 
         // 直接用ConfigManager里的court_points
-        CameramanModel model(ConfigManager::Get().court_points);
+        CameramanModel model(ConfigManager::Default().Snapshot()->court_points);
 
-        // 模拟输入数据
-        std::vector<Point> players = {{500, 300}, {600, 400}};
+        // 模拟输入数据（每帧不少于 safety.min_players 名球员）
+        std::vector<Point> players = {{500, 300}, {550, 500}, {600, 400}};
         std::vector<Point> balls = {{550, 350}};
         {
             float target = model.predict(players, balls);
@@ -18,7 +20,7 @@ int main() {
             std::cout << "Predicted Camera Target X: " << target << std::endl;
             std::cout << "Transfer result: Y = " << y << ", FOV = " << fov << std::endl;
         }
-        players = {{600, 300}, {700, 400}};
+        players = {{600, 300}, {650, 500}, {700, 400}};
         balls = {{570, 350}};
         {
             float target = model.predict(players, balls);
@@ -26,7 +28,7 @@ int main() {
             std::cout << "Predicted Camera Target X: " << target << std::endl;
             std::cout << "Transfer result: Y = " << y << ", FOV = " << fov << std::endl;
         }
-        players = {{700, 300}, {800, 400}};
+        players = {{700, 300}, {750, 500}, {800, 400}};
         balls = {{580, 350}};
         {
             float target = model.predict(players, balls);
@@ -35,6 +37,7 @@ int main() {
             std::cout << "Transfer result: Y = " << y << ", FOV = " << fov << std::endl;
         }
 
+        Instrumentation::StopExporter();
         return 0;
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
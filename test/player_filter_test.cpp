@@ -0,0 +1,131 @@
+// PlayerFilter：观众、替补席检测被中位数/MAD 剔除；幸存者不足 min_players 时保持；
+// 均值单帧突跳先保持，持续 3 帧后接受；预热后 filter() 不分配。
+// 模型开局若干帧球员不足时保持在初始化位置，不回落到 0。
+#include "AllocCounter.hpp"
+#include "TestUtil.hpp"
+#include "camera/CameramanModel.hpp"
+#include "camera/PlayerFilter.hpp"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+ConfigManager::Params::SafetyParams MakeSafety() {
+    return {200, 3, 50};
+}
+
+std::vector<Point> Cluster(float center, size_t n) {
+    std::vector<Point> points;
+    for (size_t i = 0; i < n; ++i) {
+        points.push_back({center + 20.0f * (static_cast<float>(i) - n / 2.0f), 500.0f});
+    }
+    return points;
+}
+
+} // namespace
+
+int main() {
+    {
+        // 10 名球员聚在 2000 附近，看台与替补席各有误检
+        PlayerFilter filter(MakeSafety());
+        std::vector<Point> players = Cluster(2000.0f, 10);
+        const PlayerStats clean = ReducePlayerX(players.data(), players.size());
+        players.push_back({100.0f, 900.0f});
+        players.push_back({5200.0f, 50.0f});
+        players.push_back({4800.0f, 60.0f});
+
+        const auto result = filter.filter(Span<const Point>(players));
+        Expect(!result.held, "正常帧不保持");
+        Expect(result.rejected == 3, "三个离群检测被剔除");
+        Expect(result.stats.count == 10, "幸存者为全部球员");
+        Expect(std::fabs(result.stats.mean() - clean.mean()) < 1e-3f, "幸存者均值不受离群点影响");
+        Expect(result.stats.min == clean.min && result.stats.max == clean.max, "幸存者最值不受离群点影响");
+    }
+
+    {
+        // 离中位数不超过 noise_threshold 的球员即使 MAD 很小也保留
+        PlayerFilter filter(MakeSafety());
+        std::vector<Point> players = {{1000, 0}, {1000, 0}, {1000, 0}, {1000, 0}, {1150, 0}};
+        const auto result = filter.filter(Span<const Point>(players));
+        Expect(result.rejected == 0, "noise_threshold 内的球员不被剔除");
+    }
+
+    {
+        PlayerFilter filter(MakeSafety());
+        std::vector<Point> two = Cluster(1500.0f, 2);
+        Expect(filter.filter(Span<const Point>(two)).held, "少于 min_players 时保持");
+        Expect(filter.filter(Span<const Point>()).held, "空帧保持");
+
+        // 剔除后不足 min_players 同样保持
+        std::vector<Point> sparse = Cluster(1500.0f, 2);
+        sparse.push_back({1510.0f, 0.0f});
+        sparse.push_back({4000.0f, 0.0f});
+        const auto result = filter.filter(Span<const Point>(sparse));
+        Expect(!result.held && result.stats.count == 3, "剔除后恰好 min_players 时不保持");
+    }
+
+    {
+        // 均值突跳：前两帧保持，第三帧接受新位置
+        PlayerFilter filter(MakeSafety());
+        std::vector<Point> left = Cluster(1000.0f, 8);
+        std::vector<Point> right = Cluster(3000.0f, 8);
+        Expect(!filter.filter(Span<const Point>(left)).held, "首帧接受");
+        Expect(filter.filter(Span<const Point>(right)).held, "突跳第 1 帧保持");
+        Expect(filter.filter(Span<const Point>(right)).held, "突跳第 2 帧保持");
+        const auto accepted = filter.filter(Span<const Point>(right));
+        Expect(!accepted.held && std::fabs(accepted.stats.mean() - 2990.0f) < 1.0f,
+               "持续 3 帧后接受新位置");
+        Expect(!filter.filter(Span<const Point>(right)).held, "接受后以新位置为参考");
+
+        // 单帧闪跳后回到原位，不累计
+        Expect(filter.filter(Span<const Point>(left)).held, "单帧闪跳保持");
+        Expect(!filter.filter(Span<const Point>(right)).held, "回到原位后计数清零");
+        Expect(filter.filter(Span<const Point>(left)).held, "再次闪跳仍从第 1 帧计");
+    }
+
+    {
+        PlayerFilter filter(MakeSafety());
+        std::vector<Point> players = Cluster(2000.0f, 24);
+        players.push_back({10.0f, 0.0f});
+        filter.filter(Span<const Point>(players));
+        size_t allocations = 0;
+        float checksum = 0.0f;
+        {
+            ScopedAllocCount counter;
+            for (int i = 0; i < 1000; ++i) {
+                checksum += filter.filter(Span<const Point>(players)).stats.sum;
+            }
+            allocations = counter.count();
+        }
+        Expect(allocations == 0, "filter() 不分配");
+        Expect(checksum > 0.0f, "checksum");
+    }
+
+    {
+        // 开局 20 帧只有 2 名球员（少于 min_players）：记忆窗口以首个球员初始化，
+        // 保持帧沿用该位置，球未确认前融合的球位置也取该位置
+        ConfigManager config("../config/camera_config.json", false);
+        CameramanModel model(config);
+        const std::vector<Point> two = {{2500.0f, 600.0f}, {2600.0f, 600.0f}};
+        const std::vector<Point> balls = {{2550.0f, 700.0f}};
+        bool held_in_place = true;
+        for (int f = 0; f < 20; ++f) {
+            model.predict(two, balls);
+            const auto info = model.getDebugInfo();
+            held_in_place &= info && info->player_hold && info->mean_player_pos == 2500.0f &&
+                             info->window_mean == 2500.0f && info->raw_target >= 2500.0f &&
+                             info->raw_target <= 2550.0f;
+        }
+        Expect(held_in_place, "开局球员不足时保持在初始化位置");
+
+        const std::vector<Point> three = {{2500.0f, 600.0f}, {2600.0f, 600.0f}, {2700.0f, 600.0f}};
+        model.predict(three, balls);
+        const auto info = model.getDebugInfo();
+        Expect(info && !info->player_hold && info->mean_player_pos == 2600.0f, "球员足够后接受均值");
+    }
+
+    if (g_failures) return 1;
+    std::cout << "全部通过" << std::endl;
+    return 0;
+}
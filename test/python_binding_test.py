@@ -0,0 +1,90 @@
+"""Python 绑定冒烟测试：predict_batch 与逐帧 predict 逐位一致，快照保存/恢复后两路输出一致，
+transfer_many 与输入等长。没有 numpy 时以 77 退出，CTest 记为跳过。
+
+由 CTest 在 test/ 下运行，CAMERAMAN_LIB 指向构建出的 libcameraman_c，PYTHONPATH 含 python/。
+"""
+import sys
+
+try:
+    import numpy as np
+except ImportError:
+    print("numpy 不可用，跳过")
+    sys.exit(77)
+
+import cameraman
+
+CONFIG = "../config/camera_config.json"
+FRAMES = 600
+PLAYERS = 5
+
+failures = 0
+
+
+def expect(ok, what):
+    global failures
+    if not ok:
+        print("失败: " + what, file=sys.stderr)
+        failures += 1
+
+
+def make_trace():
+    """确定性的检测序列，CSR 布局；每 7 帧一帧空球。"""
+    rng = np.random.default_rng(12345)
+    centers = 2000.0 + np.cumsum(rng.normal(0.0, 8.0, FRAMES))
+    players = np.empty((FRAMES * PLAYERS, 2), dtype=np.float32)
+    players[:, 0] = np.repeat(centers, PLAYERS) + rng.normal(0.0, 150.0, FRAMES * PLAYERS)
+    players[:, 1] = 600.0 + rng.normal(0.0, 100.0, FRAMES * PLAYERS)
+    player_offsets = np.arange(0, FRAMES * PLAYERS + 1, PLAYERS, dtype=np.uint64)
+
+    has_ball = np.arange(FRAMES) % 7 != 0
+    balls = np.empty((int(has_ball.sum()), 2), dtype=np.float32)
+    balls[:, 0] = centers[has_ball] + rng.normal(0.0, 40.0, len(balls))
+    balls[:, 1] = 700.0
+    ball_offsets = np.concatenate(([0], np.cumsum(has_ball))).astype(np.uint64)
+    return players, player_offsets, balls, ball_offsets
+
+
+def frame(points, offsets, f):
+    return points[int(offsets[f]):int(offsets[f + 1])]
+
+
+def main():
+    players, player_offsets, balls, ball_offsets = make_trace()
+
+    with cameraman.Model(CONFIG) as batch_model, cameraman.Model(CONFIG) as frame_model:
+        batch = batch_model.predict_batch(players, player_offsets, balls, ball_offsets)
+        single = np.array([frame_model.predict(frame(players, player_offsets, f),
+                                               frame(balls, ball_offsets, f))
+                           for f in range(FRAMES)], dtype=np.float32)
+        expect(batch.shape == (FRAMES,) and batch.dtype == np.float32, "批量输出形状")
+        expect(np.array_equal(batch.view(np.uint32), single.view(np.uint32)), "批量与逐帧逐位一致")
+
+        ys, fovs = batch_model.transfer_many(batch)
+        expect(ys.shape == batch.shape and fovs.shape == batch.shape, "transfer_many 与输入等长")
+
+    half = FRAMES // 2
+    head = (players[:int(player_offsets[half])], player_offsets[:half + 1],
+            balls[:int(ball_offsets[half])], ball_offsets[:half + 1])
+    tail = (players[int(player_offsets[half]):], player_offsets[half:] - player_offsets[half],
+            balls[int(ball_offsets[half]):], ball_offsets[half:] - ball_offsets[half])
+
+    with cameraman.Model(CONFIG) as primary, cameraman.Model(CONFIG) as standby:
+        primary.predict_batch(*head)
+        state = primary.save_state()
+        standby.restore_state(state)
+        expect(isinstance(state, bytes) and len(state) > 0, "快照非空")
+        expect(standby.save_state() == state, "恢复后的快照与原快照相同")
+
+        a = primary.predict_batch(*tail)
+        b = standby.predict_batch(*tail)
+        expect(np.array_equal(a.view(np.uint32), b.view(np.uint32)), "恢复后两路输出逐位一致")
+        expect(np.array_equal(a.view(np.uint32), batch[half:].view(np.uint32)), "分段与整段输出一致")
+
+    if failures:
+        return 1
+    print("全部通过")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
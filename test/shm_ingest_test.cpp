@@ -0,0 +1,189 @@
+// 共享内存接入：fork 出的替身检测进程把合成序列写进检测环，同时读取指令环；
+// 本进程以 ShmIngest 直接从槽位 predict。指令须按序到达且与进程内逐帧 predict 逐位一致，
+// 处理路径不分配。另测环的容量语义、段格式校验与序号缺口统计。
+#include "AllocCounter.hpp"
+#include "TestUtil.hpp"
+#include "camera/DetectionTrace.hpp"
+#include "camera/ShmIngest.hpp"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+// 采集时刻整体后移 1 秒：timestamp_ns 为 0 表示按固定帧率处理
+uint64_t TimestampNs(const DetectionTrace& trace, size_t f) {
+    return (trace.frames[f].timestamp_us + 1000000) * 1000;
+}
+
+DetectionFrame MakeFrame(const DetectionTrace& trace, size_t f) {
+    DetectionFrame frame;
+    frame.assign(trace.framePlayers(f), trace.frameBalls(f));
+    frame.sequence = f;
+    frame.timestamp_ns = TimestampNs(trace, f);
+    return frame;
+}
+
+// 替身检测进程：逐帧写入检测环（环满时等待，以便逐帧比较），边写边读指令环并核对。
+// 返回进程退出码
+int RunDetector(const std::string& detections_name, const std::string& commands_name,
+                const DetectionTrace& trace, const std::vector<float>& expected) {
+    ShmRing<DetectionFrame> detections(detections_name, ShmMode::Open);
+    ShmRing<PtzCommand> commands(commands_name, ShmMode::Open);
+    size_t next_command = 1;
+    bool ok = true;
+    auto drain = [&] {
+        PtzCommand command;
+        while (commands.tryPop(command)) {
+            ok = ok && command.sequence == next_command &&
+                 command.timestamp_ns == TimestampNs(trace, next_command) &&
+                 std::memcmp(&command.target_x, &expected[next_command], sizeof(float)) == 0;
+            ++next_command;
+        }
+    };
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    for (size_t f = 1; f < trace.size(); ++f) {
+        DetectionFrame* slot;
+        while (!(slot = detections.acquire())) {
+            drain();
+            if (std::chrono::steady_clock::now() > deadline) return 2;
+            std::this_thread::yield();
+        }
+        // 原地填写槽位
+        slot->assign(trace.framePlayers(f), trace.frameBalls(f));
+        slot->sequence = f;
+        slot->timestamp_ns = TimestampNs(trace, f);
+        detections.commit();
+        drain();
+    }
+    while (next_command < trace.size() && std::chrono::steady_clock::now() < deadline) {
+        drain();
+        std::this_thread::yield();
+    }
+    return ok && next_command == trace.size() ? 0 : 1;
+}
+
+} // namespace
+
+int main() {
+    try {
+        const std::string suffix = std::to_string(getpid());
+        {
+            // 容量语义：写满 capacity 个后拒绝，读出后可继续写；同名段可以再次打开
+            ShmRing<uint64_t> ring("/cameraman_test_ring_" + suffix, ShmMode::Create, 8);
+            ShmRing<uint64_t> producer(ring.name(), ShmMode::Open);
+            size_t pushed = 0;
+            while (producer.tryPush(pushed)) ++pushed;
+            Expect(pushed == 8 && producer.capacity() == 8 && ring.size() == 8, "写满容量后拒绝");
+            uint64_t value = 0;
+            Expect(ring.tryPop(value) && value == 0 && producer.tryPush(8), "读出后可继续写入");
+            bool ordered = true;
+            for (uint64_t i = 1; i <= 8; ++i) ordered = ordered && ring.tryPop(value) && value == i;
+            Expect(ordered && !ring.tryPop(value), "按序读出");
+
+            bool rejected = false;
+            try {
+                ShmRing<uint32_t> wrong(ring.name(), ShmMode::Open);
+            } catch (const std::runtime_error&) {
+                rejected = true;
+            }
+            Expect(rejected, "槽位大小不符时拒绝打开");
+        }
+        {
+            bool rejected = false;
+            try {
+                ShmRing<uint64_t> missing("/cameraman_test_missing_" + suffix, ShmMode::Open);
+            } catch (const std::runtime_error&) {
+                rejected = true;
+            }
+            Expect(rejected, "段不存在时抛出");
+        }
+
+        SyntheticTraceOptions trace_options;
+        trace_options.frames = 3000;
+        const DetectionTrace trace = GenerateSyntheticTrace(trace_options);
+
+        ConfigManager config("../config/camera_config.json", false);
+        std::vector<float> expected(trace.size());
+        {
+            CameramanModel reference(config);
+            for (size_t f = 0; f < trace.size(); ++f) {
+                expected[f] = PredictDetectionFrame(reference, MakeFrame(trace, f));
+            }
+        }
+
+        CameramanModel model(config);
+        // 首帧在进程内处理，完成历史窗口等的初始化
+        PredictDetectionFrame(model, MakeFrame(trace, 0));
+
+        ShmIngest::Options options;
+        options.detections = "/cameraman_test_det_" + suffix;
+        options.commands = "/cameraman_test_cmd_" + suffix;
+        options.detection_capacity = 16;
+        options.command_capacity = 16;
+        ShmIngest ingest(model, options);
+
+        std::cout.flush();
+        const pid_t child = fork();
+        if (child < 0) throw std::runtime_error("fork failed");
+        if (child == 0) {
+            int code = 3;
+            try {
+                code = RunDetector(options.detections, options.commands, trace, expected);
+            } catch (...) {
+            }
+            _exit(code);
+        }
+
+        int status = 0;
+        bool exited = false;
+        size_t allocations = 0;
+        {
+            ScopedAllocCount counter;
+            while (ingest.metrics().processed < trace.size() - 1) {
+                if (ingest.poll()) continue;
+                if (waitpid(child, &status, WNOHANG) == child) {
+                    exited = true;
+                    break;
+                }
+                std::this_thread::yield();
+            }
+            allocations = counter.count();
+        }
+        if (!exited) waitpid(child, &status, 0);
+
+        Expect(WIFEXITED(status) && WEXITSTATUS(status) == 0, "检测进程收到全部指令且与进程内结果逐位一致");
+        Expect(ingest.metrics().processed == trace.size() - 1, "全部帧送入模型");
+        Expect(ingest.metrics().emitted == trace.size() - 1 && ingest.metrics().dropped_commands == 0,
+               "每帧输出一条指令");
+        Expect(ingest.metrics().sequence_gaps == 0, "序号连续");
+        Expect(allocations == 0, "共享内存接入路径不分配");
+
+        // 检测进程退出后换一个生产者：序号跳过 5 帧，指令环已满时丢弃新指令
+        ShmRing<DetectionFrame> detections(options.detections, ShmMode::Open);
+        DetectionFrame frame = MakeFrame(trace, 1);
+        frame.sequence = trace.size() + 5;
+        frame.timestamp_ns = 0;
+        Expect(detections.tryPush(frame) && ingest.poll() == 1, "新生产者接续写入");
+        Expect(ingest.metrics().sequence_gaps == 5, "序号缺口计数");
+        for (size_t i = 0; i < options.command_capacity; ++i) {
+            ++frame.sequence;
+            detections.tryPush(frame);
+            ingest.poll();
+        }
+        Expect(ingest.metrics().dropped_commands > 0, "指令环满时丢弃新指令");
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (g_failures) return 1;
+    std::cout << "全部通过" << std::endl;
+    return 0;
+}
@@ -0,0 +1,172 @@
+// 热备切换：主模型回放合成序列，每 kCheckpointInterval 帧把状态写入内存映射检查点；
+// 在若干切换点，备用模型（独立的 ConfigManager 与检查点句柄）从检查点恢复并接管剩余帧，
+// 输出须与主模型逐位一致。另测冷启动确实会产生偏差、损坏槽位时退回上一份快照、写快照不分配。
+#include "AllocCounter.hpp"
+#include "TestUtil.hpp"
+#include "camera/CameramanModel.hpp"
+#include "camera/DetectionTrace.hpp"
+#include "camera/StateCheckpoint.hpp"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+const char* const kConfig = "../config/camera_config.json";
+constexpr size_t kCheckpointInterval = 30;
+constexpr size_t kCapacity = 64 * 1024;
+
+bool SameBits(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+std::vector<float> Replay(CameramanModel& model, const DetectionTrace& trace,
+                          size_t begin, size_t end) {
+    std::vector<float> out;
+    for (size_t f = begin; f < end; ++f) {
+        out.push_back(model.predict(trace.framePlayers(f), trace.frameBalls(f)));
+    }
+    return out;
+}
+
+// 从 begin 开始与 reference[begin..] 逐位比较，返回首个不一致的帧，全部一致返回 end
+size_t FirstMismatch(const std::vector<float>& reference, const std::vector<float>& replayed,
+                     size_t begin) {
+    for (size_t i = 0; i < replayed.size(); ++i) {
+        if (!SameBits(reference[begin + i], replayed[i])) return begin + i;
+    }
+    return begin + replayed.size();
+}
+
+} // namespace
+
+int main() {
+    try {
+        SyntheticTraceOptions options;
+        options.frames = 30 * 60 * 2;
+        options.fast_break_rate = 0.01f;
+        const DetectionTrace trace = GenerateSyntheticTrace(options);
+        const std::string path = "/tmp/camera_state_" + std::to_string(getpid()) + ".ckpt";
+        std::remove(path.c_str());
+
+        // 主进程：每帧记录输出，每隔固定帧数写一次检查点
+        ConfigManager primary_config(kConfig, false);
+        CameramanModel primary(primary_config);
+        StateCheckpoint writer(path, kCapacity);
+        std::vector<uint8_t> state;
+        std::vector<float> reference;
+        const std::vector<size_t> handovers = {kCheckpointInterval, 1200, 2370, trace.size() - 60};
+        std::vector<std::vector<uint8_t>> snapshots;
+        for (size_t f = 0; f < trace.size(); ++f) {
+            reference.push_back(primary.predict(trace.framePlayers(f), trace.frameBalls(f)));
+            if ((f + 1) % kCheckpointInterval == 0) {
+                primary.saveState(state);
+                writer.write(Span<const uint8_t>(state));
+                // 切换点：备用进程此刻读到的检查点
+                for (size_t h : handovers) {
+                    if (h == f + 1) {
+                        StateCheckpoint reader(path, kCapacity);
+                        snapshots.emplace_back();
+                        Expect(reader.read(snapshots.back()), "备用进程读到检查点");
+                        Expect(snapshots.back() == state, "检查点内容与写入一致");
+                    }
+                }
+            }
+        }
+        Expect(writer.sequence() == trace.size() / kCheckpointInterval, "检查点序号等于写入次数");
+        std::cout << "快照大小: " << state.size() << " 字节" << std::endl;
+
+        // 备用进程：独立配置实例，从切换点开始接管
+        for (size_t i = 0; i < handovers.size(); ++i) {
+            ConfigManager standby_config(kConfig, false);
+            CameramanModel standby(standby_config);
+            standby.restoreState(Span<const uint8_t>(snapshots[i]));
+            const auto replayed = Replay(standby, trace, handovers[i], trace.size());
+            const size_t mismatch = FirstMismatch(reference, replayed, handovers[i]);
+            if (mismatch != trace.size()) {
+                std::cerr << "切换点 " << handovers[i] << " 之后第 " << mismatch << " 帧不一致\n";
+            }
+            Expect(mismatch == trace.size(), "恢复后输出逐位一致");
+
+            // 恢复后的模型再保存，应得到与主模型写入时相同的字节
+            ConfigManager again_config(kConfig, false);
+            CameramanModel again(again_config);
+            again.restoreState(Span<const uint8_t>(snapshots[i]));
+            std::vector<uint8_t> resaved;
+            again.saveState(resaved);
+            Expect(resaved == snapshots[i], "保存-恢复-保存往返一致");
+        }
+
+        {
+            // 对照：不恢复状态的冷启动在切换点之后产生偏差
+            ConfigManager cold_config(kConfig, false);
+            CameramanModel cold(cold_config);
+            const auto replayed = Replay(cold, trace, 1200, trace.size());
+            Expect(FirstMismatch(reference, replayed, 1200) != trace.size(), "冷启动输出不同");
+        }
+
+        {
+            // 最新槽位被破坏时退回上一份完整快照
+            StateCheckpoint checkpoint(path, kCapacity);
+            std::vector<uint8_t> latest;
+            Expect(checkpoint.read(latest), "读取最新快照");
+            FILE* f = std::fopen(path.c_str(), "r+b");
+            const uint64_t n = checkpoint.sequence();
+            const long offset = 64 + static_cast<long>(n % 2) * (64 + kCapacity) + 64 + 100;
+            std::fseek(f, offset, SEEK_SET);
+            std::fputc(0x5a ^ latest[100], f);
+            std::fclose(f);
+            std::vector<uint8_t> fallback;
+            Expect(checkpoint.read(fallback), "损坏后仍能读出快照");
+            Expect(fallback != latest && fallback.size() == latest.size(), "退回较旧的槽位");
+        }
+
+        {
+            // 预热后保存状态与写检查点不分配
+            ConfigManager config(kConfig, false);
+            CameramanModel model(config);
+            StateCheckpoint checkpoint(path + ".alloc", kCapacity);
+            std::vector<uint8_t> buffer;
+            for (size_t f = 0; f < 100; ++f) model.predict(trace.framePlayers(f), trace.frameBalls(f));
+            model.saveState(buffer);
+            size_t allocations = 0;
+            {
+                ScopedAllocCount counter;
+                for (size_t f = 100; f < 400; ++f) {
+                    model.predict(trace.framePlayers(f), trace.frameBalls(f));
+                    model.saveState(buffer);
+                    checkpoint.write(Span<const uint8_t>(buffer));
+                }
+                allocations = counter.count();
+            }
+            Expect(allocations == 0, "保存状态与写检查点不分配");
+            std::remove((path + ".alloc").c_str());
+        }
+
+        {
+            ConfigManager config(kConfig, false);
+            CameramanModel model(config);
+            std::vector<uint8_t> bad = state;
+            bad.resize(bad.size() / 2);
+            bool threw = false;
+            try {
+                model.restoreState(Span<const uint8_t>(bad));
+            } catch (const std::runtime_error&) {
+                threw = true;
+            }
+            Expect(threw, "截断的快照抛出异常");
+        }
+
+        std::remove(path.c_str());
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (g_failures) return 1;
+    std::cout << "全部通过" << std::endl;
+    return 0;
+}
@@ -0,0 +1,132 @@
+// 编译期特化模型：构建时生成的 DeploymentModel 与按同一配置文件、同一球场运行的 CameramanModel
+// 逐位一致；手写的 density 焦点 / 常加速度滤波配置同样逐位一致（含空帧与场外检测），
+// 开局球员不足时两者都保持在初始化位置；记忆窗口容量在编译期确定，首帧之后每帧不分配。
+#include "AllocCounter.hpp"
+#include "TestUtil.hpp"
+#include "camera/CameramanModel.hpp"
+#include "camera/DeploymentProfile.hpp"
+#include "camera/DetectionTrace.hpp"
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+bool SameBits(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+using Params = ConfigManager::Params;
+
+// 窄球场、density 焦点、常加速度滤波，记忆窗口 0.4 s × 25 fps
+struct DensityProfile {
+    static constexpr Params::KalmanParams kBase{10.0f, 40.0f, 0.01f};
+    static constexpr Params::KalmanParams kSlider{0.05f, 0.5f, 0.02f};
+    static constexpr Params::CameraParams kCamera{0.4f, 25, 200.0f, 40, 0.7f, 3.0f};
+    static constexpr Params::SafetyParams kSafety{250, 3, 50};
+    static constexpr Params::BallTrackerParams kBallTracker{};
+    static constexpr Params::TargetFilterParams kTargetFilter{
+        Params::TargetFilterParams::Model::ConstantAcceleration, 4000.0f, 80.0f};
+    static constexpr Params::FocusParams kFocus{Params::FocusParams::Mode::Density, 128, 1000.0f};
+    static constexpr TransferCurve::Range kTransfer{0.0f, 5376.0f, 200.0f, 1200.0f, 31.0f, 35.0f};
+    static constexpr TransferCurve::Mode kTransferMode = TransferCurve::Mode::Lut;
+    static constexpr size_t kLutSize = 128;
+    static constexpr Point kCourt[] = {{400.0f, 100.0f}, {5000.0f, 100.0f}, {5000.0f, 1400.0f}, {400.0f, 1400.0f}};
+};
+
+static_assert(StaticCameramanModel<DensityProfile>::kHistorySize == 10, "0.4 s × 25 fps");
+static_assert(StaticCameramanModel<DensityProfile>::kDensityFocus, "density 模式在编译期选定");
+
+// 两个模型逐帧比较目标与 transfer 输出；dropout 帧清空球员检测，验证保持上一帧位置的路径
+template <typename Model>
+bool SameOutputs(CameramanModel& runtime, Model& fixed, const DetectionTrace& trace, bool dropout) {
+    bool same = true;
+    for (size_t f = 0; f < trace.size(); ++f) {
+        const bool empty = dropout && f % 97 >= 90;
+        const Span<const Point> players = empty ? Span<const Point>() : trace.framePlayers(f);
+        const float a = runtime.predict(players, trace.frameBalls(f));
+        const float b = fixed.predict(players, trace.frameBalls(f));
+        const auto [ya, fova] = runtime.transfer(a);
+        const auto [yb, fovb] = fixed.transfer(b);
+        same &= SameBits(a, b) && SameBits(ya, yb) && SameBits(fova, fovb);
+    }
+    return same;
+}
+
+} // namespace
+
+int main() {
+    try {
+        SyntheticTraceOptions options;
+        options.frames = 1200;
+        const DetectionTrace trace = GenerateSyntheticTrace(options);
+
+        {
+            // 生成的部署配置：与读取同一配置文件、使用生成时所用球场的运行时模型一致
+            auto params = ConfigManager::LoadJson(DeploymentProfile::kSourcePath);
+            params->court_points = ConfigManager::LoadCourtPoints(DeploymentProfile::kCourtPath);
+            ConfigManager config(params);
+            CameramanModel runtime(config);
+            DeploymentModel fixed;
+            Expect(SameOutputs(runtime, fixed, trace, true), "DeploymentModel 与运行时模型逐位一致");
+
+            const Params generated = DeploymentModel::MakeParams();
+            const auto& loaded = *config.Snapshot();
+            bool same_court = generated.court_points.size() == loaded.court_points.size();
+            for (size_t i = 0; same_court && i < generated.court_points.size(); ++i) {
+                same_court = SameBits(generated.court_points[i].x, loaded.court_points[i].x) &&
+                             SameBits(generated.court_points[i].y, loaded.court_points[i].y);
+            }
+            Expect(same_court &&
+                   generated.camera.fps == loaded.camera.fps &&
+                   generated.transfer.curve.mode() == loaded.transfer.curve.mode(),
+                   "生成的配置与配置文件一致");
+        }
+
+        {
+            using Model = StaticCameramanModel<DensityProfile>;
+            ConfigManager config(std::make_shared<Params>(Model::MakeParams()));
+            CameramanModel runtime(config);
+            Model fixed;
+            Expect(SameOutputs(runtime, fixed, trace, true), "density 配置与运行时模型逐位一致");
+
+            Model quiet;
+            quiet.predict(trace.framePlayers(0), trace.frameBalls(0));
+            size_t allocations = 0;
+            {
+                ScopedAllocCount counter;
+                for (size_t f = 1; f < trace.size(); ++f) {
+                    quiet.predict(trace.framePlayers(f), trace.frameBalls(f));
+                }
+                allocations = counter.count();
+            }
+            Expect(allocations == 0, "首帧之后每帧不分配");
+        }
+
+        {
+            // 开局 20 帧只有 2 名球员（少于 min_players）：保持在首个球员位置附近，不回落到 0
+            using Model = StaticCameramanModel<DensityProfile>;
+            ConfigManager config(std::make_shared<Params>(Model::MakeParams()));
+            CameramanModel runtime(config);
+            Model fixed;
+            const std::vector<Point> two = {{2500.0f, 600.0f}, {2600.0f, 600.0f}};
+            const std::vector<Point> balls = {{2550.0f, 700.0f}};
+            bool same = true, near = true;
+            for (int f = 0; f < 20; ++f) {
+                const float a = runtime.predict(two, balls);
+                const float b = fixed.predict(Span<const Point>(two), Span<const Point>(balls));
+                same &= SameBits(a, b);
+                near &= b > 2400.0f && b < 2650.0f;
+            }
+            Expect(same && near, "开局球员不足时两模型都保持在初始化位置");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (g_failures) return 1;
+    std::cout << "全部通过" << std::endl;
+    return 0;
+}
@@ -0,0 +1,91 @@
+// PlayerStats 归约核：SSE/AVX2 路径与标量参考实现逐位比较
+#include "camera/PlayerStats.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+bool SameBits(const PlayerStats& a, const PlayerStats& b) {
+    return std::memcmp(&a.sum, &b.sum, sizeof(float)) == 0 &&
+           std::memcmp(&a.min, &b.min, sizeof(float)) == 0 &&
+           std::memcmp(&a.max, &b.max, sizeof(float)) == 0 &&
+           a.count == b.count;
+}
+
+const char* Name(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::AVX2: return "AVX2";
+    case SimdLevel::SSE:  return "SSE";
+    default:              return "Scalar";
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(20240601);
+    std::uniform_real_distribution<float> coord(-500.0f, 6000.0f);
+
+    std::vector<SimdLevel> levels = {SimdLevel::SSE, SimdLevel::AVX2};
+    std::cout << "检测到的指令集: " << Name(DetectSimdLevel()) << "\n";
+
+    int failures = 0;
+    for (size_t count = 0; count <= 130; ++count) {
+        for (size_t offset = 0; offset < 3; ++offset) {
+            // 偏移起始地址，覆盖非对齐加载
+            std::vector<Point> storage(count + offset);
+            std::vector<float> xs_storage(count + offset);
+            for (size_t i = 0; i < storage.size(); ++i) {
+                storage[i] = {coord(rng), coord(rng)};
+                xs_storage[i] = storage[i].x;
+            }
+            const Point* points = storage.data() + offset;
+            const float* xs = xs_storage.data() + offset;
+
+            const PlayerStats ref = ReducePlayerX(points, count, SimdLevel::Scalar);
+            if (!SameBits(ref, ReducePlayerX(xs, count, SimdLevel::Scalar))) {
+                std::cerr << "AoS/SoA 标量结果不一致, count=" << count << "\n";
+                ++failures;
+            }
+            if (count > 0) {
+                const auto cmp = [](const Point& a, const Point& b) { return a.x < b.x; };
+                if (ref.min != std::min_element(points, points + count, cmp)->x ||
+                    ref.max != std::max_element(points, points + count, cmp)->x) {
+                    std::cerr << "最值错误, count=" << count << "\n";
+                    ++failures;
+                }
+            }
+
+            for (SimdLevel level : levels) {
+                if (!SameBits(ref, ReducePlayerX(points, count, level)) ||
+                    !SameBits(ref, ReducePlayerX(xs, count, level))) {
+                    std::cerr << Name(level) << " 与标量结果不一致, count=" << count
+                              << ", offset=" << offset << "\n";
+                    ++failures;
+                }
+            }
+        }
+    }
+
+    // 特殊值：相同值、正负零、极大值
+    std::vector<Point> special = {{0.0f, 0}, {-0.0f, 0}, {1e30f, 0}, {-1e30f, 0},
+                                  {5.0f, 0}, {5.0f, 0}, {-0.0f, 0}, {0.0f, 0},
+                                  {3.0f, 0}, {1e-30f, 0}, {-7.0f, 0}};
+    const PlayerStats ref = ReducePlayerX(special.data(), special.size(), SimdLevel::Scalar);
+    for (SimdLevel level : levels) {
+        if (!SameBits(ref, ReducePlayerX(special.data(), special.size(), level))) {
+            std::cerr << Name(level) << " 特殊值结果不一致\n";
+            ++failures;
+        }
+    }
+
+    if (failures) {
+        std::cerr << "失败: " << failures << "\n";
+        return 1;
+    }
+    std::cout << "PlayerStats 归约核逐位一致\n";
+    return 0;
+}
@@ -0,0 +1,77 @@
+// TargetFilter：关闭时原样输出；匀速运动下常速度模型的外推输出对准 lead_ms 之后的真实位置，
+// 而未滤波的目标恰好落后这段延迟；常加速度模型能估计出加速度。
+#include "TestUtil.hpp"
+#include "camera/TargetFilter.hpp"
+#include <cmath>
+#include <iostream>
+#include <random>
+
+namespace {
+
+ConfigManager::Params MakeParams(ConfigManager::Params::TargetFilterParams::Model model) {
+    ConfigManager::Params params{};
+    params.camera.fps = 30;
+    params.base = {10.0f, 40.0f, 0.01f};
+    params.target_filter.model = model;
+    params.target_filter.process_noise = 1500.0f;
+    params.target_filter.lead_ms = 100.0f;
+    return params;
+}
+
+} // namespace
+
+int main() {
+    using Model = ConfigManager::Params::TargetFilterParams::Model;
+    const float dt = 1.0f / 30.0f;
+    const float lead = 0.1f;
+
+    {
+        TargetFilter off(MakeParams(Model::Off));
+        Expect(off.update(123.0f) == 123.0f && off.update(456.0f) == 456.0f, "关闭时原样输出");
+    }
+
+    std::mt19937 rng(20240620);
+    std::normal_distribution<float> noise(0.0f, 6.0f);
+
+    {
+        // 快攻：1200 像素/秒匀速
+        TargetFilter cv(MakeParams(Model::ConstantVelocity));
+        const float speed = 1200.0f;
+        float err_filtered = 0.0f, err_raw = 0.0f;
+        int n = 0;
+        for (int f = 0; f < 120; ++f) {
+            const float truth = 1000.0f + speed * f * dt;
+            const float out = cv.update(truth + noise(rng));
+            if (f >= 30) {
+                const float future = truth + speed * lead;
+                err_filtered += std::fabs(out - future);
+                err_raw += std::fabs(truth - future);
+                ++n;
+            }
+        }
+        err_filtered /= n;
+        err_raw /= n;
+        std::cout << "cv 平均超前误差: " << err_filtered << " px（未滤波落后 " << err_raw << " px）\n";
+        Expect(err_filtered < 15.0f, "常速度模型外推到延迟之后的位置");
+        Expect(std::fabs(cv.velocity() - speed) < 100.0f, "常速度模型速度估计");
+    }
+
+    {
+        // 启动加速：600 像素/秒²
+        TargetFilter ca(MakeParams(Model::ConstantAcceleration));
+        const float accel = 600.0f;
+        for (int f = 0; f < 150; ++f) {
+            const float t = f * dt;
+            ca.update(2000.0f + 0.5f * accel * t * t + noise(rng));
+        }
+        std::cout << "ca 加速度估计: " << ca.acceleration() << " px/s²\n";
+        Expect(std::fabs(ca.acceleration() - accel) < 200.0f, "常加速度模型加速度估计");
+    }
+
+    if (g_failures) {
+        std::cerr << g_failures << " 项失败\n";
+        return 1;
+    }
+    std::cout << "全部通过\n";
+    return 0;
+}
@@ -0,0 +1,186 @@
+// TrajectoryGenerator：大步进时速度、加速度、加加速度不超过限值且几乎不过冲；
+// 匀速目标的跟踪不落后、相邻采样不再呈阶梯；不同采样频率得到同一条轨迹；采样不分配。
+// ControlLoop 在独立线程上按控制频率输出采样点。
+#include "AllocCounter.hpp"
+#include "TestUtil.hpp"
+#include "camera/TrajectoryGenerator.hpp"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t kStart = 1000000000u;
+constexpr uint64_t kFrameNs = 33333333u;   // 30 fps
+
+uint64_t Ns(double seconds) {
+    return kStart + static_cast<uint64_t>(seconds * 1e9);
+}
+
+Setpoint MakeSetpoint(const ConfigManager::Params& params, uint64_t time_ns, float x) {
+    const auto [y, fov] = params.transfer.curve.evaluate(x);
+    return Setpoint{time_ns, x, y, fov};
+}
+
+// 30 fps 的目标序列 x(t)，按 rate_hz 采样 seconds 秒
+template <typename Target>
+std::vector<TrajectorySample> Run(const ConfigManager::Params& params, double rate_hz, double seconds,
+                                  Target target) {
+    TrajectoryGenerator generator(params, TrajectoryGenerator::Options{});
+    std::vector<TrajectorySample> samples;
+    samples.reserve(static_cast<size_t>(rate_hz * seconds) + 1);
+    uint64_t next_frame = kStart;
+    const uint64_t period = static_cast<uint64_t>(1e9 / rate_hz);
+    for (uint64_t t = kStart; t <= Ns(seconds); t += period) {
+        for (; next_frame <= t; next_frame += kFrameNs) {
+            generator.setTarget(MakeSetpoint(params, next_frame, target((next_frame - kStart) * 1e-9)));
+        }
+        TrajectorySample sample;
+        generator.sample(t, sample);
+        samples.push_back(sample);
+    }
+    return samples;
+}
+
+} // namespace
+
+int main() {
+    try {
+        ConfigManager config("../config/camera_config.json", false);
+        const ConfigManager::Params& params = *config.Snapshot();
+        const TrajectoryGenerator::Options options;
+        const TrajectoryGenerator::Limits limits = TrajectoryGenerator::DeriveLimits(params, options);
+        Expect(limits.x.velocity == params.camera.speed_max * params.camera.speed_slider_gain,
+               "x 最大速度为 speed_max × speed_slider_gain");
+        Expect(limits.y.velocity > 0.0f && limits.fov.velocity > 0.0f, "y、fov 限值按 transfer 斜率推导");
+
+        {
+            TrajectoryGenerator generator(limits, options);
+            TrajectorySample sample;
+            Expect(!generator.sample(kStart, sample), "没有目标时不输出");
+        }
+
+        {
+            // 大步进：1000 像素外的目标
+            const float from = 2000.0f, to = 3000.0f;
+            const double rate = 200.0;
+            const auto samples = Run(params, rate, 6.0, [&](double t) { return t < 0.5 ? from : to; });
+            const float dt = static_cast<float>(1.0 / rate);
+            bool velocity_ok = true, accel_ok = true, jerk_ok = true;
+            float max_x = 0.0f;
+            for (size_t i = 0; i < samples.size(); ++i) {
+                velocity_ok &= std::fabs(samples[i].x_velocity) <= limits.x.velocity * 1.0001f;
+                max_x = std::max(max_x, samples[i].x);
+                if (i >= 2) {
+                    const float a1 = (samples[i].x_velocity - samples[i - 1].x_velocity) / dt;
+                    const float a0 = (samples[i - 1].x_velocity - samples[i - 2].x_velocity) / dt;
+                    accel_ok &= std::fabs(a1) <= limits.x.acceleration * 1.01f;
+                    jerk_ok &= std::fabs(a1 - a0) / dt <= limits.x.jerk * 1.01f;
+                }
+            }
+            Expect(velocity_ok, "速度不超过限值");
+            Expect(accel_ok, "加速度不超过限值");
+            Expect(jerk_ok, "加加速度不超过限值");
+            Expect(max_x - to < 0.01f * (to - from), "过冲小于步长的 1%");
+            Expect(std::fabs(samples.back().x - to) < 1.0f && std::fabs(samples.back().x_velocity) < 1.0f,
+                   "收敛到目标并停止");
+            const auto [y, fov] = params.transfer.curve.evaluate(to);
+            Expect(std::fabs(samples.back().y - y) < 0.1f && std::fabs(samples.back().fov - fov) < 0.01f,
+                   "y、fov 收敛到目标");
+        }
+
+        {
+            // 匀速 300 像素/秒：稳定后不落后，200 Hz 相邻采样的步长接近 v/200，不再是每帧一次的阶梯
+            const float speed = 300.0f;
+            const auto samples = Run(params, 200.0, 4.0, [&](double t) { return 1500.0f + speed * t; });
+            float max_error = 0.0f, max_step = 0.0f, min_step = 1e9f;
+            for (size_t i = 400; i < samples.size(); ++i) {
+                const float truth = 1500.0f + speed * static_cast<float>((samples[i].time_ns - kStart) * 1e-9);
+                max_error = std::max(max_error, std::fabs(samples[i].x - truth));
+                const float step = samples[i].x - samples[i - 1].x;
+                max_step = std::max(max_step, step);
+                min_step = std::min(min_step, step);
+            }
+            Expect(max_error < 5.0f, "匀速目标跟踪不落后");
+            Expect(max_step < 1.2f * speed / 200.0f && min_step > 0.8f * speed / 200.0f,
+                   "相邻采样步长均匀");
+        }
+
+        {
+            // 100 Hz 与 200 Hz 采样同一目标序列，公共时刻的位置一致
+            auto target = [](double t) { return 2500.0f + 600.0f * static_cast<float>(std::sin(t * 1.5)); };
+            const auto fast = Run(params, 200.0, 3.0, target);
+            const auto slow = Run(params, 100.0, 3.0, target);
+            float max_diff = 0.0f;
+            for (size_t i = 0; i < slow.size() && 2 * i < fast.size(); ++i) {
+                max_diff = std::max(max_diff, std::fabs(slow[i].x - fast[2 * i].x));
+            }
+            Expect(max_diff < 1.0f, "轨迹与采样频率无关");
+        }
+
+        {
+            // 长时间未采样（线程被挂起）：单次推进按上限处理
+            TrajectoryGenerator generator(limits, options);
+            generator.setTarget(MakeSetpoint(params, kStart, 1000.0f));
+            generator.setTarget(MakeSetpoint(params, kStart + kFrameNs, 4000.0f));
+            TrajectorySample sample;
+            size_t allocations = 0;
+            {
+                ScopedAllocCount counter;
+                for (uint64_t t = kStart; t < Ns(2.0); t += 5000000u) generator.sample(t, sample);
+                generator.sample(Ns(60.0), sample);
+                allocations = counter.count();
+            }
+            Expect(allocations == 0, "采样不分配");
+            Expect(sample.time_ns == Ns(60.0) && std::fabs(sample.x_velocity) <= limits.x.velocity,
+                   "长间隔按上限推进");
+        }
+
+        {
+            // 控制线程：30 fps 的指令送入，200 Hz 输出
+            ControlLoop::Options loop_options;
+            loop_options.rate_hz = 200.0;
+            ControlLoop loop(params, loop_options);
+            loop.start();
+            std::vector<TrajectorySample> received;
+            received.reserve(1024);
+            const uint64_t begin = Instrumentation::NowNs();
+            for (int f = 0; f < 15; ++f) {
+                PtzCommand command{};
+                command.emit_ns = Instrumentation::NowNs();
+                command.target_x = 2000.0f + 10.0f * f;
+                const auto [y, fov] = params.transfer.curve.evaluate(command.target_x);
+                command.y = y;
+                command.fov = fov;
+                loop.submit(command);
+                std::this_thread::sleep_for(std::chrono::milliseconds(33));
+                TrajectorySample sample;
+                while (loop.poll(sample)) received.push_back(sample);
+            }
+            loop.stop();
+            TrajectorySample sample;
+            while (loop.poll(sample)) received.push_back(sample);
+            const double elapsed = (Instrumentation::NowNs() - begin) * 1e-9;
+
+            const ControlLoop::Metrics m = loop.metrics();
+            bool ordered = true;
+            for (size_t i = 1; i < received.size(); ++i) {
+                ordered &= received[i].time_ns > received[i - 1].time_ns;
+            }
+            Expect(m.setpoints == 15 && m.samples == received.size(), "采样全部取出");
+            // 单核或负载较高的机器上允许错过节拍，只检查数量级
+            Expect(received.size() + m.missed_ticks >= static_cast<size_t>(0.8 * 200.0 * elapsed) - 5 &&
+                   received.size() <= static_cast<size_t>(200.0 * elapsed) + 5, "按控制频率输出");
+            Expect(ordered && !received.empty() && received.back().x > 2000.0f, "采样时刻递增并跟随目标");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (g_failures) return 1;
+    std::cout << "全部通过" << std::endl;
+    return 0;
+}
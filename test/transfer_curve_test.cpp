@@ -0,0 +1,90 @@
+// TransferCurve：Exact 与原公式逐位一致，批量与逐个求值逐位一致，Lut / Polynomial 误差有界
+#include "camera/TransferCurve.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+// 原 CameramanModel::transfer 实现
+void LegacyTransfer(const TransferCurve::Range& t, float x, float& y, float& fov) {
+    float norm = (x - t.x_min) / (t.x_max - t.x_min);
+    norm = std::clamp(norm, 0.0f, 1.0f);
+    float y_factor = 0.8f + 0.2f * std::pow(2 * norm - 1, 2);
+    y = t.y_min + (t.y_max - t.y_min) * y_factor;
+    float fov_factor = 1.0f - 0.15f * std::pow(2 * norm - 1, 2);
+    fov = t.fov_min + (t.fov_max - t.fov_min) * fov_factor;
+}
+
+bool SameBits(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+const char* Name(TransferCurve::Mode mode) {
+    switch (mode) {
+    case TransferCurve::Mode::Lut:        return "lut";
+    case TransferCurve::Mode::Polynomial: return "polynomial";
+    default:                              return "exact";
+    }
+}
+
+} // namespace
+
+int main() {
+    const TransferCurve::Range range{0.0f, 5376.0f, 200.0f, 1200.0f, 31.0f, 35.0f};
+
+    std::mt19937 rng(20240610);
+    std::uniform_real_distribution<float> coord(-500.0f, 6000.0f);
+    std::vector<float> xs(10000);
+    for (auto& x : xs) x = coord(rng);
+    xs[0] = range.x_min;
+    xs[1] = range.x_max;
+    xs[2] = 0.5f * (range.x_min + range.x_max);
+
+    int failures = 0;
+    for (auto mode : {TransferCurve::Mode::Exact, TransferCurve::Mode::Lut,
+                      TransferCurve::Mode::Polynomial}) {
+        TransferCurve curve;
+        curve.build(mode, range);
+
+        std::vector<float> ys(xs.size()), fovs(xs.size());
+        curve.evaluateMany(xs, ys.data(), fovs.data());
+
+        float max_y_err = 0.0f, max_fov_err = 0.0f;
+        for (size_t i = 0; i < xs.size(); ++i) {
+            const auto [y, fov] = curve.evaluate(xs[i]);
+            if (!SameBits(y, ys[i]) || !SameBits(fov, fovs[i])) {
+                std::cerr << Name(mode) << ": 批量与逐个结果不一致, x=" << xs[i] << "\n";
+                ++failures;
+                break;
+            }
+            float ref_y, ref_fov;
+            LegacyTransfer(range, xs[i], ref_y, ref_fov);
+            if (mode == TransferCurve::Mode::Exact &&
+                (!SameBits(y, ref_y) || !SameBits(fov, ref_fov))) {
+                std::cerr << "exact: 与原公式不一致, x=" << xs[i] << "\n";
+                ++failures;
+                break;
+            }
+            max_y_err = std::max(max_y_err, std::fabs(y - ref_y));
+            max_fov_err = std::max(max_fov_err, std::fabs(fov - ref_fov));
+        }
+
+        std::cout << Name(mode) << ": 最大误差 y=" << max_y_err << " fov=" << max_fov_err << "\n";
+        // y 量程 1000，fov 量程 4；误差需远小于一个像素 / 一个刻度
+        if (max_y_err > 0.01f || max_fov_err > 0.001f) {
+            std::cerr << Name(mode) << ": 误差超出容限\n";
+            ++failures;
+        }
+    }
+
+    if (failures) {
+        std::cerr << failures << " 项失败\n";
+        return 1;
+    }
+    std::cout << "全部通过\n";
+    return 0;
+}
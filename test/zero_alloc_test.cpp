@@ -0,0 +1,54 @@
+// 帧路径零分配测试：预热后 predict(Span) 与 transfer 不允许产生任何堆分配
+#include "AllocCounter.hpp"
+#include "camera/CameramanModel.hpp"
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main(int argc, char** argv) {
+    try {
+        const std::string config = argc > 1 ? argv[1] : "../config/camera_config.json";
+        ConfigManager::Initialize(config);
+        CameramanModel model(ConfigManager::Default().Snapshot()->court_points);
+
+        // 预先生成全部帧，计数期间不再构造输入
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> coord(0.0f, 5376.0f);
+        const size_t frames = 2000;
+        std::vector<std::vector<Point>> players(frames), balls(frames);
+        for (size_t f = 0; f < frames; ++f) {
+            const size_t n = f % 50 == 7 ? 0 : 1 + rng() % 24;   // 穿插空帧
+            for (size_t i = 0; i < n; ++i) players[f].push_back({coord(rng), coord(rng)});
+            const size_t m = f % 3 == 0 ? 0 : 1 + rng() % 2;
+            for (size_t i = 0; i < m; ++i) balls[f].push_back({coord(rng), coord(rng)});
+        }
+
+        // 首帧初始化历史窗口（允许分配）
+        model.predict(Span<const Point>(players[0]), Span<const Point>(balls[0]));
+
+        size_t allocations = 0;
+        float checksum = 0.0f;
+        {
+            ScopedAllocCount counter;
+            for (size_t f = 1; f < frames; ++f) {
+                const float target = model.predict(Span<const Point>(players[f]),
+                                                   Span<const Point>(balls[f]));
+                auto [y, fov] = model.transfer(target);
+                checksum += target + y + fov;
+                if (auto info = model.getDebugInfo()) checksum += info->focus_slider;
+            }
+            allocations = counter.count();
+        }
+
+        std::cout << "帧数: " << frames - 1 << ", 堆分配次数: " << allocations
+                  << ", checksum: " << checksum << std::endl;
+        if (allocations != 0) {
+            std::cerr << "帧路径存在堆分配" << std::endl;
+            return 1;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
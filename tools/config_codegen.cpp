@@ -0,0 +1,184 @@
+// 部署配置生成器：config_codegen <camera_config.json> <DeploymentProfile.hpp> [court.json]
+// 解析并校验主配置，写出 StaticCameramanModel 使用的 constexpr 配置结构体。
+// 球场取显式给出的文件，省略时取配置中的 court_config.default；不按修改时间选择用户球场，
+// 同一份源码树任何时候构建都生成相同的头文件。
+// 由 CMake 目标 camera_model_static 在构建时调用（见 CAMERA_STATIC_CONFIG / CAMERA_STATIC_COURT），
+// 一般无需手动运行。
+#include "camera/ConfigManager.hpp"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+// 按 float 能精确往返的位数输出字面量
+std::string Literal(float value) {
+    if (!std::isfinite(value)) {
+        throw std::runtime_error("Config value is not finite");
+    }
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.9g", value);
+    std::string text = buf;
+    if (text.find_first_of(".e") == std::string::npos) text += ".0";
+    return text + "f";
+}
+
+std::string Escape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '\\' || c == '"') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+void WriteKalman(std::ostream& out, const char* name, const ConfigManager::Params::KalmanParams& p) {
+    out << "    static constexpr ConfigManager::Params::KalmanParams " << name << "{\n"
+        << "        " << Literal(p.variance_position) << ",   // variance_position\n"
+        << "        " << Literal(p.variance_measurement) << ",   // variance_measurement\n"
+        << "        " << Literal(p.process_noise) << ",   // process_noise\n"
+        << "    };\n";
+}
+
+const char* ModeName(TransferCurve::Mode mode) {
+    switch (mode) {
+    case TransferCurve::Mode::Lut: return "Lut";
+    case TransferCurve::Mode::Polynomial: return "Polynomial";
+    default: return "Exact";
+    }
+}
+
+const char* ModelName(ConfigManager::Params::TargetFilterParams::Model model) {
+    switch (model) {
+    case ConfigManager::Params::TargetFilterParams::Model::ConstantVelocity: return "ConstantVelocity";
+    case ConfigManager::Params::TargetFilterParams::Model::ConstantAcceleration: return "ConstantAcceleration";
+    default: return "Off";
+    }
+}
+
+std::string Generate(const std::string& config_path, const ConfigManager::Params& p,
+                     const std::string& court_file) {
+    if (p.court_points.empty()) {
+        throw std::runtime_error("Static model requires a court polygon");
+    }
+    const auto& c = p.camera;
+    const auto& s = p.safety;
+    const auto& b = p.ball_tracker;
+    const auto& t = p.target_filter;
+    const auto& f = p.focus;
+    const auto& r = p.transfer.curve.range();
+
+    std::ostringstream out;
+    out << "// 由 tools/config_codegen 生成，请勿手动修改。\n"
+        << "// 配置: " << config_path << "\n"
+        << "// 球场: " << court_file << "\n"
+        << "#pragma once\n"
+        << "#include \"camera/StaticCameramanModel.hpp\"\n\n"
+        << "struct DeploymentProfile {\n"
+        << "    static constexpr const char* kSourcePath = \"" << Escape(config_path) << "\";\n"
+        << "    static constexpr const char* kCourtPath = \"" << Escape(court_file) << "\";\n\n";
+    WriteKalman(out, "kBase", p.base);
+    WriteKalman(out, "kSlider", p.slider);
+    out << "    static constexpr ConfigManager::Params::CameraParams kCamera{\n"
+        << "        " << Literal(c.memory_length) << ",   // memory_length\n"
+        << "        " << c.fps << ",   // fps\n"
+        << "        " << Literal(c.speed_max) << ",   // speed_max\n"
+        << "        " << c.buffer_pixels << ",   // buffer_pixels\n"
+        << "        " << Literal(c.position_merge_ratio) << ",   // position_merge_ratio\n"
+        << "        " << Literal(c.speed_slider_gain) << ",   // speed_slider_gain\n"
+        << "    };\n"
+        << "    static constexpr ConfigManager::Params::SafetyParams kSafety{\n"
+        << "        " << s.noise_threshold << ",   // noise_threshold\n"
+        << "        " << s.min_players << ",   // min_players\n"
+        << "        " << s.boundary_margin << ",   // boundary_margin\n"
+        << "        " << s.ball_loft_margin << ",   // ball_loft_margin\n"
+        << "    };\n"
+        << "    static constexpr ConfigManager::Params::BallTrackerParams kBallTracker{\n"
+        << "        " << Literal(b.gate_pixels) << ",   // gate_pixels\n"
+        << "        " << b.confirm_hits << ",   // confirm_hits\n"
+        << "        " << b.max_misses << ",   // max_misses\n"
+        << "        " << Literal(b.accel_noise) << ",   // accel_noise\n"
+        << "        " << Literal(b.measurement_noise) << ",   // measurement_noise\n"
+        << "        " << Literal(b.player_affinity) << ",   // player_affinity\n"
+        << "    };\n"
+        << "    static constexpr ConfigManager::Params::TargetFilterParams kTargetFilter{\n"
+        << "        ConfigManager::Params::TargetFilterParams::Model::" << ModelName(t.model) << ",\n"
+        << "        " << Literal(t.process_noise) << ",   // process_noise\n"
+        << "        " << Literal(t.lead_ms) << ",   // lead_ms\n"
+        << "    };\n"
+        << "    static constexpr ConfigManager::Params::FocusParams kFocus{\n"
+        << "        ConfigManager::Params::FocusParams::Mode::"
+        << (f.mode == ConfigManager::Params::FocusParams::Mode::Density ? "Density" : "Mean") << ",\n"
+        << "        " << f.bins << ",   // bins\n"
+        << "        " << Literal(f.window_pixels) << ",   // window_pixels\n"
+        << "    };\n"
+        << "    static constexpr TransferCurve::Range kTransfer{\n"
+        << "        " << Literal(r.x_min) << ", " << Literal(r.x_max) << ",   // x_min, x_max\n"
+        << "        " << Literal(r.y_min) << ", " << Literal(r.y_max) << ",   // y_min, y_max\n"
+        << "        " << Literal(r.fov_min) << ", " << Literal(r.fov_max) << ",   // fov_min, fov_max\n"
+        << "    };\n"
+        << "    static constexpr TransferCurve::Mode kTransferMode = TransferCurve::Mode::"
+        << ModeName(p.transfer.curve.mode()) << ";\n"
+        << "    static constexpr size_t kLutSize = " << p.transfer.curve.lutSize() << ";\n\n"
+        << "    static constexpr Point kCourt[] = {\n";
+    for (const Point& point : p.court_points) {
+        out << "        {" << Literal(point.x) << ", " << Literal(point.y) << "},\n";
+    }
+    out << "    };\n"
+        << "};\n\n"
+        << "using DeploymentModel = StaticCameramanModel<DeploymentProfile>;\n"
+        << "extern template class StaticCameramanModel<DeploymentProfile>;\n";
+    return out.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <camera_config.json> <DeploymentProfile.hpp> [court.json]\n";
+        return 1;
+    }
+    try {
+        const std::string config_path = argv[1];
+        const std::string header_path = argv[2];
+
+        std::string court_file = argc > 3 ? argv[3] : "";
+        if (court_file.empty()) {
+            std::ifstream in(config_path);
+            if (!in) {
+                throw std::runtime_error("Config file not found: " + config_path);
+            }
+            std::string user_court;
+            ConfigManager::ReadCourtPaths(nlohmann::json::parse(in), court_file, user_court);
+        }
+
+        auto params = ConfigManager::LoadJson(config_path);
+        params->court_points = ConfigManager::LoadCourtPoints(court_file);
+        // 以固定快照构造一次，按运行时规则校验替换球场后的完整配置
+        ConfigManager validated(params);
+        const std::string text = Generate(config_path, *params, court_file);
+
+        // 内容不变时不改写，避免依赖它的目标重新编译
+        std::ifstream existing(header_path, std::ios::binary);
+        if (existing) {
+            std::ostringstream current;
+            current << existing.rdbuf();
+            if (current.str() == text) return 0;
+        }
+        std::ofstream out(header_path, std::ios::binary | std::ios::trunc);
+        out << text;
+        if (!out) {
+            throw std::runtime_error("Failed to write " + header_path);
+        }
+
+        std::cout << "Wrote " << header_path << " (court " << court_file << ", "
+                  << params->court_points.size() << " points)" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,36 @@
+// 配置编译器：config_compile <camera_config.json> [output.bin]
+// 解析并校验主配置与当前选中的球场，写出 ConfigManager 可直接 mmap 读取的二进制配置。
+// 省略输出路径时写到 JSON 同目录的同名 .bin，ConfigManager 加载该 JSON 时会自动优先使用。
+#include "camera/ConfigBlob.hpp"
+#include <iostream>
+#include <sys/stat.h>
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <camera_config.json> [output.bin]\n";
+        return 1;
+    }
+    try {
+        const std::string config_path = argv[1];
+        const std::string blob_path = argc > 2 ? argv[2] : ConfigBlob::PathFor(config_path);
+        if (blob_path == config_path) {
+            throw std::runtime_error("Output would overwrite the input: " + blob_path);
+        }
+
+        struct stat st;
+        if (stat(config_path.c_str(), &st) != 0) {
+            throw std::runtime_error("Config file not found: " + config_path);
+        }
+
+        ConfigManager::SourceFiles files;
+        const auto params = ConfigManager::LoadJson(config_path, &files);
+        ConfigBlob::Write(blob_path, *params, files, st.st_mtime);
+
+        std::cout << "Wrote " << blob_path << " (court " << files.court_file << ", "
+                  << params->court_points.size() << " points)" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,133 @@
+// 共享内存接入的本机联调：
+//   shm_loopback serve <camera_config.json> [--seconds N]
+//       相机端：创建检测环与指令环，ShmIngest 持续处理，Ctrl-C 或到时退出
+//   shm_loopback detect <trace.(bin|jsonl)|-> [--fps N]
+//       替身检测进程：按 fps 把序列逐帧写进检测环（环满时丢帧），同时读取指令环并统计往返延迟
+// 两端都使用 ShmIngest::Options 的默认段名，须先启动 serve。trace 为 - 时使用固定种子的合成序列。
+#include "camera/DetectionTrace.hpp"
+#include "camera/ShmIngest.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<bool> g_stop{false};
+
+void HandleSignal(int) { g_stop = true; }
+
+int Serve(const char* config_path, double seconds) {
+    ConfigManager config(config_path, true);
+    CameramanModel model(config);
+    ShmIngest ingest(model, ShmIngest::Options{});
+    std::printf("serving on %s -> %s\n", ShmIngest::Options{}.detections.c_str(),
+                ShmIngest::Options{}.commands.c_str());
+
+    std::thread timer;
+    if (seconds > 0) {
+        timer = std::thread([seconds] {
+            const auto end = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+            while (!g_stop && std::chrono::steady_clock::now() < end) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            g_stop = true;
+        });
+    }
+    ingest.run(g_stop);
+    if (timer.joinable()) timer.join();
+
+    const auto& m = ingest.metrics();
+    std::printf("processed      : %llu\n", static_cast<unsigned long long>(m.processed));
+    std::printf("emitted        : %llu\n", static_cast<unsigned long long>(m.emitted));
+    std::printf("dropped cmds   : %llu\n", static_cast<unsigned long long>(m.dropped_commands));
+    std::printf("sequence gaps  : %llu\n", static_cast<unsigned long long>(m.sequence_gaps));
+    return 0;
+}
+
+int Detect(const char* trace_path, int fps) {
+    const DetectionTrace trace = std::string(trace_path) != "-"
+        ? DetectionTrace::Load(trace_path)
+        : GenerateSyntheticTrace(SyntheticTraceOptions{});
+    const ShmIngest::Options names;
+    ShmRing<DetectionFrame> detections(names.detections, ShmMode::Open);
+    ShmRing<PtzCommand> commands(names.commands, ShmMode::Open);
+
+    std::vector<uint64_t> latencies;
+    latencies.reserve(trace.size());
+    uint64_t dropped = 0;
+    auto drain = [&] {
+        PtzCommand command;
+        const uint64_t now = Instrumentation::NowNs();
+        while (commands.tryPop(command)) {
+            latencies.push_back(now > command.timestamp_ns ? now - command.timestamp_ns : 0);
+        }
+    };
+
+    const auto period = std::chrono::nanoseconds(1000000000 / std::max(fps, 1));
+    auto next = std::chrono::steady_clock::now();
+    for (size_t f = 0; f < trace.size() && !g_stop; ++f) {
+        DetectionFrame* slot = detections.acquire();
+        if (slot) {
+            slot->assign(trace.framePlayers(f), trace.frameBalls(f));
+            slot->sequence = f;
+            slot->timestamp_ns = Instrumentation::NowNs();
+            detections.commit();
+        } else {
+            ++dropped;
+        }
+        next += period;
+        while (std::chrono::steady_clock::now() < next) {
+            drain();
+            std::this_thread::yield();
+        }
+    }
+    const auto settle = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+    while (std::chrono::steady_clock::now() < settle) drain();
+
+    std::sort(latencies.begin(), latencies.end());
+    auto quantile = [&](double q) {
+        return latencies.empty() ? 0.0
+            : latencies[std::min(latencies.size() - 1, static_cast<size_t>(q * latencies.size()))] * 1e-3;
+    };
+    std::printf("frames sent    : %zu (dropped %llu)\n", trace.size() - dropped,
+                static_cast<unsigned long long>(dropped));
+    std::printf("commands       : %zu\n", latencies.size());
+    std::printf("round trip p50 : %.1f us\n", quantile(0.50));
+    std::printf("round trip p99 : %.1f us\n", quantile(0.99));
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " serve <camera_config.json> [--seconds N]\n"
+                  << "       " << argv[0] << " detect <trace|-> [--fps N]\n";
+        return 1;
+    }
+    std::signal(SIGINT, HandleSignal);
+    std::signal(SIGTERM, HandleSignal);
+    try {
+        const std::string mode = argv[1];
+        double seconds = 0.0;
+        int fps = 30;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            const std::string arg = argv[i];
+            if (arg == "--seconds") seconds = std::atof(argv[i + 1]);
+            else if (arg == "--fps") fps = std::atoi(argv[i + 1]);
+            else throw std::invalid_argument("Unknown option: " + arg);
+        }
+        if (mode == "serve") return Serve(argv[2], seconds);
+        if (mode == "detect") return Detect(argv[2], fps);
+        throw std::invalid_argument("Unknown mode: " + mode);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}